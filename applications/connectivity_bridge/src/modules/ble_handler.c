@@ -6,7 +6,6 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/types.h>
-#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/devicetree.h>
 
@@ -22,6 +21,7 @@
 #include "ble_ctrl_event.h"
 #include "ble_data_event.h"
 #include "uart_data_event.h"
+#include "bridge_stats.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_BLE_LOG_LEVEL);
@@ -30,25 +30,13 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_BLE_LOG_LEVEL);
 #define BLE_RX_BUF_COUNT 4
 #define BLE_SLAB_ALIGNMENT 4
 
-#define BLE_TX_BUF_SIZE (CONFIG_BRIDGE_BUF_SIZE * 2)
-
 #define BLE_AD_IDX_FLAGS 0
 #define BLE_AD_IDX_NAME 1
 
-#define ATT_MIN_PAYLOAD 20 /* Minimum L2CAP MTU minus ATT header */
-
-static void bt_send_work_handler(struct k_work *work);
-
 K_MEM_SLAB_DEFINE(ble_rx_slab, BLE_RX_BLOCK_SIZE, BLE_RX_BUF_COUNT, BLE_SLAB_ALIGNMENT);
-RING_BUF_DECLARE(ble_tx_ring_buf, BLE_TX_BUF_SIZE);
-
-static K_SEM_DEFINE(ble_tx_sem, 0, 1);
-
-static K_WORK_DEFINE(bt_send_work, bt_send_work_handler);
 
 static struct bt_conn *current_conn;
 static struct bt_gatt_exchange_params exchange_params;
-static uint32_t nus_max_send_len;
 static atomic_t ready;
 static atomic_t active;
 
@@ -71,8 +59,8 @@ static const struct bt_data sd[] = {
 static void exchange_func(struct bt_conn *conn, uint8_t err,
 			  struct bt_gatt_exchange_params *params)
 {
-	if (!err) {
-		nus_max_send_len = bt_nus_get_mtu(conn);
+	if (err) {
+		LOG_WRN("MTU exchange failed (err %u)", err);
 	}
 }
 
@@ -96,8 +84,6 @@ static void connected(struct bt_conn *conn, uint8_t err)
 		LOG_WRN("bt_gatt_exchange_mtu: %d", err);
 	}
 
-	ring_buf_reset(&ble_tx_ring_buf);
-
 	struct peer_conn_event *event = new_peer_conn_event();
 
 	event->peer_id = PEER_ID_BLE;
@@ -135,37 +121,6 @@ static struct bt_conn_cb conn_callbacks = {
 	.disconnected = disconnected,
 };
 
-static void bt_send_work_handler(struct k_work *work)
-{
-	uint16_t len;
-	uint8_t *buf;
-	int err;
-	bool notif_disabled = false;
-
-	do {
-		len = ring_buf_get_claim(&ble_tx_ring_buf, &buf, nus_max_send_len);
-
-		err = bt_nus_send(current_conn, buf, len);
-		if (err == -EINVAL) {
-			notif_disabled = true;
-			len = 0;
-		} else if (err) {
-			len = 0;
-		}
-
-		err = ring_buf_get_finish(&ble_tx_ring_buf, len);
-		if (err) {
-			LOG_ERR("ring_buf_get_finish: %d", err);
-			break;
-		}
-	} while (len != 0 && !ring_buf_is_empty(&ble_tx_ring_buf));
-
-	if (notif_disabled) {
-		/* Peer has not enabled notifications: don't accumulate data */
-		ring_buf_reset(&ble_tx_ring_buf);
-	}
-}
-
 static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
 			  uint16_t len)
 {
@@ -180,14 +135,15 @@ static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
 
 		err = k_mem_slab_alloc(&ble_rx_slab, &buf, K_NO_WAIT);
 		if (err) {
+			bridge_stats_dropped(BRIDGE_PATH_BLE_TO_UART, 0, remainder);
 			LOG_WRN("BLE RX overflow");
 			break;
 		}
 
 		copy_len = remainder > BLE_RX_BLOCK_SIZE ?
 			BLE_RX_BLOCK_SIZE : remainder;
+		memcpy(buf, &data[len - remainder], copy_len);
 		remainder -= copy_len;
-		memcpy(buf, data, copy_len);
 
 		struct ble_data_event *event = new_ble_data_event();
 
@@ -197,18 +153,8 @@ static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
 	} while (remainder);
 }
 
-static void bt_sent_cb(struct bt_conn *conn)
-{
-	if (ring_buf_is_empty(&ble_tx_ring_buf)) {
-		return;
-	}
-
-	k_work_submit(&bt_send_work);
-}
-
 static struct bt_nus_cb nus_cb = {
 	.received = bt_receive_cb,
-	.sent = bt_sent_cb,
 };
 
 static void adv_start(void)
@@ -338,23 +284,19 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			return false;
 		}
 
-		uint32_t written = ring_buf_put(
-			&ble_tx_ring_buf,
-			event->buf,
-			event->len);
-		if (written != event->len) {
+		/* The NUS stream coalesces the data into notifications of the maximum size. */
+		int written = bt_nus_stream_write(current_conn, event->buf, event->len);
+
+		if (written < 0) {
+			/* Peer has not enabled notifications: don't accumulate data */
+			written = 0;
+		} else if (written != event->len) {
 			LOG_WRN("UART_%d -> BLE overflow", event->dev_idx);
 		}
 
-		uint32_t buf_utilization =
-			(ring_buf_capacity_get(&ble_tx_ring_buf) -
-			ring_buf_space_get(&ble_tx_ring_buf));
-
-		/* Simple check to start transmission. */
-		/* If bt_send_work is already running, this has no effect */
-		if (buf_utilization == written) {
-			k_work_submit(&bt_send_work);
-		}
+		bridge_stats_forwarded(BRIDGE_PATH_UART_TO_BLE, event->dev_idx, written);
+		bridge_stats_dropped(BRIDGE_PATH_UART_TO_BLE, event->dev_idx,
+				     event->len - written);
 
 		return false;
 	}
@@ -407,8 +349,6 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 			atomic_set(&active, false);
 
-			nus_max_send_len = ATT_MIN_PAYLOAD;
-
 			err = bt_enable(bt_ready);
 			if (err) {
 				LOG_ERR("bt_enable: %d", err);
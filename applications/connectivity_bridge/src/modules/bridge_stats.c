@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include "bridge_stats.h"
+
+struct path_stats {
+	atomic_t forwarded;
+	atomic_t dropped;
+};
+
+static const char * const path_names[BRIDGE_PATH_COUNT] = {
+	[BRIDGE_PATH_UART_TO_CDC] = "UART_%u->CDC_%u",
+	[BRIDGE_PATH_CDC_TO_UART] = "CDC_%u->UART_%u",
+	[BRIDGE_PATH_UART_TO_BLE] = "UART_%u->BLE",
+	[BRIDGE_PATH_BLE_TO_UART] = "BLE->UART_%u",
+};
+
+static struct path_stats stats[BRIDGE_PATH_COUNT][BRIDGE_STATS_DEV_COUNT];
+static int64_t reset_time;
+
+void bridge_stats_forwarded(enum bridge_path path, uint8_t dev_idx, size_t len)
+{
+	if ((path >= BRIDGE_PATH_COUNT) || (dev_idx >= BRIDGE_STATS_DEV_COUNT)) {
+		return;
+	}
+
+	atomic_add(&stats[path][dev_idx].forwarded, len);
+}
+
+void bridge_stats_dropped(enum bridge_path path, uint8_t dev_idx, size_t len)
+{
+	if ((path >= BRIDGE_PATH_COUNT) || (dev_idx >= BRIDGE_STATS_DEV_COUNT)) {
+		return;
+	}
+
+	atomic_add(&stats[path][dev_idx].dropped, len);
+}
+
+static int cmd_stats_show(const struct shell *sh, size_t argc, char **argv)
+{
+	int64_t elapsed_ms = MAX(k_uptime_get() - reset_time, 1);
+
+	shell_print(sh, "%-16s %12s %12s %10s", "Path", "Forwarded", "Dropped", "B/s");
+
+	for (size_t path = 0; path < BRIDGE_PATH_COUNT; path++) {
+		for (uint8_t i = 0; i < BRIDGE_STATS_DEV_COUNT; i++) {
+			uint32_t forwarded = atomic_get(&stats[path][i].forwarded);
+			uint32_t dropped = atomic_get(&stats[path][i].dropped);
+			char name[17];
+
+			if ((forwarded == 0) && (dropped == 0)) {
+				continue;
+			}
+
+			snprintf(name, sizeof(name), path_names[path], i, i);
+			shell_print(sh, "%-16s %12u %12u %10u", name, forwarded, dropped,
+				    (uint32_t)((uint64_t)forwarded * MSEC_PER_SEC / elapsed_ms));
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	for (size_t path = 0; path < BRIDGE_PATH_COUNT; path++) {
+		for (uint8_t i = 0; i < BRIDGE_STATS_DEV_COUNT; i++) {
+			atomic_set(&stats[path][i].forwarded, 0);
+			atomic_set(&stats[path][i].dropped, 0);
+		}
+	}
+
+	reset_time = k_uptime_get();
+
+	shell_print(sh, "Statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_bridge_stats,
+	SHELL_CMD(reset, NULL, "Reset the statistics", cmd_stats_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(bridge_stats, &sub_bridge_stats,
+		   "Show the bytes forwarded and dropped on each data path", cmd_stats_show);
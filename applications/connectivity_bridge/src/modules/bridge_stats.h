@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BRIDGE_STATS_H_
+#define _BRIDGE_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Data paths between the bridged interfaces. */
+enum bridge_path {
+	BRIDGE_PATH_UART_TO_CDC,
+	BRIDGE_PATH_CDC_TO_UART,
+	BRIDGE_PATH_UART_TO_BLE,
+	BRIDGE_PATH_BLE_TO_UART,
+
+	BRIDGE_PATH_COUNT
+};
+
+/** Number of interface instances tracked for each data path. */
+#define BRIDGE_STATS_DEV_COUNT 2
+
+#if defined(CONFIG_BRIDGE_STATS)
+/** Count bytes forwarded on a data path. Can be called from an interrupt. */
+void bridge_stats_forwarded(enum bridge_path path, uint8_t dev_idx, size_t len);
+
+/** Count bytes dropped on a data path. Can be called from an interrupt. */
+void bridge_stats_dropped(enum bridge_path path, uint8_t dev_idx, size_t len);
+#else
+static inline void bridge_stats_forwarded(enum bridge_path path, uint8_t dev_idx, size_t len)
+{
+}
+
+static inline void bridge_stats_dropped(enum bridge_path path, uint8_t dev_idx, size_t len)
+{
+}
+#endif /* CONFIG_BRIDGE_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BRIDGE_STATS_H_ */
@@ -15,6 +15,7 @@
 #include "ble_data_event.h"
 #include "cdc_data_event.h"
 #include "uart_data_event.h"
+#include "bridge_stats.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_UART_LOG_LEVEL);
@@ -312,13 +313,16 @@ static void uart_tx_finish(uint8_t dev_idx, size_t len)
 	}
 }
 
-static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx)
+static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx,
+			   enum bridge_path path)
 {
 	atomic_t started;
 	uint32_t written;
 	int err;
 
 	written = ring_buf_put(&uart_tx_ringbufs[dev_idx].rb, data, data_len);
+	bridge_stats_forwarded(path, dev_idx, written);
+	bridge_stats_dropped(path, dev_idx, data_len - written);
 	if (written == 0) {
 		return -ENOMEM;
 	}
@@ -367,7 +371,8 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			return false;
 		}
 
-		err = uart_tx_enqueue(event->buf, event->len, event->dev_idx);
+		err = uart_tx_enqueue(event->buf, event->len, event->dev_idx,
+				      BRIDGE_PATH_CDC_TO_UART);
 		if (err == -ENOMEM) {
 			LOG_WRN("CDC_%d->UART_%d overflow",
 				event->dev_idx,
@@ -389,7 +394,7 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			return false;
 		}
 
-		err = uart_tx_enqueue(event->buf, event->len, dev_idx);
+		err = uart_tx_enqueue(event->buf, event->len, dev_idx, BRIDGE_PATH_BLE_TO_UART);
 		if (err == -ENOMEM) {
 			LOG_WRN("BLE->UART_%d overflow", dev_idx);
 		} else if (err) {
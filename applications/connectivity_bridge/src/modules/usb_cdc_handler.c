@@ -13,6 +13,7 @@
 #include "peer_conn_event.h"
 #include "cdc_data_event.h"
 #include "uart_data_event.h"
+#include "bridge_stats.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_CDC_LOG_LEVEL);
@@ -118,6 +119,8 @@ static void cdc_uart_interrupt_handler(const struct device *dev, void *user_data
 					dev,
 					overflow_buf,
 					sizeof(overflow_buf));
+				bridge_stats_dropped(BRIDGE_PATH_CDC_TO_UART, dev_idx,
+						     data_length);
 				LOG_WRN("CDC_%d RX overflow", dev_idx);
 			} while (data_length == sizeof(overflow_buf));
 			return;
@@ -203,6 +206,11 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			event->buf,
 			event->len);
 
+		bridge_stats_forwarded(BRIDGE_PATH_UART_TO_CDC, event->dev_idx,
+				       MAX(tx_written, 0));
+		bridge_stats_dropped(BRIDGE_PATH_UART_TO_CDC, event->dev_idx,
+				     event->len - MAX(tx_written, 0));
+
 		if (tx_written != event->len) {
 			LOG_DBG("UART_%d->CDC_%d overflow",
 				event->dev_idx,
@@ -47,7 +47,7 @@ uint8_t BleEnvironmentalDataProvider::GattTemperatureNotifyCallback(bt_conn *con
 
 	/* Save data received in notification. */
 	memcpy(&provider->mTemperatureValue, data, length);
-	DeviceLayer::PlatformMgr().ScheduleWork(NotifyTemperatureAttributeChange, reinterpret_cast<intptr_t>(provider));
+	provider->ReportAttributeChange(kTemperatureAttribute);
 
 exit:
 
@@ -64,7 +64,7 @@ uint8_t BleEnvironmentalDataProvider::GattHumidityNotifyCallback(bt_conn *conn,
 
 	/* Save data received in notification. */
 	memcpy(&provider->mHumidityValue, data, length);
-	DeviceLayer::PlatformMgr().ScheduleWork(NotifyHumidityAttributeChange, reinterpret_cast<intptr_t>(provider));
+	provider->ReportAttributeChange(kHumidityAttribute);
 
 exit:
 
@@ -119,10 +119,19 @@ int BleEnvironmentalDataProvider::ParseDiscoveredData(bt_gatt_dm *discoveredData
 
 	/* All characteristics are correct so start the new subscription */
 	Subscribe();
+	mDiscoveryCached = true;
 
 	return 0;
 }
 
+int BleEnvironmentalDataProvider::ResumeSubscription()
+{
+	int err = Subscribe();
+
+	/* The host keeps the subscriptions of a bonded device after the disconnection. */
+	return (err == -EALREADY) ? 0 : err;
+}
+
 CHIP_ERROR BleEnvironmentalDataProvider::ParseTemperatureCharacteristic(bt_gatt_dm *discoveredData)
 {
 	const bt_gatt_dm_attr *gatt_chrc = bt_gatt_dm_char_by_uuid(discoveredData, sUuidTemperature);
@@ -160,9 +169,11 @@ CHIP_ERROR BleEnvironmentalDataProvider::ParseHumidityCharacteristic(bt_gatt_dm
 	return CHIP_NO_ERROR;
 }
 
-void BleEnvironmentalDataProvider::Subscribe()
+int BleEnvironmentalDataProvider::Subscribe()
 {
-	VerifyOrReturn(mDevice.mConn, LOG_ERR("Invalid connection object"));
+	int err = 0;
+
+	VerifyOrReturnError(mDevice.mConn, -ENOTCONN, LOG_ERR("Invalid connection object"));
 
 	/* Configure subscription for the temperature characteristic */
 	mGattTemperatureSubscribeParams.ccc_handle = mCccTemperatureHandle;
@@ -179,18 +190,20 @@ void BleEnvironmentalDataProvider::Subscribe()
 	mGattHumiditySubscribeParams.subscribe = nullptr;
 
 	if (CheckSubscriptionParameters(&mGattTemperatureSubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattTemperatureSubscribeParams);
+		err = bt_gatt_subscribe(mDevice.mConn, &mGattTemperatureSubscribeParams);
 		if (err) {
 			LOG_ERR("Subscribe to temperature characteristic failed with error %d", err);
 		}
 	} else {
 		LOG_ERR("Invalid temperature subscription parameters provided");
+		err = -EINVAL;
 	}
 
 	if (CheckSubscriptionParameters(&mGattHumiditySubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattHumiditySubscribeParams);
-		if (err) {
-			LOG_ERR("Subscribe to humidity characteristic failed with error %d", err);
+		int humidityErr = bt_gatt_subscribe(mDevice.mConn, &mGattHumiditySubscribeParams);
+		if (humidityErr) {
+			LOG_ERR("Subscribe to humidity characteristic failed with error %d", humidityErr);
+			err = err ? err : humidityErr;
 		}
 	} else {
 		LOG_INF("Invalid humidity subscription parameters provided, starting emulated subscription");
@@ -202,6 +215,8 @@ void BleEnvironmentalDataProvider::Subscribe()
 		sHumidityReadParams.by_uuid.uuid = sUuidHumidity;
 		StartHumidityTimer();
 	}
+
+	return err;
 }
 
 void BleEnvironmentalDataProvider::Unsubscribe()
@@ -232,22 +247,19 @@ bool BleEnvironmentalDataProvider::CheckSubscriptionParameters(bt_gatt_subscribe
 	return true;
 }
 
-void BleEnvironmentalDataProvider::NotifyTemperatureAttributeChange(intptr_t context)
+void BleEnvironmentalDataProvider::NotifyAttributesChange(uint32_t attributes)
 {
-	BleEnvironmentalDataProvider *provider = reinterpret_cast<BleEnvironmentalDataProvider *>(context);
-
-	provider->NotifyUpdateState(Clusters::TemperatureMeasurement::Id,
-				    Clusters::TemperatureMeasurement::Attributes::MeasuredValue::Id,
-				    &provider->mTemperatureValue, sizeof(provider->mTemperatureValue));
-}
-
-void BleEnvironmentalDataProvider::NotifyHumidityAttributeChange(intptr_t context)
-{
-	BleEnvironmentalDataProvider *provider = reinterpret_cast<BleEnvironmentalDataProvider *>(context);
+	if (attributes & BIT(kTemperatureAttribute)) {
+		NotifyUpdateState(Clusters::TemperatureMeasurement::Id,
+				  Clusters::TemperatureMeasurement::Attributes::MeasuredValue::Id, &mTemperatureValue,
+				  sizeof(mTemperatureValue));
+	}
 
-	provider->NotifyUpdateState(Clusters::RelativeHumidityMeasurement::Id,
-				    Clusters::RelativeHumidityMeasurement::Attributes::MeasuredValue::Id,
-				    &provider->mHumidityValue, sizeof(provider->mHumidityValue));
+	if (attributes & BIT(kHumidityAttribute)) {
+		NotifyUpdateState(Clusters::RelativeHumidityMeasurement::Id,
+				  Clusters::RelativeHumidityMeasurement::Attributes::MeasuredValue::Id, &mHumidityValue,
+				  sizeof(mHumidityValue));
+	}
 }
 
 void BleEnvironmentalDataProvider::StartHumidityTimer()
@@ -290,8 +302,7 @@ uint8_t BleEnvironmentalDataProvider::HumidityGATTReadCallback(bt_conn *conn, ui
 		memcpy(&newValue, data, sizeof(newValue));
 		if (newValue != provider->mHumidityValue) {
 			provider->mHumidityValue = newValue;
-			DeviceLayer::PlatformMgr().ScheduleWork(NotifyHumidityAttributeChange,
-								reinterpret_cast<intptr_t>(provider));
+			provider->ReportAttributeChange(kHumidityAttribute);
 		}
 	} else {
 		LOG_ERR("Unsuccessful GATT read operation (err %d)", att_err);
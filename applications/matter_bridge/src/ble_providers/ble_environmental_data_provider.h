@@ -21,13 +21,18 @@ public:
 	CHIP_ERROR UpdateState(chip::ClusterId clusterId, chip::AttributeId attributeId, uint8_t *buffer) override;
 	const bt_uuid *GetServiceUuid() override;
 	int ParseDiscoveredData(bt_gatt_dm *discoveredData) override;
+	int ResumeSubscription() override;
+	void NotifyAttributesChange(uint32_t attributes) override;
 
 private:
 	static constexpr uint32_t kMeasurementsIntervalMs{ CONFIG_BRIDGE_BLE_DEVICE_POLLING_INTERVAL };
 
+	/* Indexes of the attributes reported with ReportAttributeChange(). */
+	enum ReportedAttribute : uint8_t { kTemperatureAttribute, kHumidityAttribute };
+
 	void StartHumidityTimer();
 	void StopHumidityTimer() { k_timer_stop(&mHumidityTimer); }
-	void Subscribe();
+	int Subscribe();
 	void Unsubscribe();
 	bool CheckSubscriptionParameters(bt_gatt_subscribe_params *params);
 
@@ -38,8 +43,6 @@ private:
 						     uint16_t length);
 	static uint8_t GattHumidityNotifyCallback(bt_conn *conn, bt_gatt_subscribe_params *params, const void *data,
 						  uint16_t length);
-	static void NotifyTemperatureAttributeChange(intptr_t context);
-	static void NotifyHumidityAttributeChange(intptr_t context);
 
 	static void ReadGATTHumidity(intptr_t context);
 	static void HumidityTimerTimeoutCallback(k_timer *timer);
@@ -77,7 +77,8 @@ uint8_t BleLBSDataProvider::GattNotifyCallback(bt_conn *conn, bt_gatt_subscribe_
 #ifdef CONFIG_BRIDGE_GENERIC_SWITCH_BRIDGED_DEVICE
 	VerifyOrExit(length == sizeof(mCurrentSwitchPosition), );
 
-	/* Save data received in the notification. */
+	/* Save data received in the notification. The switch position is not coalesced, as every position change
+	 * generates a Switch cluster event. */
 	memcpy(&provider->mCurrentSwitchPosition, data, length);
 	DeviceLayer::PlatformMgr().ScheduleWork(NotifySwitchCurrentPositionAttributeChange,
 						reinterpret_cast<intptr_t>(provider));
@@ -137,8 +138,7 @@ void BleLBSDataProvider::GattWriteCallback(bt_conn *conn, uint8_t err, bt_gatt_w
 
 	/* Save data received in GATT write response. */
 	memcpy(&provider->mOnOff, params->data, params->length);
-
-	DeviceLayer::PlatformMgr().ScheduleWork(NotifyOnOffAttributeChange, reinterpret_cast<intptr_t>(provider));
+	provider->ReportAttributeChange(kOnOffAttribute);
 }
 
 CHIP_ERROR BleLBSDataProvider::UpdateState(chip::ClusterId clusterId, chip::AttributeId attributeId, uint8_t *buffer)
@@ -187,9 +187,11 @@ const bt_uuid *BleLBSDataProvider::GetServiceUuid()
 	return sServiceUuid;
 }
 
-void BleLBSDataProvider::Subscribe()
+int BleLBSDataProvider::Subscribe()
 {
-	VerifyOrReturn(mDevice.mConn, LOG_ERR("Invalid connection object"));
+	int err;
+
+	VerifyOrReturnError(mDevice.mConn, -ENOTCONN, LOG_ERR("Invalid connection object"));
 
 	/* Configure subscription for the button characteristic */
 	mGattSubscribeParams.ccc_handle = mCccHandle;
@@ -199,13 +201,16 @@ void BleLBSDataProvider::Subscribe()
 	mGattSubscribeParams.subscribe = nullptr;
 
 	if (CheckSubscriptionParameters(&mGattSubscribeParams)) {
-		int err = bt_gatt_subscribe(mDevice.mConn, &mGattSubscribeParams);
+		err = bt_gatt_subscribe(mDevice.mConn, &mGattSubscribeParams);
 		if (err) {
 			LOG_ERR("Subscribe to button characteristic failed with error %d", err);
 		}
 	} else {
 		LOG_ERR("Invalid button subscription parameters provided");
+		err = -EINVAL;
 	}
+
+	return err;
 }
 
 int BleLBSDataProvider::ParseDiscoveredData(bt_gatt_dm *discoveredData)
@@ -248,16 +253,24 @@ int BleLBSDataProvider::ParseDiscoveredData(bt_gatt_dm *discoveredData)
 
 	/* All characteristics are correct so start the new subscription */
 	Subscribe();
+	mDiscoveryCached = true;
 
 	return 0;
 }
 
-void BleLBSDataProvider::NotifyOnOffAttributeChange(intptr_t context)
+int BleLBSDataProvider::ResumeSubscription()
 {
-	BleLBSDataProvider *provider = reinterpret_cast<BleLBSDataProvider *>(context);
+	int err = Subscribe();
 
-	provider->NotifyUpdateState(Clusters::OnOff::Id, Clusters::OnOff::Attributes::OnOff::Id, &provider->mOnOff,
-				    sizeof(provider->mOnOff));
+	/* The host keeps the subscriptions of a bonded device after the disconnection. */
+	return (err == -EALREADY) ? 0 : err;
+}
+
+void BleLBSDataProvider::NotifyAttributesChange(uint32_t attributes)
+{
+	if (attributes & BIT(kOnOffAttribute)) {
+		NotifyUpdateState(Clusters::OnOff::Id, Clusters::OnOff::Attributes::OnOff::Id, &mOnOff, sizeof(mOnOff));
+	}
 }
 
 #ifdef CONFIG_BRIDGE_GENERIC_SWITCH_BRIDGED_DEVICE
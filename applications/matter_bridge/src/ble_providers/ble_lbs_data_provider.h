@@ -24,7 +24,6 @@ public:
 			       size_t dataSize) override;
 	CHIP_ERROR UpdateState(chip::ClusterId clusterId, chip::AttributeId attributeId, uint8_t *buffer) override;
 
-	static void NotifyOnOffAttributeChange(intptr_t context);
 #ifdef CONFIG_BRIDGE_GENERIC_SWITCH_BRIDGED_DEVICE
 	static void NotifySwitchCurrentPositionAttributeChange(intptr_t context);
 #endif
@@ -35,9 +34,14 @@ public:
 
 	const bt_uuid *GetServiceUuid() override;
 	int ParseDiscoveredData(bt_gatt_dm *discoveredData) override;
+	int ResumeSubscription() override;
+	void NotifyAttributesChange(uint32_t attributes) override;
 
 private:
-	void Subscribe();
+	/* Indexes of the attributes reported with ReportAttributeChange(). */
+	enum ReportedAttribute : uint8_t { kOnOffAttribute };
+
+	int Subscribe();
 	bool CheckSubscriptionParameters(bt_gatt_subscribe_params *params);
 
 	bool mOnOff = false;
@@ -8,6 +8,7 @@
 #include "platform/ConfigurationManager.h"
 
 #ifdef CONFIG_BRIDGED_DEVICE_BT
+#include "ble_bridged_device.h"
 #include "ble_bridged_device_factory.h"
 #include "ble_connectivity_manager.h"
 #else
@@ -239,6 +240,26 @@ static int ScanBridgedDeviceHandler(const struct shell *shell, size_t argc, char
 
 	return 0;
 }
+
+static int ReportStatsHandler(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") != 0) {
+			shell_fprintf(shell, SHELL_ERROR, "Invalid argument.\n");
+			return -EINVAL;
+		}
+
+		Nrf::BLEBridgedDeviceProvider::ResetReportStats();
+		shell_fprintf(shell, SHELL_INFO, "Done\n");
+		return 0;
+	}
+
+	shell_fprintf(shell, SHELL_INFO, "Reports delivered: %u\n", Nrf::BLEBridgedDeviceProvider::GetDeliveredReports());
+	shell_fprintf(shell, SHELL_INFO, "Reports suppressed: %u\n",
+		      Nrf::BLEBridgedDeviceProvider::GetSuppressedReports());
+
+	return 0;
+}
 #endif /* CONFIG_BRIDGED_DEVICE_BT */
 
 SHELL_STATIC_SUBCMD_SET_CREATE(
@@ -296,6 +317,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		      "* pincode - is a pin required for Bluetooth LE pairing authentication\n",
 		      InsertBridgedDevicePincodeHandler, 3, 0),
 #endif /* CONFIG_BT_SMP */
+	SHELL_CMD_ARG(report_stats, NULL,
+		      "Prints the number of attribute reports of Bluetooth LE devices. \n"
+		      "Usage: report_stats [reset]\n"
+		      "* reset - resets the counters\n",
+		      ReportStatsHandler, 1, 1),
 #endif /* CONFIG_BRIDGED_DEVICE_BT */
 	SHELL_SUBCMD_SET_END);
 
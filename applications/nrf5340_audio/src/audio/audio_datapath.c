@@ -13,7 +13,6 @@
 #include <zephyr/kernel.h>
 #include <zephyr/shell/shell.h>
 #include <nrfx_clock.h>
-#include <contin_array.h>
 #include <tone.h>
 #include <pcm_mix.h>
 
@@ -83,6 +82,8 @@ LOG_MODULE_REGISTER(audio_datapath, CONFIG_AUDIO_DATAPATH_LOG_LEVEL);
 /* To get smaller corrections */
 #define DRIFT_REGULATOR_DIV_FACTOR 2
 
+#define DRIFT_COMP_WORK_Q_STACK_SIZE 1024
+
 /* To allow BLE transmission and (host -> HCI -> controller) */
 #define JUST_IN_TIME_TARGET_DLY_US 3000
 #define JUST_IN_TIME_BOUND_US	   2500
@@ -146,10 +147,12 @@ static struct {
 
 	struct {
 		enum drift_comp_state state: 8;
-		uint16_t ctr; /* Count func calls. Used for waiting */
+		uint16_t ctr; /* Count I2S blocks. Used for waiting */
 		uint32_t meas_start_time_us;
 		uint32_t center_freq;
 		bool enabled;
+		atomic_t pending_blks; /* I2S blocks completed since the last compensation run */
+		uint32_t frame_start_ts_us; /* Start of the last completed I2S block */
 	} drift_comp;
 
 	struct {
@@ -175,6 +178,17 @@ static int filled_blocks_get(void)
 	}
 }
 
+K_THREAD_STACK_DEFINE(drift_comp_work_q_stack, DRIFT_COMP_WORK_Q_STACK_SIZE);
+
+static struct k_work_q drift_comp_work_q;
+
+static const struct k_work_queue_config drift_comp_work_q_config = {
+	.name = "drift_comp",
+	.no_yield = false,
+};
+
+static struct k_work drift_comp_work;
+
 static bool tone_active;
 /* Buffer which can hold max 1 period test tone at 100 Hz */
 static uint16_t test_tone_buf[CONFIG_AUDIO_SAMPLE_RATE_HZ / 100];
@@ -244,8 +258,9 @@ static void drift_comp_state_set(enum drift_comp_state new_state)
  * @note	The audio sync is based on sdu_ref_us.
  *
  * @param	frame_start_ts_us	I2S frame start timestamp.
+ * @param	num_blks		Number of I2S blocks completed since the last call.
  */
-static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
+static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us, uint32_t num_blks)
 {
 	if (CONFIG_AUDIO_DEV == HEADSET) {
 		/** For headsets we do not use the timestamp gotten from hci_tx_sync_get to adjust
@@ -265,7 +280,8 @@ static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
 		break;
 	}
 	case DRIFT_STATE_CALIB: {
-		if (++ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
+		ctrl_blk.drift_comp.ctr += num_blks;
+		if (ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
 			/* Waiting */
 			return;
 		}
@@ -293,7 +309,8 @@ static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
 		break;
 	}
 	case DRIFT_STATE_OFFSET: {
-		if (++ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
+		ctrl_blk.drift_comp.ctr += num_blks;
+		if (ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
 			/* Waiting */
 			return;
 		}
@@ -315,7 +332,8 @@ static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
 		break;
 	}
 	case DRIFT_STATE_LOCKED: {
-		if (++ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
+		ctrl_blk.drift_comp.ctr += num_blks;
+		if (ctrl_blk.drift_comp.ctr < DRIFT_COMP_WAITING_CNT) {
 			/* Waiting */
 			return;
 		}
@@ -342,6 +360,22 @@ static void audio_datapath_drift_compensation(uint32_t frame_start_ts_us)
 	}
 }
 
+/*
+ * Drift compensation adjusts the audio PLL and logs state changes, so it runs in a preemptible
+ * work queue instead of the I2S interrupt. Blocks completed while the work is pending are counted,
+ * so the measurement periods are kept.
+ */
+static void drift_comp_work_handler(struct k_work *work)
+{
+	uint32_t num_blks = atomic_clear(&ctrl_blk.drift_comp.pending_blks);
+
+	if (num_blks == 0 || !ctrl_blk.drift_comp.enabled) {
+		return;
+	}
+
+	audio_datapath_drift_compensation(ctrl_blk.drift_comp.frame_start_ts_us, num_blks);
+}
+
 static void pres_comp_state_set(enum pres_comp_state new_state)
 {
 	int ret;
@@ -548,16 +582,32 @@ void audio_datapath_tone_stop(void)
 static void tone_mix(uint8_t *tx_buf)
 {
 	int ret;
-	int8_t tone_buf_continuous[BLK_MONO_SIZE_OCTETS];
 	static uint32_t finite_pos;
+	uint32_t mixed = 0;
 
-	ret = contin_array_create(tone_buf_continuous, BLK_MONO_SIZE_OCTETS, test_tone_buf,
-				  test_tone_size, &finite_pos);
-	ERR_CHK(ret);
+	if (test_tone_size == 0) {
+		return;
+	}
 
-	ret = pcm_mix(tx_buf, BLK_STEREO_SIZE_OCTETS, tone_buf_continuous, BLK_MONO_SIZE_OCTETS,
-		      B_MONO_INTO_A_STEREO_L);
-	ERR_CHK(ret);
+	if (finite_pos >= test_tone_size) {
+		finite_pos = 0;
+	}
+
+	/* Mix the tone period straight into the block, wrapping around at the end of the period */
+	while (mixed < BLK_MONO_SIZE_OCTETS) {
+		uint32_t len = MIN(test_tone_size - finite_pos, BLK_MONO_SIZE_OCTETS - mixed);
+
+		ret = pcm_mix(&tx_buf[mixed * 2], BLK_STEREO_SIZE_OCTETS - (mixed * 2),
+			      &((uint8_t *)test_tone_buf)[finite_pos], len, B_MONO_INTO_A_STEREO_L);
+		ERR_CHK(ret);
+
+		mixed += len;
+		finite_pos += len;
+
+		if (finite_pos == test_tone_size) {
+			finite_pos = 0;
+		}
+	}
 }
 
 /* Alternate-buffers used when there is no active audio stream.
@@ -736,7 +786,9 @@ static void audio_datapath_i2s_blk_complete(uint32_t frame_start_ts_us, uint32_t
 
 	/*** Drift compensation ***/
 	if (ctrl_blk.drift_comp.enabled) {
-		audio_datapath_drift_compensation(frame_start_ts_us);
+		ctrl_blk.drift_comp.frame_start_ts_us = frame_start_ts_us;
+		atomic_inc(&ctrl_blk.drift_comp.pending_blks);
+		k_work_submit_to_queue(&drift_comp_work_q, &drift_comp_work);
 	}
 }
 
@@ -986,18 +1038,19 @@ void audio_datapath_stream_out(const uint8_t *buf, size_t size, uint32_t sdu_ref
 	}
 
 	uint32_t out_blk_idx = ctrl_blk.out.prod_blk_idx;
+	uint32_t num_blks_to_end = MIN(NUM_BLKS_IN_FRAME, FIFO_NUM_BLKS - out_blk_idx);
+	uint8_t const *decoded_data = ctrl_blk.decoded_data;
 
-	for (uint32_t i = 0; i < NUM_BLKS_IN_FRAME; i++) {
-		if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_16)) {
-			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_STEREO_NUM_SAMPS],
-			       &((int16_t *)ctrl_blk.decoded_data)[i * BLK_STEREO_NUM_SAMPS],
-			       BLK_STEREO_SIZE_OCTETS);
-		} else if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_32)) {
-			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_STEREO_NUM_SAMPS],
-			       &((int32_t *)ctrl_blk.decoded_data)[i * BLK_STEREO_NUM_SAMPS],
-			       BLK_STEREO_SIZE_OCTETS);
-		}
+	/* Copy the frame in one piece, or in two if it wraps around the end of the FIFO */
+	memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_STEREO_NUM_SAMPS], decoded_data,
+	       num_blks_to_end * BLK_STEREO_SIZE_OCTETS);
+
+	if (num_blks_to_end < NUM_BLKS_IN_FRAME) {
+		memcpy(&ctrl_blk.out.fifo[0], &decoded_data[num_blks_to_end * BLK_STEREO_SIZE_OCTETS],
+		       (NUM_BLKS_IN_FRAME - num_blks_to_end) * BLK_STEREO_SIZE_OCTETS);
+	}
 
+	for (uint32_t i = 0; i < NUM_BLKS_IN_FRAME; i++) {
 		/* Record producer block start reference */
 		ctrl_blk.out.prod_blk_ts[out_blk_idx] = recv_frame_ts_us + (i * BLK_PERIOD_US);
 
@@ -1036,6 +1089,8 @@ int audio_datapath_stop(void)
 	if (ctrl_blk.stream_started) {
 		ctrl_blk.stream_started = false;
 		audio_datapath_i2s_stop();
+		k_work_cancel(&drift_comp_work);
+		atomic_clear(&ctrl_blk.drift_comp.pending_blks);
 		ctrl_blk.prev_pres_sdu_ref_us = 0;
 		ctrl_blk.prev_drift_sdu_ref_us = 0;
 
@@ -1050,6 +1105,13 @@ int audio_datapath_stop(void)
 int audio_datapath_init(void)
 {
 	memset(&ctrl_blk, 0, sizeof(ctrl_blk));
+
+	k_work_queue_init(&drift_comp_work_q);
+	k_work_queue_start(&drift_comp_work_q, drift_comp_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(drift_comp_work_q_stack),
+			   K_PRIO_PREEMPT(CONFIG_DRIFT_COMP_WORK_Q_PRIO), &drift_comp_work_q_config);
+	k_work_init(&drift_comp_work, drift_comp_work_handler);
+
 	audio_i2s_blk_comp_cb_register(audio_datapath_i2s_blk_complete);
 	audio_i2s_init();
 	ctrl_blk.datapath_initialized = true;
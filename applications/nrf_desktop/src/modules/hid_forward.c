@@ -214,20 +214,10 @@ static uint8_t hogp_read(struct bt_hogp *hids_c,
 		return BT_GATT_ITER_CONTINUE;
 	}
 
-	uint8_t report_id = bt_hogp_rep_id(rep);
+	/* Report ID is resolved when subscribing to the report (see hogp_ready). */
+	uint8_t report_id = POINTER_TO_UINT(bt_hogp_rep_user_data(rep));
 	size_t size = bt_hogp_rep_size(rep);
 
-	/* HID boot protocol reports are received with report ID equal 0 (REPORT_ID_RESERVED).
-	 * The report ID must be updated before HID report is forwarded as an Event Manager event.
-	 */
-	if (report_id == REPORT_ID_RESERVED) {
-		if (bt_hogp_rep_boot_kbd_in(hids_c)) {
-			report_id = REPORT_ID_BOOT_KEYBOARD;
-		} else if (bt_hogp_rep_boot_mouse_in(hids_c)) {
-			report_id = REPORT_ID_BOOT_MOUSE;
-		}
-	}
-
 	forward_hid_report(per, report_id, data, size);
 
 	return BT_GATT_ITER_CONTINUE;
@@ -790,8 +780,13 @@ static void hogp_ready(struct bt_hogp *hids_c)
 {
 	struct bt_hogp_rep_info *rep = NULL;
 
+	/* The report ID used to forward the HID report is stored as report user data, so that it
+	 * does not need to be resolved for every received report.
+	 */
 	while (NULL != (rep = bt_hogp_rep_next(hids_c, rep))) {
 		if (bt_hogp_rep_type(rep) == BT_HIDS_REPORT_TYPE_INPUT) {
+			bt_hogp_rep_user_data_set(rep, UINT_TO_POINTER(bt_hogp_rep_id(rep)));
+
 			int err = bt_hogp_rep_subscribe(hids_c, rep, hogp_read);
 
 			if (err) {
@@ -802,9 +797,14 @@ static void hogp_ready(struct bt_hogp *hids_c)
 		}
 	}
 
+	/* HID boot protocol reports are received with report ID equal 0 (REPORT_ID_RESERVED).
+	 * The report ID must be updated before HID report is forwarded as an Event Manager event.
+	 */
 	rep = bt_hogp_rep_boot_kbd_in(hids_c);
 
 	if (rep) {
+		bt_hogp_rep_user_data_set(rep, UINT_TO_POINTER(REPORT_ID_BOOT_KEYBOARD));
+
 		int err = bt_hogp_rep_subscribe(hids_c, rep, hogp_read);
 
 		if (err) {
@@ -817,6 +817,8 @@ static void hogp_ready(struct bt_hogp *hids_c)
 	rep = bt_hogp_rep_boot_mouse_in(hids_c);
 
 	if (rep) {
+		bt_hogp_rep_user_data_set(rep, UINT_TO_POINTER(REPORT_ID_BOOT_MOUSE));
+
 		int err = bt_hogp_rep_subscribe(hids_c, rep, hogp_read);
 
 		if (err) {
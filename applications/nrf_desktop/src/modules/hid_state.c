@@ -13,6 +13,7 @@
 #include <limits.h>
 #include <sys/types.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/sys/util.h>
@@ -67,6 +68,8 @@ enum state {
 
 #define AXIS_COUNT (IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_MOUSE_SUPPORT) * MOUSE_REPORT_AXIS_COUNT)
 
+#define LATENCY_EVENT_NAME "hid_state_report_latency"
+
 /**@brief HID state item. */
 struct item {
 	uint16_t usage_id; /**< HID usage ID. */
@@ -99,11 +102,25 @@ struct axis_data {
 	uint8_t axis_count; /**< Number of axes in this array. */
 };
 
+#ifdef CONFIG_DESKTOP_HID_STATE_LATENCY_PROFILER
+/**@brief Latency measurement of a HID report that is in flight. */
+struct latency_probe {
+	uint32_t handled_time; /**< Cycle count of handling the oldest input in the report. */
+	uint32_t submit_time; /**< Cycle count of the report submission. */
+	uint8_t reports_ahead; /**< Number of reports in the pipeline ahead of the report. */
+	bool active; /**< True if the report is being measured. */
+};
+#endif
+
 struct report_data {
 	struct items items;
 	struct eventq eventq;
 	struct axis_data axes;
 	struct report_state *linked_rs;
+#ifdef CONFIG_DESKTOP_HID_STATE_LATENCY_PROFILER
+	uint32_t handled_time;
+	bool input_pending;
+#endif
 };
 
 struct report_state {
@@ -113,6 +130,9 @@ struct report_state {
 	struct subscriber *subscriber;
 	struct report_data *linked_rd;
 	bool update_needed;
+#ifdef CONFIG_DESKTOP_HID_STATE_LATENCY_PROFILER
+	struct latency_probe probe;
+#endif
 };
 
 struct output_report_state {
@@ -150,6 +170,107 @@ static bool report_send(struct report_state *rs,
 			bool send_always);
 
 
+#ifdef CONFIG_DESKTOP_HID_STATE_LATENCY_PROFILER
+static uint16_t latency_event_id;
+
+/* The input is timestamped when the HID state handles its event, not when the event is submitted.
+ * The time the event spends in the application event queue is therefore not measured.
+ */
+static void latency_input_handled(struct report_data *rd)
+{
+	if (!rd->input_pending) {
+		rd->handled_time = k_cycle_get_32();
+		rd->input_pending = true;
+	}
+}
+
+static void latency_input_clear(struct report_data *rd)
+{
+	rd->input_pending = false;
+}
+
+static void latency_report_submitted(struct report_state *rs, struct report_data *rd)
+{
+	if (!rd->input_pending) {
+		return;
+	}
+
+	/* Only one report per report state is measured at a time. Reports
+	 * submitted while the measured report is in flight are skipped.
+	 */
+	if (!rs->probe.active) {
+		rs->probe.handled_time = rd->handled_time;
+		rs->probe.submit_time = k_cycle_get_32();
+		rs->probe.reports_ahead = rs->cnt;
+		rs->probe.active = true;
+	}
+
+	rd->input_pending = false;
+}
+
+static void latency_report_issued(struct report_state *rs, bool error)
+{
+	struct latency_probe *probe = &rs->probe;
+
+	if (!probe->active) {
+		return;
+	}
+
+	if (probe->reports_ahead > 0) {
+		probe->reports_ahead--;
+		return;
+	}
+
+	probe->active = false;
+
+	if (error || !is_profiling_enabled(latency_event_id)) {
+		return;
+	}
+
+	uint32_t sent_time = k_cycle_get_32();
+	struct log_event_buf buf;
+
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint8(&buf, rs->report_id);
+	nrf_profiler_log_encode_uint32(&buf,
+		k_cyc_to_us_floor32(probe->submit_time - probe->handled_time));
+	nrf_profiler_log_encode_uint32(&buf,
+		k_cyc_to_us_floor32(sent_time - probe->handled_time));
+	nrf_profiler_log_send(&buf, latency_event_id);
+}
+
+static void latency_report_reset(struct report_state *rs)
+{
+	rs->probe.active = false;
+}
+
+static void latency_init(void)
+{
+	static const char * const arg_names[] = {
+		"report_id",
+		"handled_to_submit_us",
+		"handled_to_sent_us",
+	};
+	static const enum nrf_profiler_arg arg_types[] = {
+		NRF_PROFILER_ARG_U8,
+		NRF_PROFILER_ARG_U32,
+		NRF_PROFILER_ARG_U32,
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(arg_names) == ARRAY_SIZE(arg_types));
+
+	latency_event_id = nrf_profiler_register_event_type(LATENCY_EVENT_NAME, arg_names,
+							    arg_types, ARRAY_SIZE(arg_types));
+}
+#else
+static void latency_input_handled(struct report_data *rd) {}
+static void latency_input_clear(struct report_data *rd) {}
+static void latency_report_submitted(struct report_state *rs, struct report_data *rd) {}
+static void latency_report_issued(struct report_state *rs, bool error) {}
+static void latency_report_reset(struct report_state *rs) {}
+static void latency_init(void) {}
+#endif /* CONFIG_DESKTOP_HID_STATE_LATENCY_PROFILER */
+
 /**@brief Compare Key ID in HID Keymap entries. */
 static int hid_keymap_compare(const void *a, const void *b)
 {
@@ -400,6 +521,7 @@ static void clear_report_data(struct report_data *rd)
 	clear_axes(&rd->axes);
 	clear_items(&rd->items);
 	eventq_reset(&rd->eventq);
+	latency_input_clear(rd);
 }
 
 static struct report_state *get_report_state(struct subscriber *subscriber,
@@ -871,6 +993,8 @@ static bool report_send(struct report_state *rs,
 				break;
 			}
 
+			latency_report_submitted(rs, rd);
+
 			__ASSERT_NO_MSG(rs->cnt < UINT8_MAX);
 			rs->cnt++;
 			rs->subscriber->report_cnt++;
@@ -911,6 +1035,8 @@ static void report_issued(const void *subscriber_id, uint8_t report_id, bool err
 	__ASSERT_NO_MSG(rs);
 
 	if (rs->state != STATE_DISCONNECTED) {
+		latency_report_issued(rs, error);
+
 		__ASSERT_NO_MSG(rs->cnt > 0);
 		rs->cnt--;
 
@@ -1136,6 +1262,7 @@ static void disconnect(const void *subscriber_id, uint8_t report_id)
 	rs->subscriber = NULL;
 	rs->state = STATE_DISCONNECTED;
 	rs->cnt = 0;
+	latency_report_reset(rs);
 
 	struct report_data *rd = rs->linked_rd;
 
@@ -1294,9 +1421,11 @@ static void update_key(const struct hid_keymap *map, int16_t value)
 	if (!connected || !eventq_is_empty(&rd->eventq)) {
 		/* Report cannot be sent yet - enqueue this HID event. */
 		enqueue(rd, map->usage_id, value, connected);
+		latency_input_handled(rd);
 	} else {
 		/* Update state and issue report generation event. */
 		if (key_value_set(&rd->items, map->usage_id, value)) {
+			latency_input_handled(rd);
 			report_send(NULL, rd, false, true);
 		}
 	}
@@ -1379,6 +1508,8 @@ static void init(void)
 
 	__ASSERT_NO_MSG(data_id == INPUT_REPORT_DATA_COUNT);
 	__ASSERT_NO_MSG(state_id == INPUT_REPORT_STATE_COUNT);
+
+	latency_init();
 }
 
 static bool handle_motion_event(const struct motion_event *event)
@@ -1392,6 +1523,7 @@ static bool handle_motion_event(const struct motion_event *event)
 
 	rd->axes.axis[MOUSE_REPORT_AXIS_X] += event->dx;
 	rd->axes.axis[MOUSE_REPORT_AXIS_Y] += event->dy;
+	latency_input_handled(rd);
 
 	report_send(NULL, rd, true, true);
 
@@ -1408,6 +1540,7 @@ static bool handle_wheel_event(const struct wheel_event *event)
 	__ASSERT_NO_MSG(rd != NULL);
 
 	rd->axes.axis[MOUSE_REPORT_AXIS_WHEEL] += event->wheel;
+	latency_input_handled(rd);
 
 	report_send(NULL, rd, true, true);
 
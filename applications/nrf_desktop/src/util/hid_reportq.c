@@ -38,6 +38,16 @@ struct hid_reportq {
 
 static struct hid_reportq queues[CONFIG_DESKTOP_HID_REPORTQ_QUEUE_COUNT];
 
+/* Enqueued report descriptors are taken from a memory slab sized for the worst case, to avoid
+ * a heap allocation for every report enqueued while the subscriber is busy.
+ */
+K_MEM_SLAB_DEFINE_STATIC(enqueued_report_slab, sizeof(struct enqueued_report),
+			 ARRAY_SIZE(queues) * ARRAY_SIZE(input_reports) * MAX_ENQUEUED_REPORTS,
+			 sizeof(void *));
+
+/* Input report index for every report ID, set up on the first queue allocation. */
+static uint8_t input_report_idx[REPORT_ID_COUNT];
+
 /* Ensure that enabled_report_idx_bm can handle all of the report indexes. */
 BUILD_ASSERT(ARRAY_SIZE(input_reports) <= 16);
 
@@ -73,7 +83,7 @@ static struct hid_report_event *get_enqueued_event(struct counted_list *cnt_list
 
 	struct hid_report_event *event = report->event;
 
-	k_free(report);
+	k_mem_slab_free(&enqueued_report_slab, report);
 
 	return event;
 }
@@ -95,7 +105,9 @@ static void enqueue_event(struct counted_list *cnt_list, struct hid_report_event
 	struct enqueued_report *report;
 
 	if (cnt_list->node_count < MAX_ENQUEUED_REPORTS) {
-		report = k_malloc(sizeof(*report));
+		if (k_mem_slab_alloc(&enqueued_report_slab, (void **)&report, K_NO_WAIT)) {
+			report = NULL;
+		}
 	} else {
 		LOG_WRN("Enqueue dropped the oldest report");
 
@@ -114,6 +126,25 @@ static void enqueue_event(struct counted_list *cnt_list, struct hid_report_event
 	}
 }
 
+static void input_report_idx_init(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		return;
+	}
+
+	BUILD_ASSERT(ARRAY_SIZE(input_reports) < UINT8_MAX);
+	memset(input_report_idx, UINT8_MAX, sizeof(input_report_idx));
+
+	for (size_t i = 0; i < ARRAY_SIZE(input_reports); i++) {
+		__ASSERT_NO_MSG(input_reports[i] < ARRAY_SIZE(input_report_idx));
+		input_report_idx[input_reports[i]] = i;
+	}
+
+	initialized = true;
+}
+
 static struct hid_reportq *reportq_find_free(void)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(queues); i++) {
@@ -132,6 +163,8 @@ struct hid_reportq *hid_reportq_alloc(const void *sub_id, uint8_t report_max)
 	__ASSERT_NO_MSG(sub_id);
 	__ASSERT_NO_MSG(report_max > 0);
 
+	input_report_idx_init();
+
 	struct hid_reportq *q = reportq_find_free();
 
 	if (!q) {
@@ -180,19 +213,17 @@ const void *hid_reportq_get_sub_id(struct hid_reportq *q)
 
 static uint8_t get_input_report_idx(uint8_t rep_id)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(input_reports); i++) {
-		__ASSERT_NO_MSG(i <= UINT8_MAX);
+	uint8_t rep_idx = (rep_id < ARRAY_SIZE(input_report_idx)) ?
+			  input_report_idx[rep_id] : UINT8_MAX;
 
-		if (input_reports[i] == rep_id) {
-			return i;
-		}
-	}
+	if (rep_idx >= ARRAY_SIZE(input_reports)) {
+		/* Should not happen. */
+		__ASSERT_NO_MSG(false);
 
-	/* Should not happen. */
-	__ASSERT_NO_MSG(false);
+		return ARRAY_SIZE(input_reports);
+	}
 
-	BUILD_ASSERT(ARRAY_SIZE(input_reports) <= UINT8_MAX);
-	return ARRAY_SIZE(input_reports);
+	return rep_idx;
 }
 
 int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t rep_id,
@@ -203,7 +234,7 @@ int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t re
 
 	uint8_t rep_idx = get_input_report_idx(rep_id);
 
-	if (!hid_reportq_is_subscribed(q, rep_id)) {
+	if (!(q->enabled_report_idx_bm & BIT(rep_idx))) {
 		return -EACCES;
 	}
 
@@ -223,6 +223,7 @@ static size_t raw_rx_handler(const uint8_t *buf, const size_t len)
 	k_mutex_lock(&mutex_data, K_FOREVER);
 
 	const char *const quit_str = CONFIG_SLM_DATAMODE_TERMINATOR;
+	const size_t quit_str_len = sizeof(CONFIG_SLM_DATAMODE_TERMINATOR) - 1;
 	size_t processed;
 	bool quit_str_match = false;
 	uint8_t quit_str_match_count = quit_str_partial_match;
@@ -231,9 +232,21 @@ static size_t raw_rx_handler(const uint8_t *buf, const size_t len)
 
 	/* Find quit_str or partial match at the end of the buffer. */
 	for (processed = 0; processed < len && quit_str_match == false; processed++) {
+		if (quit_str_match_count == 0) {
+			/* Outside of a possible quit_str, only its first character matters.
+			 * Skip the data before it at once instead of byte by byte.
+			 */
+			const uint8_t *next = memchr(&buf[processed], quit_str[0], len - processed);
+
+			if (next == NULL) {
+				processed = len;
+				break;
+			}
+			processed = next - buf;
+		}
 		if (buf[processed] == quit_str[quit_str_match_count]) {
 			quit_str_match_count++;
-			if (quit_str_match_count == strlen(quit_str)) {
+			if (quit_str_match_count == quit_str_len) {
 				quit_str_match = true;
 			}
 		} else if (quit_str_match_count > 0) {
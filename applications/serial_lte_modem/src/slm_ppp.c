@@ -574,6 +574,42 @@ static int handle_at_ppp(enum at_parser_cmd_type cmd_type, struct at_parser *par
 	return -SILENT_AT_COMMAND_RET;
 }
 
+/* Forwards the packets that are available on the source socket to the other socket.
+ * Up to CONFIG_SLM_PPP_DATA_BATCH_COUNT packets are forwarded per poll wakeup.
+ */
+static void ppp_data_forward(const struct zsock_pollfd *fds, size_t src, size_t mtu)
+{
+	const size_t dst = (src == ZEPHYR_FD_IDX) ? MODEM_FD_IDX : ZEPHYR_FD_IDX;
+	void *dst_addr = (dst == MODEM_FD_IDX) ? NULL : &ppp_zephyr_dst_addr;
+	socklen_t addrlen = (dst == MODEM_FD_IDX) ? 0 : sizeof(ppp_zephyr_dst_addr);
+
+	for (unsigned int i = 0; i != CONFIG_SLM_PPP_DATA_BATCH_COUNT; ++i) {
+		const ssize_t len =
+			zsock_recv(fds[src].fd, ppp_data_buf, mtu, ZSOCK_MSG_DONTWAIT);
+
+		if (len <= 0) {
+			if (len != -1 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+				LOG_ERR("Failed to receive data from %s socket (%d, %d).",
+					ppp_socket_names[src], len, errno);
+			}
+			return;
+		}
+		ssize_t send_ret;
+
+		send_ret = zsock_sendto(fds[dst].fd, ppp_data_buf, len, 0, dst_addr, addrlen);
+		if (send_ret == -1) {
+			LOG_ERR("Failed to send %zd bytes to %s socket (%d).",
+				len, ppp_socket_names[dst], errno);
+		} else if (send_ret != len) {
+			LOG_ERR("Only sent %zd out of %zd bytes to %s socket.",
+				send_ret, len, ppp_socket_names[dst]);
+		} else {
+			LOG_DBG("Forwarded %zd bytes to %s socket.",
+				send_ret, ppp_socket_names[dst]);
+		}
+	}
+}
+
 static void ppp_data_passing_thread(void*, void*, void*)
 {
 	const size_t mtu = net_if_get_mtu(ppp_iface);
@@ -610,33 +646,7 @@ static void ppp_data_passing_thread(void*, void*, void*)
 				ppp_stop();
 				return;
 			}
-			const ssize_t len =
-				zsock_recv(fds[src].fd, ppp_data_buf, mtu, ZSOCK_MSG_DONTWAIT);
-
-			if (len <= 0) {
-				if (len != -1 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-					LOG_ERR("Failed to receive data from %s socket (%d, %d).",
-						ppp_socket_names[src], len, errno);
-				}
-				continue;
-			}
-			ssize_t send_ret;
-			const size_t dst = (src == ZEPHYR_FD_IDX) ? MODEM_FD_IDX : ZEPHYR_FD_IDX;
-			void *dst_addr = (dst == MODEM_FD_IDX) ? NULL : &ppp_zephyr_dst_addr;
-			socklen_t addrlen = (dst == MODEM_FD_IDX) ? 0 : sizeof(ppp_zephyr_dst_addr);
-
-			send_ret =
-				zsock_sendto(fds[dst].fd, ppp_data_buf, len, 0, dst_addr, addrlen);
-			if (send_ret == -1) {
-				LOG_ERR("Failed to send %zd bytes to %s socket (%d).",
-					len, ppp_socket_names[dst], errno);
-			} else if (send_ret != len) {
-				LOG_ERR("Only sent %zd out of %zd bytes to %s socket.",
-					send_ret, len, ppp_socket_names[dst]);
-			} else {
-				LOG_DBG("Forwarded %zd bytes to %s socket.",
-					send_ret, ppp_socket_names[dst]);
-			}
+			ppp_data_forward(fds, src, mtu);
 		}
 	}
 }
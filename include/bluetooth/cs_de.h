@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_CS_DE_H_
+#define BT_CS_DE_H_
+
+/**
+ * @file
+ * @defgroup bt_cs_de Channel Sounding distance estimation
+ * @{
+ * @brief API for estimating the distance from Channel Sounding step data.
+ *
+ * The estimators use integer arithmetic only. The step data of one procedure is
+ * first collected into a report, indexed by channel and antenna path, and the
+ * distance is then calculated with every enabled method.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/cs.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of Channel Sounding channel indices. Channel index k is at 2402 + k MHz. */
+#define CS_DE_NUM_CHANNELS 79
+
+/** Distance value used when a method could not produce an estimate. */
+#define CS_DE_DISTANCE_INVALID (-1)
+
+/** @brief Quality of the distance estimates of a procedure. */
+enum cs_de_quality {
+	/** At least one method produced an estimate. */
+	CS_DE_QUALITY_OK,
+	/** No method produced an estimate. */
+	CS_DE_QUALITY_DO_NOT_USE,
+};
+
+/** @brief Distance estimates in millimeters.
+ *
+ *  Every field is set to @ref CS_DE_DISTANCE_INVALID if the related method could
+ *  not produce an estimate.
+ */
+struct cs_de_dist_estimates {
+	/** Estimate based on the slope of the phase over the channel frequencies. */
+	int32_t phase_slope;
+	/** Estimate based on the first path in the channel impulse response. */
+	int32_t ifft;
+	/** Estimate based on the round-trip time of the mode 1 and mode 3 packets. */
+	int32_t rtt;
+};
+
+/** @brief Complex value with integer components. */
+struct cs_de_iq {
+	int32_t i;
+	int32_t q;
+};
+
+/** @brief Step data and distance estimates of a single procedure. */
+struct cs_de_report {
+	/** Number of antenna paths. */
+	uint8_t n_ap;
+	/** Channel Sounding role of the local device. */
+	enum bt_conn_le_cs_role role;
+	/** Sum of the products of the local and peer IQ samples for each channel. */
+	struct cs_de_iq iq[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS][CS_DE_NUM_CHANNELS];
+	/** Bitmap of the channels with a valid IQ sample for each antenna path. */
+	uint32_t iq_valid[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS]
+			 [DIV_ROUND_UP(CS_DE_NUM_CHANNELS, 32)];
+	/** Number of valid tones for each antenna path. */
+	uint16_t tone_count[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS];
+	/** Sum of the round-trip time differences, in units of 0.5 ns. */
+	int32_t rtt_sum;
+	/** Number of valid round-trip time samples. */
+	uint16_t rtt_count;
+	/** Distance estimates for each antenna path. The RTT estimate is not per path. */
+	struct cs_de_dist_estimates path_estimates[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS];
+	/** Distance estimates aggregated over all antenna paths. */
+	struct cs_de_dist_estimates estimates;
+};
+
+/** @brief Filter of successive distance estimates.
+ *
+ *  The filter takes the median of the last @kconfig{CONFIG_BT_CS_DE_FILTER_WINDOW}
+ *  estimates to reject outliers, and smooths the median with an exponential moving
+ *  average.
+ */
+struct cs_de_filter {
+	/** Last estimates, in millimeters. */
+	int32_t window[CONFIG_BT_CS_DE_FILTER_WINDOW];
+	/** Number of estimates in the window. */
+	uint8_t count;
+	/** Position of the next estimate in the window. */
+	uint8_t next;
+	/** Smoothed distance, in 1/256 millimeters. */
+	int64_t smoothed;
+};
+
+/** @brief Initialize a report before adding the step data of a procedure.
+ *
+ *  @param[out] report Report to initialize.
+ *  @param[in]  n_ap   Number of antenna paths used in the procedure.
+ *  @param[in]  role   Channel Sounding role of the local device.
+ */
+void cs_de_report_init(struct cs_de_report *report, uint8_t n_ap, enum bt_conn_le_cs_role role);
+
+/** @brief Add the data of a single step to a report.
+ *
+ *  The function can be used as the step data callback of any parser of the
+ *  Channel Sounding step data, for example, of the Ranging Service data.
+ *
+ *  @param[in,out] report     Report to add the step data to.
+ *  @param[in]     local_step Local step data.
+ *  @param[in]     peer_step  Peer step data of the same step.
+ */
+void cs_de_report_add_step(struct cs_de_report *report,
+			   const struct bt_le_cs_subevent_step *local_step,
+			   const struct bt_le_cs_subevent_step *peer_step);
+
+#if defined(CONFIG_BT_RAS_RREQ) || defined(__DOXYGEN__)
+/** @brief Populate a report with the local step data and the peer ranging data.
+ *
+ *  @note All data is removed from the buffers in this function.
+ *
+ *  @param[in,out] local_steps Local step data, as received in the subevent results.
+ *  @param[in,out] peer_steps  Peer ranging data, as received from the Ranging Responder.
+ *  @param[in]     n_ap        Number of antenna paths used in the procedure.
+ *  @param[in]     role        Channel Sounding role of the local device.
+ *  @param[out]    report      Report to populate.
+ */
+void cs_de_populate_report(struct net_buf_simple *local_steps,
+			   struct net_buf_simple *peer_steps, uint8_t n_ap,
+			   enum bt_conn_le_cs_role role, struct cs_de_report *report);
+#endif
+
+/** @brief Calculate the distance estimates of a report.
+ *
+ *  The function is not reentrant.
+ *
+ *  @param[in,out] report Populated report. The estimates are stored in it.
+ *
+ *  @return Quality of the estimates.
+ */
+enum cs_de_quality cs_de_calc(struct cs_de_report *report);
+
+/** @brief Initialize a filter of distance estimates.
+ *
+ *  @param[out] filter Filter to initialize.
+ */
+void cs_de_filter_init(struct cs_de_filter *filter);
+
+/** @brief Add a distance estimate to a filter.
+ *
+ *  @param[in,out] filter   Filter.
+ *  @param[in]     distance Distance estimate in millimeters. Invalid estimates are ignored.
+ *
+ *  @return Filtered distance in millimeters, or @ref CS_DE_DISTANCE_INVALID if no valid
+ *          estimate was added yet.
+ */
+int32_t cs_de_filter_update(struct cs_de_filter *filter, int32_t distance);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* BT_CS_DE_H_ */
@@ -79,6 +79,17 @@ struct bt_nus_cb {
 	 */
 	void (*send_enabled)(enum bt_nus_send_status status);
 
+	/** @brief Stream data sent callback.
+	 *
+	 * A notification with data written using @ref bt_nus_stream_write
+	 * has been sent. The stream buffer has free space for at least
+	 * @p len bytes.
+	 *
+	 * @param[in] conn Pointer to connection object.
+	 * @param[in] len  Number of stream bytes sent in the notification.
+	 */
+	void (*stream_sent)(struct bt_conn *conn, size_t len);
+
 };
 
 /**@brief Initialize the service.
@@ -113,6 +124,28 @@ int bt_nus_init(struct bt_nus_cb *callbacks);
  */
 int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len);
 
+/**@brief Write data to the stream of a connection.
+ * @details This function copies as much data as fits into the stream
+ *          buffer of the connection and sends it as notifications. Up to
+ *          CONFIG_BT_NUS_STREAM_TX_IN_FLIGHT_MAX notifications are kept
+ *          queued at the same time. The data that is not accepted is not
+ *          buffered, so the application must write it again after the
+ *          @ref bt_nus_cb.stream_sent callback. The buffered data is
+ *          dropped only if the peer disconnects or disables notifications.
+ * @param[in] conn Pointer to connection object.
+ * @param[in] data Pointer to a data buffer.
+ * @param[in] len  Length of the data in the buffer.
+ * @return Number of bytes accepted if the operation was successful.
+ *         Otherwise, a (negative) error code is returned.
+ */
+int bt_nus_stream_write(struct bt_conn *conn, const uint8_t *data, size_t len);
+
+/**@brief Get free space in the stream buffer of a connection.
+ * @param[in] conn Pointer to connection object.
+ * @return Number of bytes that @ref bt_nus_stream_write can accept.
+ */
+size_t bt_nus_stream_space_get(struct bt_conn *conn);
+
 /**@brief Get maximum data length that can be used for @ref bt_nus_send.
  *
  * @param[in] conn Pointer to connection Object.
@@ -190,6 +190,22 @@ struct bt_ras_rd_buffer_cb {
 	sys_snode_t node;
 };
 
+/** @brief RAS Ranging Data buffer statistics. */
+struct bt_ras_rd_buffer_stats {
+	/** Number of procedures stored and ready to be sent. */
+	uint32_t procedures_stored;
+	/** Number of stored procedures overwritten before the peer acknowledged them. */
+	uint32_t procedures_overwritten;
+	/** Number of procedures dropped, because they were aborted or did not fit in a buffer. */
+	uint32_t procedures_dropped;
+	/** Number of procedures dropped, because no buffer could be allocated. */
+	uint32_t alloc_failures;
+	/** Number of buffers taken over from other connections. */
+	uint32_t buffers_reclaimed;
+	/** Number of ranging data bytes stored. */
+	uint32_t bytes_stored;
+};
+
 /** @brief RAS Ranging Data buffer structure.
  *
  *  Provides storage and metadata to store a complete Ranging Data body
@@ -217,6 +233,10 @@ struct ras_rd_buffer {
 	bool busy;
 	/** The peer has ACKed this buffer, the overwritten callback will not be called. */
 	bool acked;
+	/** Room for the segmentation header of the first segment. This allows sending
+	 *  every segment straight from the procedure buffer.
+	 */
+	uint8_t segment_headroom;
 	/** Complete ranging data procedure buffer. */
 	union {
 		uint8_t buf[BT_RAS_PROCEDURE_MEM];
@@ -298,6 +318,12 @@ struct ras_rd_buffer *bt_ras_rd_buffer_claim(struct bt_conn *conn, uint16_t rang
  */
 int bt_ras_rd_buffer_release(struct ras_rd_buffer *buf);
 
+/** @brief Get ranging data buffer statistics.
+ *
+ *  @param[out] stats Statistics.
+ */
+void bt_ras_rd_buffer_stats_get(struct bt_ras_rd_buffer_stats *stats);
+
 /** @brief Pull bytes from a ranging data buffer.
  *
  *  Utility method to consume up to max_data_len bytes from a buffer.
@@ -148,6 +148,39 @@ struct dm_request {
 	uint32_t extra_window_time_us;
 };
 
+/** @brief Distance Measurement statistics. */
+struct dm_stats {
+	/** Number of successful rangings. */
+	uint32_t measurements;
+
+	/** Number of failed or skipped rangings. */
+	uint32_t failures;
+
+	/** Number of timeslots used for ranging. */
+	uint32_t timeslots;
+
+	/** Number of rangings that shared a timeslot with a previous ranging. */
+	uint32_t batched;
+
+	/** Number of scheduled rangings whose timeslot was given to a peer that waited longer. */
+	uint32_t evicted;
+
+	/** Total length of the timeslots, in microseconds. */
+	uint64_t timeslot_us;
+
+	/** Time spent ranging within the timeslots, in microseconds. */
+	uint64_t ranging_us;
+
+	/** Time since the statistics were reset, in milliseconds. */
+	uint32_t period_ms;
+
+	/** Successful rangings per minute since the statistics were reset. */
+	uint32_t rate;
+
+	/** Time spent ranging as a percentage of the total length of the timeslots. */
+	uint8_t utilization;
+};
+
 /** @brief Initialize the DM.
  *
  *  Initialize the DM by specifying a list of supported operations.
@@ -170,6 +203,21 @@ int dm_init(struct dm_init_param *init_param);
  */
 int dm_request_add(struct dm_request *req);
 
+/** @brief Get the ranging statistics.
+ *
+ *  The statistics are collected since the start of the system or the last call to
+ *  @ref dm_stats_reset. They are not available when the DM is used over RPC.
+ *
+ *  @param[out] stats Address of the structure to store the statistics in.
+ *
+ *  @retval 0 if the operation was successful.
+ *          Otherwise, a (negative) error code is returned.
+ */
+int dm_stats_get(struct dm_stats *stats);
+
+/** @brief Reset the ranging statistics. */
+void dm_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
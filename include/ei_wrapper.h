@@ -58,6 +58,18 @@ size_t ei_wrapper_get_frame_size(void);
 size_t ei_wrapper_get_window_size(void);
 
 
+/** Get the size of the input data processed by a single prediction.
+ *
+ * If @kconfig{CONFIG_EI_WRAPPER_CONTINUOUS} is enabled, every prediction
+ * processes a slice of the input window. Otherwise, the slice size equals
+ * the input window size.
+ *
+ * @return Size of the input slice, expressed as a number of floating-point
+ *         values.
+ */
+size_t ei_wrapper_get_slice_size(void);
+
+
 /** Get input data sampling frequency of the classifier.
  *
  * @return The sampling frequency in Hz.
@@ -118,6 +130,11 @@ int ei_wrapper_clear_data(bool *cancelled);
  * If there is not enough data in the input buffer, the prediction start is
  * delayed until the missing data is added.
  *
+ * If @kconfig{CONFIG_EI_WRAPPER_CONTINUOUS} is enabled, the classifier reuses
+ * the features computed for the previous slices only if the input is shifted
+ * by exactly one slice (see @ref ei_wrapper_get_slice_size). For other shift
+ * values, the classifier state is reset before the prediction.
+ *
  * @param[in] window_shift  Number of windows the input window is shifted before
  *                          prediction.
  * @param[in] frame_shift   Number of frames the input window is shifted before
@@ -103,6 +103,22 @@ int nrf_modem_lib_trace_read(uint8_t *buf, size_t len);
  */
 int nrf_modem_lib_trace_clear(void);
 
+/**
+ * @brief Discard captured trace data older than the given uptime
+ *
+ * Drop trace data captured before @p uptime_ms, so that subsequent reads return the traces
+ * of a given time window without reading out the older traces first. Depending on the
+ * backend, some trace data older than @p uptime_ms may be kept.
+ *
+ * @note This operation is only supported with some trace backends. If not supported, the function
+ *       returns -ENOTSUP.
+ *
+ * @param uptime_ms System uptime, in milliseconds, as returned by @c k_uptime_get.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int nrf_modem_lib_trace_discard_before(int64_t uptime_ms);
+
 #if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) || defined(__DOXYGEN__)
 /** @brief Get the last measured rolling average bitrate of the trace backend.
  *
@@ -114,6 +130,35 @@ int nrf_modem_lib_trace_clear(void);
 uint32_t nrf_modem_lib_trace_backend_bitrate_get(void);
 #endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) || defined(__DOXYGEN__) */
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_STATS) || defined(__DOXYGEN__)
+/** @brief Trace statistics */
+struct nrf_modem_lib_trace_stats {
+	/** Number of trace bytes received from the modem. */
+	uint32_t bytes_received;
+	/** Number of trace bytes written to the trace backend. */
+	uint32_t bytes_written;
+	/** Number of trace bytes dropped because the trace backend failed. */
+	uint32_t bytes_lost;
+	/** Time the trace thread was stalled waiting for backend space or trace level, in ms. */
+	uint32_t stall_time_ms;
+	/** Number of times the trace level was lowered because the backend could not keep up. */
+	uint32_t level_downgrades;
+	/** Number of times the trace level was restored because the backend caught up. */
+	uint32_t level_restores;
+};
+
+/** @brief Get trace statistics.
+ *
+ * @param stats Statistics since boot or the last call to @ref nrf_modem_lib_trace_stats_reset.
+ *
+ * @return 0 on success, negative errno on failure.
+ */
+int nrf_modem_lib_trace_stats_get(struct nrf_modem_lib_trace_stats *stats);
+
+/** @brief Reset trace statistics. */
+void nrf_modem_lib_trace_stats_reset(void);
+#endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_STATS) || defined(__DOXYGEN__) */
+
 /** @} */
 
 #ifdef __cplusplus
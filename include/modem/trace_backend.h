@@ -103,6 +103,21 @@ struct nrf_modem_lib_trace_backend {
 	 */
 	int (*clear)(void);
 
+	/**
+	 * @brief Discard trace data captured before the given uptime.
+	 *
+	 * Drop stored trace data that is older than @p uptime_ms so that the next read starts
+	 * close to the requested point in time. The backend may keep some older data, but never
+	 * discards data captured at or after @p uptime_ms.
+	 *
+	 * @note Set to @c NULL if this operation is not supported by the trace backend.
+	 *
+	 * @param uptime_ms System uptime, in milliseconds.
+	 *
+	 * @return 0 on success, negative errno on failure.
+	 */
+	int (*discard_before)(int64_t uptime_ms);
+
 	/**
 	 * @brief Suspend trace backend.
 	 *
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_BATCH_H_
+#define NRF_CLOUD_BATCH_H_
+
+/** @file nrf_cloud_batch.h
+ * @brief Module to batch device messages before sending them to nRF Cloud.
+ */
+
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud_codec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup nrf_cloud_batch nRF Cloud Batch
+ * @{
+ */
+
+/**
+ * @brief Callback used to transmit a batch.
+ *
+ * @param[in] buf NULL-terminated JSON array of device messages.
+ * @param[in] len Length of the JSON array, excluding the NULL terminator.
+ *
+ * @return 0 if the batch was sent, otherwise a negative error number.
+ *         If the error is -ENOTCONN or -EACCES (not connected), the batch is kept
+ *         and sent again on the next flush. Otherwise, the batch is discarded.
+ */
+typedef int (*nrf_cloud_batch_send_cb_t)(const char *buf, size_t len);
+
+/** @brief Batching statistics */
+struct nrf_cloud_batch_stats {
+	/** Number of messages added to the batch. */
+	uint32_t msgs_added;
+	/** Number of messages successfully sent. */
+	uint32_t msgs_sent;
+	/** Number of messages dropped because a batch could not be sent due to a permanent error. */
+	uint32_t msgs_dropped;
+	/** Number of encoded message bytes added to the batch. */
+	uint32_t bytes_added;
+	/** Number of bytes (before transport encryption) successfully sent. */
+	uint32_t bytes_sent;
+	/** Number of transmissions, each of which wakes the radio. */
+	uint32_t flushes;
+	/** Number of flushes caused by the batch buffer filling up. */
+	uint32_t flushes_size;
+	/** Number of flushes caused by the oldest message reaching its maximum age. */
+	uint32_t flushes_age;
+};
+
+/**
+ * @brief Initialize the batching module.
+ *
+ * @param[in] send_cb Callback used to transmit a batch. If NULL, the batch is sent
+ *                    to the d2c/bulk topic using the enabled nRF Cloud transport
+ *                    (MQTT or CoAP).
+ *
+ * @retval 0 Success.
+ * @retval -EALREADY Already initialized.
+ */
+int nrf_cloud_batch_init(nrf_cloud_batch_send_cb_t send_cb);
+
+/**
+ * @brief Add a device message to the current batch.
+ *
+ * @details The message is encoded immediately and freed on success.
+ *          If the message does not fit into the remaining space, the current
+ *          batch is flushed first. The batch is also flushed once its size exceeds
+ *          @kconfig{CONFIG_NRF_CLOUD_BATCH_FLUSH_THRESHOLD} percent of the buffer, or
+ *          @kconfig{CONFIG_NRF_CLOUD_BATCH_MAX_AGE_SEC} seconds after its first message
+ *          was added.
+ *
+ * @param[in,out] obj Message object of type @ref NRF_CLOUD_OBJ_TYPE_JSON,
+ *                    for example, created with @ref nrf_cloud_obj_msg_init.
+ *
+ * @retval 0 Success; message added and object freed.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOTSUP Object type is not supported.
+ * @retval -E2BIG Encoded message is larger than the batch buffer.
+ * @retval -ENOMEM Batch buffer is full and cannot be sent because there is no connection.
+ * @retval -EACCES Module not initialized.
+ * @return A negative value indicates an error.
+ */
+int nrf_cloud_batch_add(struct nrf_cloud_obj *const obj);
+
+/**
+ * @brief Send the current batch immediately.
+ *
+ * @details Call this when the connection to nRF Cloud becomes available, or when
+ *          the radio is already active for another reason, to piggyback the batch
+ *          on that activity.
+ *
+ * @retval 0 Success, or nothing to send.
+ * @retval -EACCES Module not initialized, or not connected to nRF Cloud.
+ * @retval -ENOTCONN Not connected to nRF Cloud; the batch is kept.
+ * @return A negative value indicates an error reported by the send callback.
+ */
+int nrf_cloud_batch_flush(void);
+
+/**
+ * @brief Get the number of messages in the current batch.
+ *
+ * @return Number of pending messages.
+ */
+int nrf_cloud_batch_pending_get(void);
+
+/**
+ * @brief Get batching statistics.
+ *
+ * @param[out] stats Statistics.
+ */
+void nrf_cloud_batch_stats_get(struct nrf_cloud_batch_stats *stats);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_BATCH_H_ */
@@ -33,6 +33,15 @@ BUILD_ASSERT(CONFIG_EI_WRAPPER_THREAD_STACK_SIZE > 0);
 #define THREAD_PRIORITY 	CONFIG_EI_WRAPPER_THREAD_PRIORITY
 #define DEBUG_MODE		IS_ENABLED(CONFIG_EI_WRAPPER_DEBUG_MODE)
 
+#ifdef CONFIG_EI_WRAPPER_CONTINUOUS
+#define SLICE_COUNT		EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW
+#else
+#define SLICE_COUNT		1
+#endif
+
+/* Number of input values processed by a single prediction. */
+#define INPUT_SLICE_SIZE	(INPUT_WINDOW_SIZE / SLICE_COUNT)
+
 enum state {
 	STATE_DISABLED,
 	STATE_WAITING_FOR_DATA,
@@ -59,10 +68,13 @@ static struct data_buffer ei_input;
 static ei_impulse_result_t ei_result;
 static int cur_res_idx;
 static ei_wrapper_result_ready_cb user_cb;
+static atomic_t continuous_restart = ATOMIC_INIT(true);
 
 
 BUILD_ASSERT(DATA_BUFFER_SIZE > INPUT_WINDOW_SIZE);
 BUILD_ASSERT(INPUT_WINDOW_SIZE % INPUT_FRAME_SIZE == 0);
+BUILD_ASSERT(INPUT_WINDOW_SIZE % SLICE_COUNT == 0);
+BUILD_ASSERT(INPUT_SLICE_SIZE % INPUT_FRAME_SIZE == 0);
 
 
 static size_t buf_get_collected_data_count(const struct data_buffer *b)
@@ -78,7 +90,7 @@ static size_t buf_calc_free_space(const struct data_buffer *b)
 {
 	if (b->wait_data_size > 0) {
 		return b->wait_data_size + ARRAY_SIZE(b->buf) -
-		       INPUT_WINDOW_SIZE - 1;
+		       INPUT_SLICE_SIZE - 1;
 	}
 
 	return ARRAY_SIZE(b->buf) - buf_get_collected_data_count(b) - 1;
@@ -170,7 +182,7 @@ static int buf_append(struct data_buffer *b, const float *data, size_t len,
 static void buf_get(const struct data_buffer *b, float *b_res, size_t offset,
 		    size_t len)
 {
-	__ASSERT_NO_MSG((offset + len) <= INPUT_WINDOW_SIZE);
+	__ASSERT_NO_MSG((offset + len) <= INPUT_SLICE_SIZE);
 
 	/* Processing index cannot change while processing is done. */
 	__ASSERT_NO_MSG(b->state == STATE_PROCESSING);
@@ -215,7 +227,7 @@ static int buf_processing_move(struct data_buffer *b, size_t move,
 		b->process_idx -= ARRAY_SIZE(b->buf);
 	}
 
-	size_t processing_end_move = move + INPUT_WINDOW_SIZE;
+	size_t processing_end_move = move + INPUT_SLICE_SIZE;
 
 	if (processing_end_move > max_move) {
 		b->wait_data_size = processing_end_move - max_move;
@@ -244,6 +256,11 @@ size_t ei_wrapper_get_window_size(void)
 	return INPUT_WINDOW_SIZE;
 }
 
+size_t ei_wrapper_get_slice_size(void)
+{
+	return INPUT_SLICE_SIZE;
+}
+
 size_t ei_wrapper_get_classifier_frequency(void)
 {
 	return INPUT_FREQUENCY;
@@ -283,7 +300,13 @@ int ei_wrapper_add_data(const float *data, size_t data_size)
 
 int ei_wrapper_clear_data(bool *cancelled)
 {
-	return buf_cleanup(&ei_input, cancelled);
+	int err = buf_cleanup(&ei_input, cancelled);
+
+	if (!err) {
+		atomic_set(&continuous_restart, true);
+	}
+
+	return err;
 }
 
 int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
@@ -294,8 +317,17 @@ int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
 	bool process_buf;
 	int err = buf_processing_move(&ei_input, sample_shift, &process_buf);
 
-	if (!err && process_buf) {
-		k_sem_give(&ei_sem);
+	if (!err) {
+		/* In continuous mode, the classifier reuses features of the previous slices only
+		 * if the subsequent slices are processed one after another.
+		 */
+		if (sample_shift != INPUT_SLICE_SIZE) {
+			atomic_set(&continuous_restart, true);
+		}
+
+		if (process_buf) {
+			k_sem_give(&ei_sem);
+		}
 	}
 
 	return err;
@@ -317,6 +349,20 @@ static void processing_finished(int err)
 	user_cb(err);
 }
 
+static EI_IMPULSE_ERROR classify(signal_t *signal)
+{
+#ifdef CONFIG_EI_WRAPPER_CONTINUOUS
+	if (atomic_clear(&continuous_restart)) {
+		/* Drop features computed for the previous slices. */
+		run_classifier_init();
+	}
+
+	return run_classifier_continuous(signal, &ei_result, DEBUG_MODE, false);
+#else
+	return run_classifier(signal, &ei_result, DEBUG_MODE);
+#endif /* CONFIG_EI_WRAPPER_CONTINUOUS */
+}
+
 static void edge_impulse_thread_fn(void)
 {
 	signal_t features_signal;
@@ -326,15 +372,15 @@ static void edge_impulse_thread_fn(void)
 		k_sem_take(&ei_sem, K_FOREVER);
 
 		features_signal.get_data = &raw_feature_get_data;
-		features_signal.total_length = INPUT_WINDOW_SIZE;
+		features_signal.total_length = INPUT_SLICE_SIZE;
 
 		if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
 			start_time = k_uptime_get();
 		}
 
 		/* Invoke the impulse. */
-		EI_IMPULSE_ERROR err = run_classifier(&features_signal,
-						      &ei_result, DEBUG_MODE);
+		EI_IMPULSE_ERROR err = classify(&features_signal);
+
 		if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
 			int64_t delta = k_uptime_delta(&start_time);
 
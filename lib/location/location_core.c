@@ -356,6 +356,43 @@ static void location_core_current_config_set(const struct location_config *confi
 	memcpy(&loc_req_info.config, config, sizeof(loc_req_info.config));
 }
 
+#if defined(CONFIG_LOCATION_METHOD_WIFI_SCAN_DURING_GNSS)
+/**
+ * Start Wi-Fi scan in parallel with GNSS if Wi-Fi is the next method in fallback mode,
+ * so that the scan results are ready if GNSS fails.
+ */
+static void location_core_parallel_scan_start(void)
+{
+	int next_index = loc_req_info.current_method_index + 1;
+	enum location_method next_method;
+
+	if (loc_req_info.config.mode != LOCATION_REQ_MODE_FALLBACK ||
+	    loc_req_info.current_method != LOCATION_METHOD_GNSS ||
+	    loc_req_info.wifi == NULL ||
+	    next_index >= loc_req_info.methods_count) {
+		return;
+	}
+
+	next_method = loc_req_info.methods[next_index];
+	if (next_method == LOCATION_METHOD_WIFI || next_method == LOCATION_METHOD_WIFI_CELLULAR) {
+		method_cloud_location_wifi_prescan_start(loc_req_info.wifi);
+	}
+}
+
+static void location_core_parallel_scan_cancel(void)
+{
+	method_cloud_location_wifi_prescan_cancel();
+}
+#else
+static void location_core_parallel_scan_start(void)
+{
+}
+
+static void location_core_parallel_scan_cancel(void)
+{
+}
+#endif
+
 static int location_core_location_get_pos(void)
 {
 	int err;
@@ -377,6 +414,8 @@ static int location_core_location_get_pos(void)
 		return err;
 	}
 
+	location_core_parallel_scan_start();
+
 	if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
 		struct location_event_data request_started = {
 			.id = LOCATION_EVT_STARTED,
@@ -751,6 +790,7 @@ static void location_core_event_cb_fn(struct k_work *work)
 	location_utils_event_dispatch(&loc_req_info.current_event_data);
 
 	k_work_cancel_delayable(&location_core_timeout_work);
+	location_core_parallel_scan_cancel();
 
 	if (loc_req_info.config.interval > 0) {
 		k_work_schedule_for_queue(
@@ -849,6 +889,7 @@ int location_core_cancel(void)
 	k_work_cancel_delayable(&location_core_timeout_work);
 	k_work_cancel_delayable(&location_periodic_work);
 	k_work_cancel(&location_event_cb_work);
+	location_core_parallel_scan_cancel();
 
 	/* Check if location has been requested using one of the methods */
 	if (current_method != 0) {
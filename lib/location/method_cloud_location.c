@@ -40,6 +40,70 @@ static bool running;
 static K_SEM_DEFINE(wifi_scan_ready, 0, 1);
 #endif
 
+#if defined(CONFIG_LOCATION_METHOD_WIFI_SCAN_DURING_GNSS)
+/**
+ * Whether a Wi-Fi scan was started in parallel with a preceding method.
+ * Cleared by either the positioning work or a cancellation, which run in different contexts.
+ */
+static atomic_t wifi_prescan_started;
+/** Uptime when the parallel Wi-Fi scan was started. */
+static int64_t wifi_prescan_start_uptime;
+
+/** Take over the parallel Wi-Fi scan, if one is ongoing. */
+static bool method_cloud_location_wifi_prescan_take(void)
+{
+	return atomic_cas(&wifi_prescan_started, true, false);
+}
+
+static void method_cloud_location_wifi_prescan_wait(const struct location_wifi_config *wifi_config)
+{
+	int64_t remaining;
+
+	if (wifi_config->timeout == SYS_FOREVER_MS) {
+		k_sem_take(&wifi_scan_ready, K_FOREVER);
+		return;
+	}
+
+	/* The Wi-Fi timeout is counted from the start of the parallel scan.
+	 * If the scan has already timed out, the results gathered so far are used.
+	 */
+	remaining = wifi_prescan_start_uptime + wifi_config->timeout - k_uptime_get();
+	if (k_sem_take(&wifi_scan_ready, remaining > 0 ? K_MSEC(remaining) : K_NO_WAIT)) {
+		scan_wifi_cancel();
+	}
+}
+
+void method_cloud_location_wifi_prescan_start(const struct location_wifi_config *wifi_config)
+{
+	__ASSERT_NO_MSG(wifi_config != NULL);
+
+	LOG_DBG("Starting Wi-Fi scan in parallel with GNSS");
+
+	k_sem_reset(&wifi_scan_ready);
+	wifi_prescan_start_uptime = k_uptime_get();
+	atomic_set(&wifi_prescan_started, true);
+	scan_wifi_execute(wifi_config->timeout, &wifi_scan_ready);
+}
+
+void method_cloud_location_wifi_prescan_cancel(void)
+{
+	if (atomic_cas(&wifi_prescan_started, true, false)) {
+		LOG_DBG("Discarding parallel Wi-Fi scan");
+		scan_wifi_cancel();
+	}
+}
+#elif defined(CONFIG_LOCATION_METHOD_WIFI)
+static bool method_cloud_location_wifi_prescan_take(void)
+{
+	return false;
+}
+
+static void method_cloud_location_wifi_prescan_wait(const struct location_wifi_config *wifi_config)
+{
+	ARG_UNUSED(wifi_config);
+}
+#endif /* CONFIG_LOCATION_METHOD_WIFI_SCAN_DURING_GNSS */
+
 static void method_cloud_location_positioning_work_fn(struct k_work *work)
 {
 	struct method_cloud_location_start_work_args *work_data =
@@ -51,10 +115,20 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 	int err = 0;
 
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
-	k_sem_reset(&wifi_scan_ready);
+	bool wifi_prescan = method_cloud_location_wifi_prescan_take();
 
-	if (wifi_config != NULL) {
-		scan_wifi_execute(wifi_config->timeout, &wifi_scan_ready);
+	if (wifi_prescan) {
+		/* Wi-Fi scan was started in parallel with the previous method */
+		if (wifi_config == NULL) {
+			scan_wifi_cancel();
+			wifi_prescan = false;
+		}
+	} else {
+		k_sem_reset(&wifi_scan_ready);
+
+		if (wifi_config != NULL) {
+			scan_wifi_execute(wifi_config->timeout, &wifi_scan_ready);
+		}
 	}
 #endif
 
@@ -67,7 +141,11 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
 	if (wifi_config != NULL) {
-		k_sem_take(&wifi_scan_ready, K_FOREVER);
+		if (wifi_prescan) {
+			method_cloud_location_wifi_prescan_wait(wifi_config);
+		} else {
+			k_sem_take(&wifi_scan_ready, K_FOREVER);
+		}
 		scan_wifi_info = scan_wifi_results_get();
 	}
 #endif
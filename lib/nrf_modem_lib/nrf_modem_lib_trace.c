@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <modem/nrf_modem_lib.h>
 #include <modem/nrf_modem_lib_trace.h>
@@ -210,6 +212,169 @@ static void bps_log(struct k_work *item)
 #define UPDATE_TRACE_BYTES_READ(...)
 #endif
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_STATS
+static struct nrf_modem_lib_trace_stats trace_stats;
+
+static size_t frags_len(const struct nrf_modem_trace_data *frags, size_t n_frags)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < n_frags; i++) {
+		len += frags[i].len;
+	}
+
+	return len;
+}
+
+int nrf_modem_lib_trace_stats_get(struct nrf_modem_lib_trace_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	*stats = trace_stats;
+
+	return 0;
+}
+
+void nrf_modem_lib_trace_stats_reset(void)
+{
+	memset(&trace_stats, 0, sizeof(trace_stats));
+}
+
+#define STATS_ADD(field, val) (trace_stats.field += (val))
+#define STATS_ADD_FRAGS(field, frags, n_frags) STATS_ADD(field, frags_len(frags, n_frags))
+#else
+#define STATS_ADD(field, val) ARG_UNUSED(val)
+#define STATS_ADD_FRAGS(...)
+#endif
+
+/* Trace level currently set in the modem, -1 if unknown. */
+static int trace_level_current = -1;
+/* Last trace level set with nrf_modem_lib_trace_level_set(), -1 if unknown. */
+static int trace_level_user = -1;
+
+static int trace_level_apply(int tl);
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL
+#define ADAPTIVE_LEVEL_PERIOD_TICKS \
+	k_ms_to_ticks_ceil64(CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL_PERIOD_MS)
+
+static int64_t adaptive_period_start;
+static int64_t adaptive_busy_ticks;
+
+/* The AT command must not be sent from the trace thread, because the modem may be waiting for
+ * the trace thread to process traces before it can respond. It is not sent from the system
+ * workqueue either, to not block other work items while waiting for the modem.
+ */
+K_THREAD_STACK_DEFINE(adaptive_level_stack, CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL_STACK_SIZE);
+static struct k_work_q adaptive_level_work_q;
+
+static int trace_level_lower_get(int level)
+{
+	/* Levels ordered by decreasing amount of trace data */
+	switch (level) {
+	case NRF_MODEM_LIB_TRACE_LEVEL_FULL:
+		return NRF_MODEM_LIB_TRACE_LEVEL_LTE_AND_IP;
+	case NRF_MODEM_LIB_TRACE_LEVEL_LTE_AND_IP:
+		return NRF_MODEM_LIB_TRACE_LEVEL_IP_ONLY;
+	case NRF_MODEM_LIB_TRACE_LEVEL_IP_ONLY:
+		return NRF_MODEM_LIB_TRACE_LEVEL_COREDUMP_ONLY;
+	default:
+		/* Coredump only is never dropped, the trace level is not lowered further. */
+		return level;
+	}
+}
+
+static void trace_level_downgrade_handle(struct k_work *item)
+{
+	int level = trace_level_current;
+	int lower = trace_level_lower_get(level);
+	int err;
+
+	if (level < 0 || lower == level) {
+		return;
+	}
+
+	LOG_WRN("Trace backend cannot keep up, lowering trace level from %d to %d",
+		level, lower);
+
+	err = trace_level_apply(lower);
+	if (!err) {
+		STATS_ADD(level_downgrades, 1);
+	}
+}
+
+static void trace_level_restore_handle(struct k_work *item)
+{
+	int level = trace_level_user;
+	int err;
+
+	if (level < 0 || level == trace_level_current) {
+		return;
+	}
+
+	LOG_INF("Trace backend caught up, restoring trace level %d", level);
+
+	err = trace_level_apply(level);
+	if (!err) {
+		STATS_ADD(level_restores, 1);
+	}
+}
+
+K_WORK_DEFINE(trace_level_downgrade_work, trace_level_downgrade_handle);
+K_WORK_DEFINE(trace_level_restore_work, trace_level_restore_handle);
+
+/* When the trace thread spends most of its time writing to the backend, the backend is the
+ * bottleneck and the modem will soon stall or drop traces. Lower the trace level to reduce the
+ * incoming rate, and restore the level set by the application once the backend keeps up again.
+ */
+static void adaptive_level_update(int64_t write_ticks)
+{
+	int64_t now = k_uptime_ticks();
+	int64_t elapsed;
+
+	adaptive_busy_ticks += write_ticks;
+
+	elapsed = now - adaptive_period_start;
+	if (elapsed < ADAPTIVE_LEVEL_PERIOD_TICKS) {
+		return;
+	}
+
+	if (adaptive_busy_ticks * 100 >=
+	    elapsed * CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL_BUSY_PERCENT) {
+		k_work_submit_to_queue(&adaptive_level_work_q, &trace_level_downgrade_work);
+	} else if (trace_level_current != trace_level_user &&
+		   adaptive_busy_ticks * 100 <
+		   elapsed * CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL_RESTORE_PERCENT) {
+		k_work_submit_to_queue(&adaptive_level_work_q, &trace_level_restore_work);
+	}
+
+	adaptive_period_start = now;
+	adaptive_busy_ticks = 0;
+}
+
+static int adaptive_level_init(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "trace_level_work_q",
+	};
+
+	k_work_queue_start(&adaptive_level_work_q, adaptive_level_stack,
+			   K_THREAD_STACK_SIZEOF(adaptive_level_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(adaptive_level_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#else
+static void adaptive_level_update(int64_t write_ticks)
+{
+	ARG_UNUSED(write_ticks);
+}
+#endif
+
 int nrf_modem_lib_trace_processing_done_wait(k_timeout_t timeout)
 {
 	int err;
@@ -271,6 +436,8 @@ static int trace_fragment_write(struct nrf_modem_trace_data *frag)
 			return ret;
 		}
 
+		STATS_ADD(bytes_written, ret);
+
 		/* Alter trace fragment to contain what is not written */
 		frag->data = (void *)((uint8_t *)frag->data + ret);
 		frag->len -= ret;
@@ -284,6 +451,8 @@ void trace_thread_handler(void)
 	int err;
 	struct nrf_modem_trace_data *frags;
 	size_t n_frags;
+	int i;
+	int64_t start;
 
 trace_reset:
 	k_sem_take(&trace_sem, K_FOREVER);
@@ -301,6 +470,7 @@ trace_reset:
 		case 0:
 			/* Success */
 			UPDATE_TRACE_BYTES_RECEIVED(frags, n_frags);
+			STATS_ADD_FRAGS(bytes_received, frags, n_frags);
 			break;
 		case -NRF_ESHUTDOWN:
 			LOG_INF("Modem was turned off, no more traces");
@@ -323,21 +493,30 @@ trace_reset:
 			backend_resume();
 		}
 
-		for (int i = 0; i < n_frags; i++) {
+		for (i = 0; i < n_frags; i++) {
 retry:
+			if (IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL)) {
+				start = k_uptime_ticks();
+			}
 			err = trace_fragment_write(&frags[i]);
+			if (IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL)) {
+				adaptive_level_update(k_uptime_ticks() - start);
+			}
 			switch (err) {
 			case 0:
 				break;
 			case -ENOSPC:
 				nrf_modem_lib_trace_callback(NRF_MODEM_LIB_TRACE_EVT_FULL);
 				if (!trace_backend.clear) {
+					STATS_ADD_FRAGS(bytes_lost, &frags[i], n_frags - i);
 					goto deinit;
 				}
 
 				has_space = false;
 				k_sem_give(&trace_done_sem);
+				start = k_uptime_get();
 				k_sem_take(&trace_clear_sem, K_FOREVER);
+				STATS_ADD(stall_time_ms, k_uptime_get() - start);
 				/* Try the same fragment again */
 				goto retry;
 
@@ -350,8 +529,10 @@ retry:
 					 *  level 0 (off).
 					 */
 					k_sem_give(&trace_done_sem);
+					start = k_uptime_get();
 					k_sem_take(&modem_trace_level_sem, K_FOREVER);
 					k_sem_take(&trace_done_sem, K_FOREVER);
+					STATS_ADD(stall_time_ms, k_uptime_get() - start);
 				}
 
 				k_sem_give(&modem_trace_level_sem);
@@ -361,6 +542,7 @@ retry:
 
 			default:
 				/* Irrecoverable error */
+				STATS_ADD_FRAGS(bytes_lost, &frags[i], n_frags - i);
 				goto deinit;
 			}
 		}
@@ -395,6 +577,11 @@ static int trace_init(void)
 	LOG_INF("Trace thread ready");
 	k_sem_give(&trace_sem);
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL
+	adaptive_period_start = k_uptime_ticks();
+	adaptive_busy_ticks = 0;
+#endif
+
 #if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE
 	k_work_schedule(&backend_bps_avg_update_work, BACKEND_BPS_AVG_UPDATE_PERIOD);
 #endif
@@ -459,13 +646,9 @@ static int trace_deinit(void)
 	return 0;
 }
 
-int nrf_modem_lib_trace_level_set(enum nrf_modem_lib_trace_level trace_level)
+static int trace_level_apply(int tl)
 {
 	int err;
-	/* Casting to integer to remove any assumptions on the type of the enum
-	 * (could be `char` or `int`) when `printf` expects exactly `int`.
-	 */
-	int tl = trace_level;
 
 	if (tl) {
 		err = nrf_modem_at_printf("AT%%XMODEMTRACE=1,%d", tl);
@@ -480,6 +663,26 @@ int nrf_modem_lib_trace_level_set(enum nrf_modem_lib_trace_level trace_level)
 		return -ENOEXEC;
 	}
 
+	trace_level_current = tl;
+
+	return 0;
+}
+
+int nrf_modem_lib_trace_level_set(enum nrf_modem_lib_trace_level trace_level)
+{
+	int err;
+	/* Casting to integer to remove any assumptions on the type of the enum
+	 * (could be `char` or `int`) when `printf` expects exactly `int`.
+	 */
+	int tl = trace_level;
+
+	err = trace_level_apply(tl);
+	if (err) {
+		return err;
+	}
+
+	trace_level_user = tl;
+
 	return 0;
 }
 
@@ -538,5 +741,14 @@ int nrf_modem_lib_trace_clear(void)
 	return 0;
 }
 
+int nrf_modem_lib_trace_discard_before(int64_t uptime_ms)
+{
+	if (!trace_backend.discard_before) {
+		return -ENOTSUP;
+	}
+
+	return trace_backend.discard_before(uptime_ms);
+}
+
 K_THREAD_DEFINE(trace_thread, CONFIG_NRF_MODEM_LIB_TRACE_STACK_SIZE, trace_thread_handler,
 	       NULL, NULL, NULL, TRACE_THREAD_PRIORITY, 0, 0);
@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/shell/shell.h>
 #include <modem/nrf_modem_lib_trace.h>
 
@@ -85,6 +86,30 @@ static void modem_trace_size(const struct shell *sh, size_t argc, char **argv)
 	}
 }
 
+#ifdef CONFIG_NRF_MODEM_LIB_TRACE_STATS
+
+static void modem_trace_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct nrf_modem_lib_trace_stats stats;
+
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		nrf_modem_lib_trace_stats_reset();
+		shell_print(sh, "Modem trace statistics reset");
+		return;
+	}
+
+	(void)nrf_modem_lib_trace_stats_get(&stats);
+
+	shell_print(sh, "Received: %u bytes", stats.bytes_received);
+	shell_print(sh, "Written: %u bytes", stats.bytes_written);
+	shell_print(sh, "Lost: %u bytes", stats.bytes_lost);
+	shell_print(sh, "Stalled: %u ms", stats.stall_time_ms);
+	shell_print(sh, "Trace level downgrades: %u", stats.level_downgrades);
+	shell_print(sh, "Trace level restores: %u", stats.level_restores);
+}
+
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_STATS */
+
 #ifdef CONFIG_NRF_MODEM_LIB_SHELL_TRACE_UART
 
 static const struct device *const uart_dev = DEVICE_DT_GET(UART_DEVICE_NODE);
@@ -182,6 +207,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(modem_trace_cmd,
 		"This operation is only supported with some trace backends.", modem_trace_size),
 	SHELL_CMD(dump_uart, NULL,
 		"Dump stored traces to UART.", modem_trace_dump_uart),
+#ifdef CONFIG_NRF_MODEM_LIB_TRACE_STATS
+	SHELL_CMD_ARG(stats, NULL,
+		"Print modem trace statistics. Use 'stats reset' to reset them.",
+		modem_trace_stats, 1, 1),
+#endif
 	SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(modem_trace, &modem_trace_cmd,
@@ -16,6 +16,10 @@
 
 #include <modem/trace_backend.h>
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+#include "trace_lz.h"
+#endif
+
 LOG_MODULE_REGISTER(modem_trace_backend, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
 
 #define EXT_FLASH_DEVICE DEVICE_DT_GET(DT_ALIAS(ext_flash))
@@ -26,6 +30,28 @@ LOG_MODULE_REGISTER(modem_trace_backend, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
 
 #define TRACE_MAGIC_INITIALIZED 0x152ac523
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+/* Each FCB entry starts with a header holding the uncompressed length of the entry,
+ * and a flag telling whether the payload is compressed or stored as is.
+ */
+#define ENTRY_HDR_SIZE sizeof(uint16_t)
+#define ENTRY_HDR_COMPRESSED BIT(15)
+#define ENTRY_HDR_LEN_MASK (ENTRY_HDR_COMPRESSED - 1)
+
+BUILD_ASSERT(BUF_SIZE <= ENTRY_HDR_LEN_MASK, "Flash buffer too large for entry header");
+#endif
+
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX)
+/* Per-sector index of the uptime range covered by the trace data in the sector. */
+struct sector_index_entry {
+	int64_t first_uptime;
+	int64_t last_uptime;
+	bool valid;
+};
+
+static struct sector_index_entry sector_index[CONFIG_NRF_MODEM_LIB_TRACE_FLASH_SECTORS];
+#endif
+
 static trace_backend_processed_cb trace_processed_callback;
 
 static const struct flash_area *modem_trace_area;
@@ -51,6 +77,14 @@ static __noinit size_t trace_bytes_unread;
 static __noinit size_t flash_buf_written;
 static __noinit uint8_t flash_buf[BUF_SIZE];
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+/* Decompressed content of the FCB entry that is currently being read. */
+static __noinit uint8_t read_buf[BUF_SIZE];
+static __noinit size_t read_buf_len;
+/* Scratch buffer for a compressed FCB entry, used both when flushing and reading. */
+static uint8_t entry_buf[ENTRY_HDR_SIZE + BUF_SIZE];
+#endif
+
 static bool is_initialized;
 
 static struct k_sem fcb_sem;
@@ -69,20 +103,171 @@ static size_t buffer_append(const void *data, size_t len)
 	return append_len;
 }
 
+/* Number of trace bytes held by an FCB entry, before compression. */
+static size_t entry_trace_len(const struct fcb_entry *entry)
+{
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+	uint16_t hdr;
+	int err;
+
+	err = flash_area_read(trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(*entry), &hdr, sizeof(hdr));
+	if (err) {
+		LOG_ERR("flash_area_read failed, err %d", err);
+		return 0;
+	}
+
+	return hdr & ENTRY_HDR_LEN_MASK;
+#else
+	return entry->fe_data_len;
+#endif
+}
+
 static int fcb_walk_callback(struct fcb_entry_ctx *loc_ctx, void *arg)
 {
 	if ((loc_ctx->loc.fe_sector == sector) && (loc_ctx->loc.fe_elem_off < loc.fe_elem_off)) {
 		return 0;
 	}
 
-	trace_bytes_unread -= loc_ctx->loc.fe_data_len;
+	trace_bytes_unread -= entry_trace_len(&loc_ctx->loc);
+	return 0;
+}
+
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX)
+static struct sector_index_entry *sector_index_get(const struct flash_sector *fs)
+{
+	return &sector_index[fs - trace_flash_sectors];
+}
+
+static void sector_index_update(const struct flash_sector *fs)
+{
+	struct sector_index_entry *entry = sector_index_get(fs);
+	int64_t now = k_uptime_get();
+
+	if (!entry->valid) {
+		entry->first_uptime = now;
+		entry->valid = true;
+	}
+	entry->last_uptime = now;
+}
+
+static void sector_index_clear(const struct flash_sector *fs)
+{
+	memset(sector_index_get(fs), 0, sizeof(struct sector_index_entry));
+}
+
+static void sector_index_clear_all(void)
+{
+	memset(sector_index, 0, sizeof(sector_index));
+}
+
+static struct flash_sector *sector_next(struct flash_sector *fs)
+{
+	fs++;
+	if (fs == &trace_flash_sectors[trace_fcb.f_sector_cnt]) {
+		fs = &trace_flash_sectors[0];
+	}
+
+	return fs;
+}
+#else
+static void sector_index_update(const struct flash_sector *fs)
+{
+	ARG_UNUSED(fs);
+}
+
+static void sector_index_clear(const struct flash_sector *fs)
+{
+	ARG_UNUSED(fs);
+}
+
+static void sector_index_clear_all(void)
+{
+}
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX */
+
+/* Rotate the FCB, erasing the oldest sector. */
+static int trace_fcb_rotate(void)
+{
+	struct flash_sector *oldest = trace_fcb.f_oldest;
+	int err;
+
+	err = fcb_rotate(&trace_fcb);
+	if (!err) {
+		sector_index_clear(oldest);
+	}
+
+	return err;
+}
+
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+/* Prepare the entry to be written to flash, compressing the flash buffer if that saves space.
+ * Returns the length of the entry in entry_buf.
+ */
+static size_t entry_encode(void)
+{
+	uint16_t hdr;
+	int len;
+
+	len = trace_lz_compress(flash_buf, flash_buf_written,
+				&entry_buf[ENTRY_HDR_SIZE], flash_buf_written - 1);
+	if (len > 0) {
+		hdr = flash_buf_written | ENTRY_HDR_COMPRESSED;
+	} else {
+		/* Incompressible, store as is. */
+		memcpy(&entry_buf[ENTRY_HDR_SIZE], flash_buf, flash_buf_written);
+		len = flash_buf_written;
+		hdr = flash_buf_written;
+	}
+
+	memcpy(entry_buf, &hdr, sizeof(hdr));
+
+	return ENTRY_HDR_SIZE + len;
+}
+
+/* Read the current entry from flash and decompress it into read_buf. */
+static int entry_load(void)
+{
+	uint16_t hdr;
+	int err;
+
+	if (loc.fe_data_len > sizeof(entry_buf) || loc.fe_data_len < ENTRY_HDR_SIZE) {
+		LOG_ERR("Invalid trace entry length %d", loc.fe_data_len);
+		return -EBADMSG;
+	}
+
+	err = flash_area_read(trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), entry_buf,
+			      loc.fe_data_len);
+	if (err) {
+		LOG_ERR("Flash_area_read failed, err %d", err);
+		return err;
+	}
+
+	memcpy(&hdr, entry_buf, sizeof(hdr));
+
+	if (hdr & ENTRY_HDR_COMPRESSED) {
+		err = trace_lz_decompress(&entry_buf[ENTRY_HDR_SIZE],
+					  loc.fe_data_len - ENTRY_HDR_SIZE,
+					  read_buf, sizeof(read_buf));
+		if (err != (hdr & ENTRY_HDR_LEN_MASK)) {
+			LOG_ERR("Failed to decompress trace entry, err %d", err);
+			return -EBADMSG;
+		}
+	} else {
+		memcpy(read_buf, &entry_buf[ENTRY_HDR_SIZE], loc.fe_data_len - ENTRY_HDR_SIZE);
+	}
+
+	read_buf_len = hdr & ENTRY_HDR_LEN_MASK;
+
 	return 0;
 }
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS */
 
 static int buffer_flush_to_flash(void)
 {
 	int err;
 	struct fcb_entry loc_flush;
+	const uint8_t *entry;
+	size_t entry_len;
 
 	if (!is_initialized) {
 		return -EPERM;
@@ -94,7 +279,15 @@ static int buffer_flush_to_flash(void)
 
 	k_sem_take(&fcb_sem, K_FOREVER);
 
-	err = fcb_append(&trace_fcb, flash_buf_written, &loc_flush);
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+	entry = entry_buf;
+	entry_len = entry_encode();
+#else
+	entry = flash_buf;
+	entry_len = flash_buf_written;
+#endif
+
+	err = fcb_append(&trace_fcb, entry_len, &loc_flush);
 	if (err) {
 		if (IS_ENABLED(CONFIG_NRF_MODEM_TRACE_FLASH_NOSPACE_ERASE_OLDEST)) {
 			/* Find the number of trace bytes in oldest sector (that is not read). */
@@ -112,12 +305,12 @@ static int buffer_flush_to_flash(void)
 			}
 
 			/* Erase the oldest sector and append again. */
-			err = fcb_rotate(&trace_fcb);
+			err = trace_fcb_rotate();
 			if (err) {
 				LOG_ERR("fcb_rotate failed, err %d", err);
 				goto out;
 			}
-			err = fcb_append(&trace_fcb, flash_buf_written, &loc_flush);
+			err = fcb_append(&trace_fcb, entry_len, &loc_flush);
 		}
 
 		if (err) {
@@ -130,7 +323,7 @@ static int buffer_flush_to_flash(void)
 	}
 
 	err = flash_area_write(
-		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc_flush), flash_buf, flash_buf_written);
+		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc_flush), entry, entry_len);
 	if (err) {
 		LOG_ERR("flash_area_write failed, err %d", err);
 		goto out;
@@ -142,6 +335,8 @@ static int buffer_flush_to_flash(void)
 		goto out;
 	}
 
+	sector_index_update(loc_flush.fe_sector);
+
 	flash_buf_written = 0;
 
 out:
@@ -251,21 +446,29 @@ size_t trace_backend_data_size(void)
  */
 static int read_from_offset(void *buf, size_t len)
 {
-	int err;
 	size_t to_read;
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+	const size_t entry_len = read_buf_len;
+
+	to_read = MIN(len, entry_len - read_offset);
+	memcpy(buf, &read_buf[read_offset], to_read);
+#else
+	const size_t entry_len = loc.fe_data_len;
+	int err;
 
-	to_read = MIN(len, loc.fe_data_len - read_offset);
+	to_read = MIN(len, entry_len - read_offset);
 	err = flash_area_read(
 		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc) + read_offset, buf, to_read);
 	if (err) {
 		LOG_ERR("Flash_area_read failed, err %d", err);
 		return err;
 	}
+#endif
 
 	trace_bytes_unread -= to_read;
 
 	read_offset += to_read;
-	if (read_offset >= loc.fe_data_len) {
+	if (read_offset >= entry_len) {
 		read_offset = 0;
 	}
 
@@ -321,6 +524,13 @@ int trace_backend_read(void *buf, size_t len)
 		goto out;
 	}
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESS)
+	err = entry_load();
+	if (err) {
+		goto out;
+	}
+#endif
+
 	err = read_from_offset(buf, len);
 
 out:
@@ -328,7 +538,7 @@ out:
 
 	/* Erase if done with previous sector. */
 	if (sector && (sector != loc.fe_sector)) {
-		err = fcb_rotate(&trace_fcb);
+		err = trace_fcb_rotate();
 		if (err) {
 			LOG_ERR("Failed to erase read sector, err %d", err);
 			k_sem_give(&fcb_sem);
@@ -414,6 +624,7 @@ int trace_backend_clear(void)
 	LOG_DBG("Clearing trace storage");
 	flash_buf_written = 0;
 	err = fcb_clear(&trace_fcb);
+	sector_index_clear_all();
 
 	loc.fe_sector = 0;
 	loc.fe_elem_off = 0;
@@ -426,6 +637,117 @@ int trace_backend_clear(void)
 	return err;
 }
 
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX)
+static int discard_walk_callback(struct fcb_entry_ctx *loc_ctx, void *arg)
+{
+	ARG_UNUSED(arg);
+
+	if (loc.fe_sector && (loc_ctx->loc.fe_sector == loc.fe_sector)) {
+		if (loc_ctx->loc.fe_elem_off < loc.fe_elem_off) {
+			/* Already read. */
+			return 0;
+		}
+
+		if (loc_ctx->loc.fe_elem_off == loc.fe_elem_off) {
+			/* Entry that is being read. It has been read completely if the offset is 0. */
+			if (read_offset) {
+				trace_bytes_unread -= entry_trace_len(&loc_ctx->loc) - read_offset;
+			}
+
+			return 0;
+		}
+	}
+
+	trace_bytes_unread -= entry_trace_len(&loc_ctx->loc);
+	return 0;
+}
+
+int trace_backend_discard_before(int64_t uptime_ms)
+{
+	struct sector_index_entry *entry;
+	struct flash_sector *fs;
+	bool skip_all = false;
+	bool skipped = false;
+	bool erased = false;
+	int err = 0;
+
+	if (!is_initialized) {
+		return -EPERM;
+	}
+
+	k_sem_take(&fcb_sem, K_FOREVER);
+
+	if (fcb_is_empty(&trace_fcb)) {
+		goto out;
+	}
+
+	/* Use the index to find the first sector holding trace data captured at or after the
+	 * given uptime, and move the read position to its first entry. The read position is never
+	 * moved backwards. Sectors written before a warm reboot have no index data and are
+	 * considered older than any positive uptime.
+	 */
+	for (fs = loc.fe_sector ? loc.fe_sector : trace_fcb.f_oldest; ; fs = sector_next(fs)) {
+		entry = sector_index_get(fs);
+
+		if (entry->valid ? (entry->last_uptime >= uptime_ms) : (uptime_ms <= 0)) {
+			break;
+		}
+
+		err = fcb_walk(&trace_fcb, fs, discard_walk_callback, NULL);
+		if (err) {
+			LOG_ERR("fcb_walk failed, err %d", err);
+			goto out;
+		}
+
+		skipped = true;
+
+		if (fs == trace_fcb.f_active.fe_sector) {
+			skip_all = true;
+			break;
+		}
+	}
+
+	if (!skipped) {
+		goto out;
+	}
+
+	if (skip_all) {
+		/* Continue after the last entry written to flash. */
+		loc = trace_fcb.f_active;
+	} else {
+		/* Continue from the first entry of the sector. */
+		loc.fe_sector = fs;
+		loc.fe_elem_off = 0;
+	}
+
+	read_offset = 0;
+
+	/* Erase the skipped sectors, so that their space is available for new trace data.
+	 * The sector that is read next is erased by the reader when it is done with it.
+	 */
+	while (trace_fcb.f_oldest != loc.fe_sector) {
+		err = trace_fcb_rotate();
+		if (err) {
+			LOG_ERR("Failed to erase skipped sector, err %d", err);
+			break;
+		}
+
+		erased = true;
+	}
+
+	sector = loc.fe_sector;
+
+	if (erased) {
+		k_sem_give(&trace_clear_sem);
+	}
+
+out:
+	k_sem_give(&fcb_sem);
+
+	return err;
+}
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX */
+
 int trace_backend_deinit(void)
 {
 	buffer_flush_to_flash();
@@ -439,4 +761,7 @@ struct nrf_modem_lib_trace_backend trace_backend = {
 	.data_size = trace_backend_data_size,
 	.read = trace_backend_read,
 	.clear = trace_backend_clear,
+#if defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_INDEX)
+	.discard_before = trace_backend_discard_before,
+#endif
 };
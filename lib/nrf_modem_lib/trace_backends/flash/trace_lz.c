@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "trace_lz.h"
+
+/* Minimal LZ4 block format encoder and decoder.
+ *
+ * Each sequence starts with a token: the upper nibble is the literal length and the lower
+ * nibble is the match length minus MIN_MATCH. A nibble value of 15 is followed by extension
+ * bytes that are added to it until a byte other than 255 is found. Literals follow the
+ * literal length, then a 16-bit little-endian match offset and the match length extension.
+ * The last sequence of a block contains literals only.
+ */
+
+#define MIN_MATCH 4
+#define RUN_MASK 15
+#define LAST_LITERALS 5
+#define MF_LIMIT 12
+#define MAX_DISTANCE UINT16_MAX
+
+#define HASH_LOG 10
+#define HASH_SIZE (1 << HASH_LOG)
+
+static uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static uint32_t hash32(uint32_t v)
+{
+	return (v * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static uint8_t *length_write(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = (uint8_t)len;
+
+	return op;
+}
+
+static size_t length_ext_size(size_t len)
+{
+	return (len >= RUN_MASK) ? ((len - RUN_MASK) / 255 + 1) : 0;
+}
+
+/* Kept out of the stack, which is small in the trace thread. The encoder is not reentrant. */
+static uint16_t table[HASH_SIZE];
+
+int trace_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *const end = src + src_len;
+	const uint8_t *const mf_limit = (src_len > MF_LIMIT) ? end - MF_LIMIT : src;
+	const uint8_t *const match_limit = (src_len > LAST_LITERALS) ? end - LAST_LITERALS : src;
+	uint8_t *op = dst;
+	uint8_t *const oend = dst + dst_cap;
+	size_t lit_len;
+
+	if (src_len > TRACE_LZ_BLOCK_SIZE_MAX) {
+		return -EINVAL;
+	}
+
+	memset(table, 0, sizeof(table));
+
+	while (ip < mf_limit) {
+		const uint32_t seq = read32(ip);
+		const uint32_t h = hash32(seq);
+		const uint8_t *ref = src + table[h];
+		const uint8_t *mp;
+		const uint8_t *rp;
+		size_t match_len;
+		uint16_t offset;
+		uint8_t *token;
+
+		table[h] = (uint16_t)(ip - src);
+
+		if (ref >= ip || (ip - ref) > MAX_DISTANCE || read32(ref) != seq) {
+			ip++;
+			continue;
+		}
+
+		mp = ip + MIN_MATCH;
+		rp = ref + MIN_MATCH;
+		while (mp < match_limit && *mp == *rp) {
+			mp++;
+			rp++;
+		}
+
+		lit_len = ip - anchor;
+		match_len = (mp - ip) - MIN_MATCH;
+		offset = (uint16_t)(ip - ref);
+
+		if ((size_t)(oend - op) < 1 + length_ext_size(lit_len) + lit_len + 2 +
+					  length_ext_size(match_len)) {
+			return -ENOSPC;
+		}
+
+		token = op++;
+		if (lit_len >= RUN_MASK) {
+			*token = RUN_MASK << 4;
+			op = length_write(op, lit_len - RUN_MASK);
+		} else {
+			*token = (uint8_t)(lit_len << 4);
+		}
+
+		memcpy(op, anchor, lit_len);
+		op += lit_len;
+
+		*op++ = (uint8_t)offset;
+		*op++ = (uint8_t)(offset >> 8);
+
+		if (match_len >= RUN_MASK) {
+			*token |= RUN_MASK;
+			op = length_write(op, match_len - RUN_MASK);
+		} else {
+			*token |= (uint8_t)match_len;
+		}
+
+		ip = mp;
+		anchor = ip;
+	}
+
+	/* Last literals */
+	lit_len = end - anchor;
+	if ((size_t)(oend - op) < 1 + length_ext_size(lit_len) + lit_len) {
+		return -ENOSPC;
+	}
+
+	if (lit_len >= RUN_MASK) {
+		*op++ = RUN_MASK << 4;
+		op = length_write(op, lit_len - RUN_MASK);
+	} else {
+		*op++ = (uint8_t)(lit_len << 4);
+	}
+
+	memcpy(op, anchor, lit_len);
+	op += lit_len;
+
+	return op - dst;
+}
+
+static int length_read(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*ip >= iend) {
+			return -EINVAL;
+		}
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 255);
+
+	return 0;
+}
+
+int trace_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap)
+{
+	const uint8_t *ip = src;
+	const uint8_t *const iend = src + src_len;
+	uint8_t *op = dst;
+	uint8_t *const oend = dst + dst_cap;
+
+	while (ip < iend) {
+		const uint8_t token = *ip++;
+		size_t lit_len = token >> 4;
+		size_t match_len = token & RUN_MASK;
+		const uint8_t *ref;
+		size_t offset;
+
+		if (lit_len == RUN_MASK && length_read(&ip, iend, &lit_len)) {
+			return -EINVAL;
+		}
+
+		if (lit_len > (size_t)(iend - ip) || lit_len > (size_t)(oend - op)) {
+			return -EINVAL;
+		}
+
+		memcpy(op, ip, lit_len);
+		op += lit_len;
+		ip += lit_len;
+
+		if (ip == iend) {
+			/* Last sequence */
+			break;
+		}
+
+		if ((iend - ip) < 2) {
+			return -EINVAL;
+		}
+
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if (offset == 0 || offset > (size_t)(op - dst)) {
+			return -EINVAL;
+		}
+
+		if (match_len == RUN_MASK && length_read(&ip, iend, &match_len)) {
+			return -EINVAL;
+		}
+
+		match_len += MIN_MATCH;
+		if (match_len > (size_t)(oend - op)) {
+			return -EINVAL;
+		}
+
+		/* Byte-wise copy, the match may overlap the output. */
+		ref = op - offset;
+		while (match_len--) {
+			*op++ = *ref++;
+		}
+	}
+
+	return op - dst;
+}
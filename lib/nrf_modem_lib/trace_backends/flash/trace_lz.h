@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_LZ_H__
+#define TRACE_LZ_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest input block supported by the codec. */
+#define TRACE_LZ_BLOCK_SIZE_MAX UINT16_MAX
+
+/**
+ * @brief Compress a block of trace data.
+ *
+ * The output uses the LZ4 block format, so stored traces can also be
+ * decompressed off-target with standard LZ4 tools.
+ *
+ * @param src     Data to compress.
+ * @param src_len Length of data, at most @ref TRACE_LZ_BLOCK_SIZE_MAX.
+ * @param dst     Output buffer.
+ * @param dst_cap Size of output buffer.
+ *
+ * @return Length of the compressed data on success.
+ * @retval -ENOSPC The compressed data does not fit into @p dst_cap bytes.
+ * @retval -EINVAL Invalid input length.
+ */
+int trace_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+/**
+ * @brief Decompress a block of trace data.
+ *
+ * @param src     Compressed data.
+ * @param src_len Length of compressed data.
+ * @param dst     Output buffer.
+ * @param dst_cap Size of output buffer.
+ *
+ * @return Length of the decompressed data on success.
+ * @retval -EINVAL The compressed data is malformed or does not fit into @p dst_cap bytes.
+ */
+int trace_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_LZ_H__ */
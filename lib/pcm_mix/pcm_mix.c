@@ -8,9 +8,41 @@
 
 #include <zephyr/kernel.h>
 
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
+#if defined(__ARM_FEATURE_SIMD32)
+/* A stereo sample, or two mono samples, fit in one 32-bit word and are mixed with a single
+ * saturating dual 16-bit addition. The saturation gives the same result as the hard limiter.
+ */
+static bool is_word_aligned(void const *const ptr)
+{
+	return ((uintptr_t)ptr % sizeof(int16x2_t)) == 0;
+}
+
+/* Pack a mono sample into the halves of a stereo sample selected by the mask */
+static int16x2_t mono_to_stereo(int16_t sample, uint32_t mask)
+{
+	uint32_t half = (uint16_t)sample;
+
+	return (int16x2_t)((half | (half << 16)) & mask);
+}
+
+static void pcm_mix_b_mono_into_a_stereo_simd(void *const pcm_a, void const *const pcm_b,
+					      size_t size_b, uint32_t mask)
+{
+	for (uint32_t i = 0; i < size_b / 2; i++) {
+		((int16x2_t *)pcm_a)[i] =
+			__qadd16(((int16x2_t *)pcm_a)[i],
+				 mono_to_stereo(((int16_t const *)pcm_b)[i], mask));
+	}
+}
+#endif /* defined(__ARM_FEATURE_SIMD32) */
+
 /* Clip signal if amplitude is outside legal range */
 static void hard_limiter(int32_t *const pcm)
 {
@@ -28,8 +60,21 @@ static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *cons
 			      size_t size_b)
 {
 	int32_t res;
+	uint32_t i = 0;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
+#if defined(__ARM_FEATURE_SIMD32)
+	if (is_word_aligned(pcm_a) && is_word_aligned(pcm_b)) {
+		for (; i < size_b / sizeof(int16x2_t); i++) {
+			((int16x2_t *)pcm_a)[i] =
+				__qadd16(((int16x2_t *)pcm_a)[i], ((int16x2_t const *)pcm_b)[i]);
+		}
+
+		/* Mix the last sample, if the number of samples is odd */
+		i *= 2;
+	}
+#endif
+
+	for (; i < size_b / 2; i++) {
 		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
 
 		hard_limiter(&res);
@@ -44,6 +89,13 @@ static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
 {
 	int32_t res;
 
+#if defined(__ARM_FEATURE_SIMD32)
+	if (is_word_aligned(pcm_a)) {
+		pcm_mix_b_mono_into_a_stereo_simd(pcm_a, pcm_b, size_b, 0xFFFFFFFF);
+		return;
+	}
+#endif
+
 	/* Use size_b as this is the length of the mono sample.
 	 * This must be *2 to traverse the stereo sample and /2 since
 	 * the sample is two bytes in size.
@@ -63,6 +115,13 @@ static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
 {
 	int32_t res;
 
+#if defined(__ARM_FEATURE_SIMD32)
+	if (is_word_aligned(pcm_a)) {
+		pcm_mix_b_mono_into_a_stereo_simd(pcm_a, pcm_b, size_b, 0x0000FFFF);
+		return;
+	}
+#endif
+
 	for (uint32_t i = 0; i < size_b / 2; i++) {
 		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
 
@@ -78,6 +137,13 @@ static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
 {
 	int32_t res;
 
+#if defined(__ARM_FEATURE_SIMD32)
+	if (is_word_aligned(pcm_a)) {
+		pcm_mix_b_mono_into_a_stereo_simd(pcm_a, pcm_b, size_b, 0xFFFF0000);
+		return;
+	}
+#endif
+
 	for (uint32_t i = 0; i < size_b / 2; i++) {
 		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
 
@@ -16,7 +16,7 @@
 #include <bluetooth/scan.h>
 #include <bluetooth/services/ras.h>
 #include <bluetooth/gatt_dm.h>
-#include "distance_estimation.h"
+#include <bluetooth/cs_de.h>
 
 #include <dk_buttons_and_leds.h>
 
@@ -51,6 +51,37 @@ NET_BUF_SIMPLE_DEFINE_STATIC(latest_peer_steps, BT_RAS_PROCEDURE_MEM);
 static int32_t most_recent_peer_ranging_counter = PROCEDURE_COUNTER_NONE;
 static int32_t most_recent_local_ranging_counter = PROCEDURE_COUNTER_NONE;
 static int32_t dropped_ranging_counter = PROCEDURE_COUNTER_NONE;
+static struct cs_de_report cs_de_report;
+static struct cs_de_filter phase_slope_filter;
+static struct cs_de_filter ifft_filter;
+static struct cs_de_filter rtt_filter;
+
+static void estimate_distance(void)
+{
+	enum cs_de_quality quality;
+	int32_t phase_slope;
+	int32_t ifft;
+	int32_t rtt;
+
+	cs_de_populate_report(&latest_local_steps, &latest_peer_steps, n_ap,
+			      BT_CONN_LE_CS_ROLE_INITIATOR, &cs_de_report);
+
+	quality = cs_de_calc(&cs_de_report);
+	if (quality != CS_DE_QUALITY_OK) {
+		LOG_INF("A reliable distance estimate could not be computed.");
+		return;
+	}
+
+	phase_slope = cs_de_filter_update(&phase_slope_filter,
+					  cs_de_report.estimates.phase_slope);
+	ifft = cs_de_filter_update(&ifft_filter, cs_de_report.estimates.ifft);
+	rtt = cs_de_filter_update(&rtt_filter, cs_de_report.estimates.rtt);
+
+	LOG_INF("Estimated distance to reflector (filtered, in mm):");
+	LOG_INF("- Phase slope: %d (%d)", cs_de_report.estimates.phase_slope, phase_slope);
+	LOG_INF("- IFFT: %d (%d)", cs_de_report.estimates.ifft, ifft);
+	LOG_INF("- Round-trip time: %d (%d)", cs_de_report.estimates.rtt, rtt);
+}
 
 static void subevent_result_cb(struct bt_conn *conn, struct bt_conn_le_cs_subevent_result *result)
 {
@@ -323,6 +354,10 @@ int main(void)
 
 	dk_leds_init();
 
+	cs_de_filter_init(&phase_slope_filter);
+	cs_de_filter_init(&ifft_filter);
+	cs_de_filter_init(&rtt_filter);
+
 	err = bt_enable(NULL);
 	if (err) {
 		LOG_ERR("Bluetooth init failed (err %d)", err);
@@ -517,8 +552,7 @@ int main(void)
 			goto retry;
 		}
 
-		estimate_distance(&latest_local_steps, &latest_peer_steps, n_ap,
-				  BT_CONN_LE_CS_ROLE_INITIATOR);
+		estimate_distance();
 
 retry:
 		net_buf_simple_reset(&latest_local_steps);
@@ -9,10 +9,15 @@
 #include "ble_connectivity_manager.h"
 #include "bridged_device_data_provider.h"
 
+#include <platform/CHIPDeviceLayer.h>
+
 #include <bluetooth/gatt_dm.h>
 #include <zephyr/bluetooth/addr.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
 
 namespace Nrf
 {
@@ -31,15 +36,42 @@ struct BLEBridgedDevice {
 
 class BLEBridgedDeviceProvider : public BridgedDeviceDataProvider {
 public:
+	static constexpr uint32_t kReportCoalescingWindowMs = CONFIG_BRIDGE_BT_REPORT_COALESCING_WINDOW_MS;
+
 	BLEBridgedDeviceProvider(UpdateAttributeCallback updateCallback, InvokeCommandCallback commandCallback)
 		: BridgedDeviceDataProvider(updateCallback, commandCallback)
 	{
+		k_timer_init(&mReportTimer, ReportTimerTimeoutCallback, nullptr);
+		k_timer_user_data_set(&mReportTimer, this);
+	}
+	~BLEBridgedDeviceProvider()
+	{
+		k_timer_stop(&mReportTimer);
+		BLEConnectivityManager::Instance().RemoveBLEProvider(GetBtAddress());
 	}
-	~BLEBridgedDeviceProvider() { BLEConnectivityManager::Instance().RemoveBLEProvider(GetBtAddress()); }
 
 	virtual const bt_uuid *GetServiceUuid() = 0;
 	virtual int ParseDiscoveredData(bt_gatt_dm *discoveredData) = 0;
 
+	/**
+	 * @brief Subscribe again to the characteristics found in the last GATT discovery.
+	 *
+	 * Called after reconnecting to the device instead of the GATT discovery, if the characteristic handles
+	 * are cached.
+	 *
+	 * @return 0 on success, negative error code otherwise
+	 */
+	virtual int ResumeSubscription() { return -ENOTSUP; }
+
+	/**
+	 * @brief Deliver the attribute changes reported with @ref ReportAttributeChange.
+	 *
+	 * Called in the Matter thread.
+	 *
+	 * @param attributes bitmask of the provider-specific attribute indexes
+	 */
+	virtual void NotifyAttributesChange(uint32_t attributes) {}
+
 	BLEBridgedDevice &GetBLEBridgedDevice() { return mDevice; }
 	void SetConnectionObject(bt_conn *conn) { mDevice.mConn = conn; }
 	bt_conn *GetConnectionObject() { return mDevice.mConn; }
@@ -116,9 +148,96 @@ public:
 	 */
 	void NotifySuccessfulRecovery() { mFailedRecoveryAttempts = 0; }
 
+	/**
+	 * @brief Check if the characteristic handles found in the GATT discovery are cached.
+	 */
+	bool IsDiscoveryCached() { return mDiscoveryCached; }
+
+	/**
+	 * @brief Drop the cached characteristic handles, so that the next connection runs the GATT discovery.
+	 */
+	void InvalidateDiscoveryCache() { mDiscoveryCached = false; }
+
+	/**
+	 * @brief Get the number of attribute reports delivered to the Matter data model by all BLE providers.
+	 */
+	static uint32_t GetDeliveredReports() { return atomic_get(&sDeliveredReports); }
+
+	/**
+	 * @brief Get the number of attribute reports merged into a pending report by all BLE providers.
+	 */
+	static uint32_t GetSuppressedReports() { return atomic_get(&sSuppressedReports); }
+
+	/**
+	 * @brief Reset the report counters of all BLE providers.
+	 */
+	static void ResetReportStats()
+	{
+		atomic_clear(&sDeliveredReports);
+		atomic_clear(&sSuppressedReports);
+	}
+
 protected:
+	/**
+	 * @brief Report a change of the attribute value to the Matter data model.
+	 *
+	 * The changes reported within CONFIG_BRIDGE_BT_REPORT_COALESCING_WINDOW_MS from the first one are delivered
+	 * together through @ref NotifyAttributesChange. An attribute changed several times within the window is
+	 * delivered once, with its latest value. The method can be called from the Bluetooth thread.
+	 *
+	 * @param attributeIdx provider-specific index of the attribute, lower than 32
+	 */
+	void ReportAttributeChange(uint8_t attributeIdx)
+	{
+		__ASSERT_NO_MSG(attributeIdx < 32);
+
+		atomic_val_t pending = atomic_or(&mPendingReports, BIT(attributeIdx));
+
+		if (pending & BIT(attributeIdx)) {
+			atomic_inc(&sSuppressedReports);
+		} else if (pending == 0) {
+			if (kReportCoalescingWindowMs > 0) {
+				k_timer_start(&mReportTimer, K_MSEC(kReportCoalescingWindowMs), K_NO_WAIT);
+			} else {
+				ScheduleReport(this);
+			}
+		}
+	}
+
 	BLEBridgedDevice mDevice = { 0 };
 	uint16_t mFailedRecoveryAttempts = 0;
+	bool mDiscoveryCached = false;
+
+private:
+	static void ScheduleReport(BLEBridgedDeviceProvider *provider)
+	{
+		if (chip::DeviceLayer::PlatformMgr().ScheduleWork(DeliverReports,
+								  reinterpret_cast<intptr_t>(provider)) !=
+		    CHIP_NO_ERROR) {
+			/* Drop the pending changes, so that the next change schedules the report again. */
+			atomic_clear(&provider->mPendingReports);
+		}
+	}
+
+	static void ReportTimerTimeoutCallback(k_timer *timer)
+	{
+		ScheduleReport(reinterpret_cast<BLEBridgedDeviceProvider *>(k_timer_user_data_get(timer)));
+	}
+
+	static void DeliverReports(intptr_t context)
+	{
+		BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+		uint32_t attributes = atomic_clear(&provider->mPendingReports);
+
+		atomic_add(&sDeliveredReports, __builtin_popcount(attributes));
+		provider->NotifyAttributesChange(attributes);
+	}
+
+	static inline atomic_t sDeliveredReports = ATOMIC_INIT(0);
+	static inline atomic_t sSuppressedReports = ATOMIC_INIT(0);
+
+	atomic_t mPendingReports = ATOMIC_INIT(0);
+	k_timer mReportTimer;
 };
 
 } /* namespace Nrf */
@@ -88,6 +88,16 @@ void BLEConnectivityManager::FilterMatch(bt_scan_device_info *device_info, bt_sc
 
 int BLEConnectivityManager::StartGattDiscovery(bt_conn *conn, BLEBridgedDeviceProvider *provider)
 {
+#ifdef CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE
+	/* The recovered device already has its characteristic handles cached, so the discovery can be skipped. */
+	if (provider->IsInitiallyConnected() && provider->IsDiscoveryCached() &&
+	    CHIP_NO_ERROR ==
+		    DeviceLayer::PlatformMgr().ScheduleWork(ResumeFromDiscoveryCache,
+							    reinterpret_cast<intptr_t>(provider))) {
+		return 0;
+	}
+#endif /* CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE */
+
 	/* Start GATT discovery for the device's service UUID. */
 	int err = bt_gatt_dm_start(conn, provider->GetServiceUuid(), &discovery_cb, provider);
 	if (err) {
@@ -98,6 +108,39 @@ int BLEConnectivityManager::StartGattDiscovery(bt_conn *conn, BLEBridgedDevicePr
 	return err;
 }
 
+#ifdef CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE
+void BLEConnectivityManager::ResumeFromDiscoveryCache(intptr_t context)
+{
+	BLEBridgedDeviceProvider *provider = reinterpret_cast<BLEBridgedDeviceProvider *>(context);
+	bt_conn *conn = provider->GetConnectionObject();
+
+	VerifyOrReturn(conn, LOG_WRN("The connection was lost before resuming the subscription"));
+
+	int err = provider->ResumeSubscription();
+	if (err) {
+		LOG_WRN("Cannot resume the subscription from the cached GATT discovery (%d)", err);
+		provider->InvalidateDiscoveryCache();
+		if (StartGattDiscovery(conn, provider) != 0) {
+			Instance().mRecovery.NotifyProviderToRecover(provider);
+			Instance().UpdateRecovery();
+		}
+		return;
+	}
+
+	LOG_INF("The subscription resumed from the cached GATT discovery");
+
+	/* The device was successfully recovered. */
+	Instance().mRecovery.RemoveRecovered(provider);
+	provider->NotifySuccessfulRecovery();
+
+	if (CHIP_NO_ERROR != provider->NotifyReachableStatusChange(true)) {
+		LOG_WRN("The device has not been notified about the status change.");
+	}
+
+	Instance().UpdateRecovery();
+}
+#endif /* CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE */
+
 void BLEConnectivityManager::UpdateRecovery()
 {
 	if (!sys_slist_is_empty(&Instance().mRecovery.mListToReconnect)) {
@@ -277,6 +277,9 @@ private:
 	State GetCurrentState();
 	void UpdateStateFlag(State state, bool enabled);
 	void UpdateRecovery();
+#ifdef CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE
+	static void ResumeFromDiscoveryCache(intptr_t context);
+#endif /* CONFIG_BRIDGE_BT_GATT_DISCOVERY_CACHE */
 
 	StateChangedCallback mStateChangedCb = nullptr;
 	uint8_t mStateBitmask = 0;
@@ -18,6 +18,9 @@
 #include <zephyr/sys/util.h>
 #include <stdbool.h>
 #include <zephyr/sys/__assert.h>
+#if defined(CONFIG_BT_CTLR_SDC_RX_STATS)
+#include <zephyr/stats/stats.h>
+#endif
 
 #define SDC_USE_NEW_MEM_API
 #include <sdc.h>
@@ -338,8 +341,36 @@ static struct {
 	uint8_t buf[HCI_RX_BUF_SIZE];
 	/* Type of the HCI packet the buffer contains. */
 	sdc_hci_msg_type_t type;
+	/* The HCI packet, either in the buffer or in the host ACL buffer. */
+	uint8_t *msg;
+#if defined(CONFIG_BT_CTLR_SDC_RX_ZERO_COPY)
+	/* Host ACL buffer the next HCI packet is fetched into. */
+	struct net_buf *acl_buf;
+	/* Set if the last HCI packet contained ACL data. */
+	bool acl_rx_active;
+	/* Set if the host ACL buffers cannot hold every HCI packet. */
+	bool acl_buf_too_small;
+#endif
 } rx_hci_msg;
 
+#if defined(CONFIG_BT_CTLR_SDC_RX_STATS)
+STATS_SECT_START(sdc_rx)
+STATS_SECT_ENTRY32(wakeups)
+STATS_SECT_ENTRY32(msgs)
+STATS_SECT_ENTRY32(msgs_per_wakeup_max)
+STATS_SECT_ENTRY32(acl_zero_copy)
+STATS_SECT_END;
+
+STATS_NAME_START(sdc_rx)
+STATS_NAME(sdc_rx, wakeups)
+STATS_NAME(sdc_rx, msgs)
+STATS_NAME(sdc_rx, msgs_per_wakeup_max)
+STATS_NAME(sdc_rx, acl_zero_copy)
+STATS_NAME_END(sdc_rx);
+
+static STATS_SECT_DECL(sdc_rx) sdc_rx_stats;
+#endif /* CONFIG_BT_CTLR_SDC_RX_STATS */
+
 static void bt_buf_rx_freed_cb(enum bt_buf_type type_mask)
 {
 	if (((rx_hci_msg.type == SDC_HCI_MSG_TYPE_EVT && (type_mask & BT_BUF_EVT) != 0u) ||
@@ -450,18 +481,87 @@ static int hci_driver_send(const struct device *dev, struct net_buf *buf)
 	return err;
 }
 
+static uint8_t *rx_msg_buf_get(void)
+{
+#if defined(CONFIG_BT_CTLR_SDC_RX_ZERO_COPY)
+	/* Take a host ACL buffer only while the controller reports ACL data. Otherwise, the
+	 * buffer would be held back from the host pool while only events are received.
+	 */
+	if (rx_hci_msg.acl_rx_active && !rx_hci_msg.acl_buf && !rx_hci_msg.acl_buf_too_small) {
+		rx_hci_msg.acl_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_NO_WAIT);
+
+		if (rx_hci_msg.acl_buf &&
+		    (net_buf_tailroom(rx_hci_msg.acl_buf) < HCI_RX_BUF_SIZE)) {
+			LOG_WRN("ACL RX buffer too small for zero-copy receive. %zu < %u",
+				net_buf_tailroom(rx_hci_msg.acl_buf), HCI_RX_BUF_SIZE);
+			net_buf_unref(rx_hci_msg.acl_buf);
+			rx_hci_msg.acl_buf = NULL;
+			rx_hci_msg.acl_buf_too_small = true;
+		}
+	}
+
+	if (rx_hci_msg.acl_buf) {
+		return net_buf_tail(rx_hci_msg.acl_buf);
+	}
+#endif
+
+	return &rx_hci_msg.buf[0];
+}
+
+static struct net_buf *rx_acl_buf_take(const uint8_t *hci_buf)
+{
+#if defined(CONFIG_BT_CTLR_SDC_RX_ZERO_COPY)
+	struct net_buf *buf = rx_hci_msg.acl_buf;
+
+	if (buf && (hci_buf == net_buf_tail(buf))) {
+		rx_hci_msg.acl_buf = NULL;
+		return buf;
+	}
+#endif
+
+	return NULL;
+}
+
+static void rx_acl_buf_update(sdc_hci_msg_type_t msg_type)
+{
+#if defined(CONFIG_BT_CTLR_SDC_RX_ZERO_COPY)
+	rx_hci_msg.acl_rx_active = (msg_type == SDC_HCI_MSG_TYPE_DATA);
+
+	/* A packet other than ACL data was fetched into the host ACL buffer. */
+	if (!rx_hci_msg.acl_rx_active && rx_hci_msg.acl_buf) {
+		net_buf_unref(rx_hci_msg.acl_buf);
+		rx_hci_msg.acl_buf = NULL;
+	}
+#else
+	ARG_UNUSED(msg_type);
+#endif
+}
+
+static void rx_acl_buf_release(void)
+{
+#if defined(CONFIG_BT_CTLR_SDC_RX_ZERO_COPY)
+	if (rx_hci_msg.acl_buf) {
+		/* Drop the pending HCI packet if it is stored in the released buffer. */
+		if (rx_hci_msg.msg == net_buf_tail(rx_hci_msg.acl_buf)) {
+			rx_hci_msg.type = SDC_HCI_MSG_TYPE_NONE;
+			rx_hci_msg.msg = &rx_hci_msg.buf[0];
+		}
+
+		net_buf_unref(rx_hci_msg.acl_buf);
+		rx_hci_msg.acl_buf = NULL;
+	}
+
+	rx_hci_msg.acl_rx_active = false;
+#endif
+}
+
 static int data_packet_process(const struct device *dev, uint8_t *hci_buf)
 {
-	struct net_buf *data_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_NO_WAIT);
+	struct net_buf *data_buf;
 	struct bt_hci_acl_hdr *hdr = (void *)hci_buf;
 	uint16_t hf, handle, len;
 	uint8_t flags, pb, bc;
 
-	if (!data_buf) {
-		LOG_DBG("No data buffer available");
-		return -ENOBUFS;
-	}
-
 	len = sys_le16_to_cpu(hdr->len);
 	hf = sys_le16_to_cpu(hdr->handle);
 	handle = bt_acl_handle(hf);
@@ -479,7 +579,23 @@ static int data_packet_process(const struct device *dev, uint8_t *hci_buf)
 	LOG_DBG("Data: handle (0x%02x), PB(%01d), BC(%01d), len(%u)", handle,
 	       pb, bc, len);
 
-	net_buf_add_mem(data_buf, &hci_buf[0], len + sizeof(*hdr));
+	data_buf = rx_acl_buf_take(hci_buf);
+	if (data_buf) {
+		/* The controller has written the packet straight into the host buffer. */
+		net_buf_add(data_buf, len + sizeof(*hdr));
+
+#if defined(CONFIG_BT_CTLR_SDC_RX_STATS)
+		STATS_INC(sdc_rx_stats, acl_zero_copy);
+#endif
+	} else {
+		data_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_NO_WAIT);
+		if (!data_buf) {
+			LOG_DBG("No data buffer available");
+			return -ENOBUFS;
+		}
+
+		net_buf_add_mem(data_buf, &hci_buf[0], len + sizeof(*hdr));
+	}
 
 	struct hci_driver_data *driver_data = dev->data;
 
@@ -652,26 +768,52 @@ static int process_hci_msg(const struct device *dev, uint8_t *p_hci_buffer,
 	return err;
 }
 
+static void rx_stats_update(uint32_t msg_cnt)
+{
+#if defined(CONFIG_BT_CTLR_SDC_RX_STATS)
+	STATS_INC(sdc_rx_stats, wakeups);
+	STATS_INCN(sdc_rx_stats, msgs, msg_cnt);
+
+	if (msg_cnt > sdc_rx_stats.msgs_per_wakeup_max) {
+		STATS_SET(sdc_rx_stats, msgs_per_wakeup_max, msg_cnt);
+	}
+#else
+	ARG_UNUSED(msg_cnt);
+#endif
+}
+
 void hci_driver_receive_process(void)
 {
 	const struct device *dev = DEVICE_DT_GET(DT_DRV_INST(0));
+	uint32_t msg_cnt = 0;
 	int err;
 
-	if (rx_hci_msg.type == SDC_HCI_MSG_TYPE_NONE &&
-	    fetch_hci_msg(&rx_hci_msg.buf[0], &rx_hci_msg.type) != 0) {
-		return;
-	}
+	while (msg_cnt < CONFIG_BT_CTLR_SDC_RX_BATCH_COUNT) {
+		if (rx_hci_msg.type == SDC_HCI_MSG_TYPE_NONE) {
+			rx_hci_msg.msg = rx_msg_buf_get();
 
-	err = process_hci_msg(dev, &rx_hci_msg.buf[0], rx_hci_msg.type);
-	if (err == -ENOBUFS) {
-		/* If we got -ENOBUFS, wait for the signal from the host. */
-		return;
-	} else if (err) {
-		LOG_ERR("Unknown error when processing hci message %d", err);
-		k_panic();
+			if (fetch_hci_msg(rx_hci_msg.msg, &rx_hci_msg.type) != 0) {
+				rx_stats_update(msg_cnt);
+				return;
+			}
+		}
+
+		err = process_hci_msg(dev, rx_hci_msg.msg, rx_hci_msg.type);
+		if (err == -ENOBUFS) {
+			/* If we got -ENOBUFS, wait for the signal from the host. */
+			rx_stats_update(msg_cnt);
+			return;
+		} else if (err) {
+			LOG_ERR("Unknown error when processing hci message %d", err);
+			k_panic();
+		}
+
+		rx_acl_buf_update(rx_hci_msg.type);
+		rx_hci_msg.type = SDC_HCI_MSG_TYPE_NONE;
+		msg_cnt++;
 	}
 
-	rx_hci_msg.type = SDC_HCI_MSG_TYPE_NONE;
+	rx_stats_update(msg_cnt);
 
 	/* Let other threads of same priority run in between. */
 	receive_signal_raise();
@@ -1498,6 +1640,8 @@ static int hci_driver_close(const struct device *dev)
 
 	bt_buf_rx_freed_cb_set(NULL);
 
+	rx_acl_buf_release();
+
 	return err;
 }
 
@@ -1533,6 +1677,13 @@ static int hci_driver_init(const struct device *dev)
 		return err;
 	}
 
+#if defined(CONFIG_BT_CTLR_SDC_RX_STATS)
+	err = STATS_INIT_AND_REG(sdc_rx_stats, STATS_SIZE_32, "sdc_rx");
+	if (err) {
+		return err;
+	}
+#endif
+
 	return err;
 }
 
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/sys/util.h>
+#include <bluetooth/cs_de.h>
+#if defined(CONFIG_BT_RAS_RREQ)
+#include <bluetooth/services/ras.h>
+#endif
+
+#include "cs_de_internal.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
+
+/* Distance covered in one unit (0.5 ns) of the round-trip time difference, in micrometers.
+ * The round trip covers the distance twice.
+ */
+#define RTT_UNIT_UM 74948LL
+
+/* One full turn of a phase angle. */
+#define CS_DE_TURN (1L << 24)
+
+/* Largest input component for which the vector stays within int32_t during the iterations. */
+#define CORDIC_MAX_INPUT (1L << 29)
+
+/* Angles of the CORDIC iterations, atan(2^-i), in turns scaled by 2^24. */
+static const int32_t cordic_angles[] = {
+	2097152, 1238021, 654136, 332050, 166669, 83416, 41718, 20860,
+	10430,   5215,    2608,   1304,   652,    326,   163,   81,
+};
+
+static void iq_valid_set(struct cs_de_report *report, uint8_t ap, uint8_t channel)
+{
+	report->iq_valid[ap][channel / 32] |= BIT(channel % 32);
+}
+
+bool cs_de_iq_is_valid(const struct cs_de_report *report, uint8_t ap, uint8_t channel)
+{
+	return (report->iq_valid[ap][channel / 32] & BIT(channel % 32)) != 0;
+}
+
+/* Angle of a vector, in units of CS_DE_TURN, calculated with the vectoring mode of CORDIC. */
+static int32_t atan2_turns(int64_t y, int64_t x)
+{
+	int32_t angle = 0;
+	int32_t xi;
+	int32_t yi;
+
+	if ((x == 0) && (y == 0)) {
+		return 0;
+	}
+
+	/* Scale the vector down so that the CORDIC gain cannot overflow. */
+	while ((x > CORDIC_MAX_INPUT) || (x < -CORDIC_MAX_INPUT) ||
+	       (y > CORDIC_MAX_INPUT) || (y < -CORDIC_MAX_INPUT)) {
+		x /= 2;
+		y /= 2;
+	}
+
+	xi = (int32_t)x;
+	yi = (int32_t)y;
+
+	/* Rotate the vector into the right half-plane. */
+	if (xi < 0) {
+		int32_t tmp = xi;
+
+		if (yi >= 0) {
+			xi = yi;
+			yi = -tmp;
+			angle = CS_DE_TURN / 4;
+		} else {
+			xi = -yi;
+			yi = tmp;
+			angle = -(CS_DE_TURN / 4);
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(cordic_angles); i++) {
+		int32_t x_shift = xi >> i;
+		int32_t y_shift = yi >> i;
+
+		if (yi > 0) {
+			xi += y_shift;
+			yi -= x_shift;
+			angle += cordic_angles[i];
+		} else {
+			xi -= y_shift;
+			yi += x_shift;
+			angle -= cordic_angles[i];
+		}
+	}
+
+	return angle;
+}
+
+static int32_t phase_to_distance(int32_t phase_per_mhz)
+{
+	/* The phase decreases with frequency, one turn for every 150 m.
+	 * Distances are only unambiguous in half of that range.
+	 */
+	int32_t wrapped = -phase_per_mhz;
+
+	if (wrapped < -(CS_DE_TURN / 2)) {
+		wrapped += CS_DE_TURN;
+	} else if (wrapped >= CS_DE_TURN / 2) {
+		wrapped -= CS_DE_TURN;
+	}
+
+	if (wrapped < 0) {
+		return 0;
+	}
+
+	return (int32_t)(((int64_t)wrapped * CS_DE_PHASE_TURN_PER_MHZ_MM) / CS_DE_TURN);
+}
+
+static int32_t phase_slope_estimate(const struct cs_de_report *report, uint8_t ap)
+{
+	int64_t sum_i = 0;
+	int64_t sum_q = 0;
+	size_t pairs = 0;
+
+	/* The mean phase difference of neighboring channels is the angle of the sum of the
+	 * products of each tone and the conjugate of the tone below it. This weighs the
+	 * tones by their amplitude, needs no phase unwrapping and no sorting, as the tones
+	 * are already indexed by channel.
+	 */
+	for (uint8_t ch = 1; ch < CS_DE_NUM_CHANNELS; ch++) {
+		const struct cs_de_iq *a = &report->iq[ap][ch];
+		const struct cs_de_iq *b = &report->iq[ap][ch - 1];
+
+		if (!cs_de_iq_is_valid(report, ap, ch) || !cs_de_iq_is_valid(report, ap, ch - 1)) {
+			continue;
+		}
+
+		sum_i += (int64_t)a->i * b->i + (int64_t)a->q * b->q;
+		sum_q += (int64_t)a->q * b->i - (int64_t)a->i * b->q;
+		pairs++;
+	}
+
+	if ((pairs + 1) < CONFIG_BT_CS_DE_MIN_CHANNELS) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	return phase_to_distance(atan2_turns(sum_q, sum_i));
+}
+
+static int32_t rtt_estimate(const struct cs_de_report *report)
+{
+	int64_t distance_um;
+
+	if (report->rtt_count == 0) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	distance_um = ((int64_t)report->rtt_sum * RTT_UNIT_UM) / report->rtt_count;
+	if (distance_um < 0) {
+		return 0;
+	}
+
+	return (int32_t)(distance_um / 1000);
+}
+
+static void sort(int32_t *values, size_t count)
+{
+	/* Insertion sort, as there are at most a few values. */
+	for (size_t i = 1; i < count; i++) {
+		int32_t value = values[i];
+		size_t j = i;
+
+		while ((j > 0) && (values[j - 1] > value)) {
+			values[j] = values[j - 1];
+			j--;
+		}
+		values[j] = value;
+	}
+}
+
+int32_t cs_de_median(int32_t *values, size_t count)
+{
+	if (count == 0) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	sort(values, count);
+
+	if (count % 2) {
+		return values[count / 2];
+	}
+
+	return (int32_t)(((int64_t)values[count / 2 - 1] + values[count / 2]) / 2);
+}
+
+static int32_t paths_aggregate(const int32_t *path_values, uint8_t n_ap)
+{
+	int32_t values[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS];
+	size_t count = 0;
+
+	/* The median of the antenna paths suppresses a path that is in a fading dip. */
+	for (uint8_t ap = 0; ap < n_ap; ap++) {
+		if (path_values[ap] != CS_DE_DISTANCE_INVALID) {
+			values[count++] = path_values[ap];
+		}
+	}
+
+	return cs_de_median(values, count);
+}
+
+static uint8_t paths_used(const struct cs_de_report *report)
+{
+	return MIN(report->n_ap, CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS);
+}
+
+void cs_de_report_init(struct cs_de_report *report, uint8_t n_ap, enum bt_conn_le_cs_role role)
+{
+	memset(report, 0, sizeof(*report));
+
+	report->n_ap = n_ap;
+	report->role = role;
+
+	if (n_ap > CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS) {
+		LOG_WRN("Only %d of %d antenna paths are used", CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS,
+			n_ap);
+	}
+}
+
+static bool tone_is_valid(const struct bt_hci_le_cs_step_data_tone_info *tone_info)
+{
+	return (tone_info->extension_indicator == BT_HCI_LE_CS_NOT_TONE_EXT_SLOT) &&
+	       (tone_info->quality_indicator != BT_HCI_LE_CS_TONE_QUALITY_LOW) &&
+	       (tone_info->quality_indicator != BT_HCI_LE_CS_TONE_QUALITY_UNAVAILABLE);
+}
+
+static void tone_info_add(struct cs_de_report *report,
+			  const struct bt_hci_le_cs_step_data_tone_info local_tone_info[],
+			  const struct bt_hci_le_cs_step_data_tone_info peer_tone_info[],
+			  uint8_t channel, uint8_t antenna_permutation_index)
+{
+	if (channel >= CS_DE_NUM_CHANNELS) {
+		return;
+	}
+
+	for (uint8_t i = 0; i < report->n_ap; i++) {
+		struct bt_le_cs_iq_sample local;
+		struct bt_le_cs_iq_sample peer;
+		struct cs_de_iq *iq;
+		int antenna_path;
+
+		if (!tone_is_valid(&local_tone_info[i]) || !tone_is_valid(&peer_tone_info[i])) {
+			continue;
+		}
+
+		antenna_path = bt_le_cs_get_antenna_path(report->n_ap, antenna_permutation_index,
+							 i);
+		if (antenna_path < 0) {
+			LOG_WRN("Invalid antenna path");
+			continue;
+		}
+
+		if (antenna_path >= CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS) {
+			continue;
+		}
+
+		local = bt_le_cs_parse_pct(local_tone_info[i].phase_correction_term);
+		peer = bt_le_cs_parse_pct(peer_tone_info[i].phase_correction_term);
+
+		/* The product of both phase correction terms holds the phase of the
+		 * round trip, independent of the phase offsets of both devices.
+		 */
+		iq = &report->iq[antenna_path][channel];
+		iq->i += (int32_t)local.i * peer.i - (int32_t)local.q * peer.q;
+		iq->q += (int32_t)local.i * peer.q + (int32_t)local.q * peer.i;
+
+		iq_valid_set(report, antenna_path, channel);
+		report->tone_count[antenna_path]++;
+	}
+}
+
+static void rtt_timing_add(struct cs_de_report *report,
+			   const struct bt_hci_le_cs_step_data_mode_1 *local_rtt_data,
+			   const struct bt_hci_le_cs_step_data_mode_1 *peer_rtt_data)
+{
+	int16_t toa_tod_initiator;
+	int16_t tod_toa_reflector;
+
+	if (local_rtt_data->packet_quality_aa_check !=
+		    BT_HCI_LE_CS_PACKET_QUALITY_AA_CHECK_SUCCESSFUL ||
+	    local_rtt_data->packet_rssi == BT_HCI_LE_CS_PACKET_RSSI_NOT_AVAILABLE ||
+	    local_rtt_data->tod_toa_reflector == BT_HCI_LE_CS_TIME_DIFFERENCE_NOT_AVAILABLE ||
+	    peer_rtt_data->packet_quality_aa_check !=
+		    BT_HCI_LE_CS_PACKET_QUALITY_AA_CHECK_SUCCESSFUL ||
+	    peer_rtt_data->packet_rssi == BT_HCI_LE_CS_PACKET_RSSI_NOT_AVAILABLE ||
+	    peer_rtt_data->tod_toa_reflector == BT_HCI_LE_CS_TIME_DIFFERENCE_NOT_AVAILABLE) {
+		return;
+	}
+
+	if (report->role == BT_CONN_LE_CS_ROLE_INITIATOR) {
+		toa_tod_initiator = local_rtt_data->toa_tod_initiator;
+		tod_toa_reflector = peer_rtt_data->tod_toa_reflector;
+	} else {
+		tod_toa_reflector = local_rtt_data->tod_toa_reflector;
+		toa_tod_initiator = peer_rtt_data->toa_tod_initiator;
+	}
+
+	report->rtt_sum += toa_tod_initiator - tod_toa_reflector;
+	report->rtt_count++;
+}
+
+void cs_de_report_add_step(struct cs_de_report *report,
+			   const struct bt_le_cs_subevent_step *local_step,
+			   const struct bt_le_cs_subevent_step *peer_step)
+{
+	if (local_step->mode == BT_CONN_LE_CS_MAIN_MODE_2) {
+		const struct bt_hci_le_cs_step_data_mode_2 *local_step_data =
+			(const struct bt_hci_le_cs_step_data_mode_2 *)local_step->data;
+		const struct bt_hci_le_cs_step_data_mode_2 *peer_step_data =
+			(const struct bt_hci_le_cs_step_data_mode_2 *)peer_step->data;
+
+		tone_info_add(report, local_step_data->tone_info, peer_step_data->tone_info,
+			      local_step->channel, local_step_data->antenna_permutation_index);
+	} else if (local_step->mode == BT_HCI_OP_LE_CS_MAIN_MODE_1) {
+		rtt_timing_add(report,
+			       (const struct bt_hci_le_cs_step_data_mode_1 *)local_step->data,
+			       (const struct bt_hci_le_cs_step_data_mode_1 *)peer_step->data);
+	} else if (local_step->mode == BT_HCI_OP_LE_CS_MAIN_MODE_3) {
+		const struct bt_hci_le_cs_step_data_mode_3 *local_step_data =
+			(const struct bt_hci_le_cs_step_data_mode_3 *)local_step->data;
+		const struct bt_hci_le_cs_step_data_mode_3 *peer_step_data =
+			(const struct bt_hci_le_cs_step_data_mode_3 *)peer_step->data;
+
+		rtt_timing_add(report,
+			       (const struct bt_hci_le_cs_step_data_mode_1 *)local_step_data,
+			       (const struct bt_hci_le_cs_step_data_mode_1 *)peer_step_data);
+		tone_info_add(report, local_step_data->tone_info, peer_step_data->tone_info,
+			      local_step->channel, local_step_data->antenna_permutation_index);
+	}
+}
+
+#if defined(CONFIG_BT_RAS_RREQ)
+static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
+			      struct bt_le_cs_subevent_step *peer_step, void *user_data)
+{
+	cs_de_report_add_step(user_data, local_step, peer_step);
+
+	return true;
+}
+
+void cs_de_populate_report(struct net_buf_simple *local_steps,
+			   struct net_buf_simple *peer_steps, uint8_t n_ap,
+			   enum bt_conn_le_cs_role role, struct cs_de_report *report)
+{
+	cs_de_report_init(report, n_ap, role);
+
+	bt_ras_rreq_rd_subevent_data_parse(peer_steps, local_steps, role, NULL,
+					   process_step_data, report);
+}
+#endif /* CONFIG_BT_RAS_RREQ */
+
+enum cs_de_quality cs_de_calc(struct cs_de_report *report)
+{
+	int32_t phase_slope[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS];
+	int32_t ifft[CONFIG_BT_CS_DE_MAX_ANTENNA_PATHS];
+	uint8_t n_ap = paths_used(report);
+
+	for (uint8_t ap = 0; ap < n_ap; ap++) {
+		struct cs_de_dist_estimates *path = &report->path_estimates[ap];
+
+		path->phase_slope = IS_ENABLED(CONFIG_BT_CS_DE_PHASE_SLOPE) ?
+					    phase_slope_estimate(report, ap) :
+					    CS_DE_DISTANCE_INVALID;
+		path->ifft = IS_ENABLED(CONFIG_BT_CS_DE_IFFT) ? cs_de_ifft_estimate(report, ap) :
+								 CS_DE_DISTANCE_INVALID;
+		path->rtt = CS_DE_DISTANCE_INVALID;
+
+		phase_slope[ap] = path->phase_slope;
+		ifft[ap] = path->ifft;
+	}
+
+	report->estimates.phase_slope = paths_aggregate(phase_slope, n_ap);
+	report->estimates.ifft = paths_aggregate(ifft, n_ap);
+	report->estimates.rtt = IS_ENABLED(CONFIG_BT_CS_DE_RTT) ? rtt_estimate(report) :
+								  CS_DE_DISTANCE_INVALID;
+
+	if ((report->estimates.phase_slope == CS_DE_DISTANCE_INVALID) &&
+	    (report->estimates.ifft == CS_DE_DISTANCE_INVALID) &&
+	    (report->estimates.rtt == CS_DE_DISTANCE_INVALID)) {
+		return CS_DE_QUALITY_DO_NOT_USE;
+	}
+
+	return CS_DE_QUALITY_OK;
+}
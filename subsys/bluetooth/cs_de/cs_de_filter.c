@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <bluetooth/cs_de.h>
+
+#include "cs_de_internal.h"
+
+/* Fractional bits of the smoothed distance and of the smoothing factor. */
+#define FILTER_FRAC_BITS 8
+
+void cs_de_filter_init(struct cs_de_filter *filter)
+{
+	memset(filter, 0, sizeof(*filter));
+}
+
+int32_t cs_de_filter_update(struct cs_de_filter *filter, int32_t distance)
+{
+	int32_t values[CONFIG_BT_CS_DE_FILTER_WINDOW];
+	int64_t median;
+
+	if (distance == CS_DE_DISTANCE_INVALID) {
+		if (filter->count == 0) {
+			return CS_DE_DISTANCE_INVALID;
+		}
+
+		return (int32_t)(filter->smoothed >> FILTER_FRAC_BITS);
+	}
+
+	filter->window[filter->next] = distance;
+	filter->next = (filter->next + 1) % CONFIG_BT_CS_DE_FILTER_WINDOW;
+
+	/* The median is sorted in a copy, so that the window keeps the order of arrival. */
+	memcpy(values, filter->window, sizeof(values));
+	median = (int64_t)cs_de_median(values, MIN(filter->count + 1,
+						    CONFIG_BT_CS_DE_FILTER_WINDOW)) << FILTER_FRAC_BITS;
+
+	if (filter->count == 0) {
+		filter->smoothed = median;
+	} else {
+		filter->smoothed += ((median - filter->smoothed) * CONFIG_BT_CS_DE_FILTER_EMA_ALPHA) >>
+				    FILTER_FRAC_BITS;
+	}
+
+	if (filter->count < CONFIG_BT_CS_DE_FILTER_WINDOW) {
+		filter->count++;
+	}
+
+	return (int32_t)(filter->smoothed >> FILTER_FRAC_BITS);
+}
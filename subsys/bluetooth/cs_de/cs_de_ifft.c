@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <arm_math.h>
+#include <zephyr/sys/util.h>
+#include <bluetooth/cs_de.h>
+
+#include "cs_de_internal.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
+
+#define IFFT_SIZE CONFIG_BT_CS_DE_IFFT_SIZE
+
+/* Largest magnitude of an input component. It leaves headroom for the CFFT. */
+#define IFFT_INPUT_MAX BIT(30)
+
+BUILD_ASSERT(IFFT_SIZE >= CS_DE_NUM_CHANNELS, "IFFT must cover all channels");
+
+/* Interleaved real and imaginary parts, transformed in place. */
+static q31_t ifft_buf[2 * IFFT_SIZE];
+static q31_t magnitude[IFFT_SIZE];
+
+static void ifft_input_load(const struct cs_de_report *report, uint8_t ap)
+{
+	uint32_t max = 0;
+	int shift;
+
+	for (uint8_t ch = 0; ch < CS_DE_NUM_CHANNELS; ch++) {
+		if (cs_de_iq_is_valid(report, ap, ch)) {
+			max = MAX(max, (uint32_t)abs(report->iq[ap][ch].i));
+			max = MAX(max, (uint32_t)abs(report->iq[ap][ch].q));
+		}
+	}
+
+	/* Scale the tones so that the largest component uses the full range of the input. */
+	shift = (max == 0) ? 0 : (__builtin_clz(max) - __builtin_clz(IFFT_INPUT_MAX));
+
+	memset(ifft_buf, 0, sizeof(ifft_buf));
+
+	/* Channel index k is at 2402 + k MHz, so the tones are already equally spaced and
+	 * channels without a valid tone are left at zero.
+	 */
+	for (uint8_t ch = 0; ch < CS_DE_NUM_CHANNELS; ch++) {
+		const struct cs_de_iq *iq = &report->iq[ap][ch];
+
+		if (!cs_de_iq_is_valid(report, ap, ch)) {
+			continue;
+		}
+
+		if (shift >= 0) {
+			ifft_buf[2 * ch] = (q31_t)((uint32_t)iq->i << shift);
+			ifft_buf[2 * ch + 1] = (q31_t)((uint32_t)iq->q << shift);
+		} else {
+			ifft_buf[2 * ch] = iq->i >> -shift;
+			ifft_buf[2 * ch + 1] = iq->q >> -shift;
+		}
+	}
+}
+
+/* Offset of the true peak from bin i, in 1/256 bins, from a parabola through three bins. */
+static int32_t peak_offset_q8(int32_t i)
+{
+	int64_t left = magnitude[(i + IFFT_SIZE - 1) % IFFT_SIZE];
+	int64_t center = magnitude[i];
+	int64_t right = magnitude[(i + 1) % IFFT_SIZE];
+	int64_t curvature = left - 2 * center + right;
+	int64_t offset;
+
+	if (curvature >= 0) {
+		return 0;
+	}
+
+	offset = ((left - right) * 128) / curvature;
+
+	return (int32_t)CLAMP(offset, -128, 128);
+}
+
+int32_t cs_de_ifft_estimate(const struct cs_de_report *report, uint8_t ap)
+{
+	arm_cfft_instance_q31 cfft;
+	q31_t threshold;
+	q31_t peak = 0;
+	int32_t first_path = -1;
+	int32_t position;
+	size_t channels = 0;
+
+	for (uint8_t ch = 0; ch < CS_DE_NUM_CHANNELS; ch++) {
+		if (cs_de_iq_is_valid(report, ap, ch)) {
+			channels++;
+		}
+	}
+
+	if (channels < CONFIG_BT_CS_DE_MIN_CHANNELS) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	if (arm_cfft_init_q31(&cfft, IFFT_SIZE) != ARM_MATH_SUCCESS) {
+		LOG_ERR("Unsupported IFFT size");
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	ifft_input_load(report, ap);
+
+	/* The inverse transform of the channel frequency response is the impulse response,
+	 * where bin n is at a distance of n * c / (2 * IFFT_SIZE * 1 MHz).
+	 */
+	arm_cfft_q31(&cfft, ifft_buf, 1, 1);
+	arm_cmplx_mag_q31(ifft_buf, magnitude, IFFT_SIZE);
+
+	/* Only the first half of the bins holds unambiguous distances. */
+	for (int32_t i = 0; i < IFFT_SIZE / 2; i++) {
+		peak = MAX(peak, magnitude[i]);
+	}
+
+	if (peak == 0) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	/* In multipath conditions the strongest path is not necessarily the direct one.
+	 * The direct path is the earliest local maximum that is strong enough not to be
+	 * a sidelobe of a later path.
+	 */
+	threshold = (q31_t)(((int64_t)peak * CONFIG_BT_CS_DE_IFFT_FIRST_PATH_THRESHOLD) / 100);
+
+	for (int32_t i = 0; i < IFFT_SIZE / 2; i++) {
+		q31_t left = magnitude[(i + IFFT_SIZE - 1) % IFFT_SIZE];
+		q31_t right = magnitude[i + 1];
+
+		if ((magnitude[i] >= threshold) && (magnitude[i] >= left) &&
+		    (magnitude[i] >= right)) {
+			first_path = i;
+			break;
+		}
+	}
+
+	if (first_path < 0) {
+		return CS_DE_DISTANCE_INVALID;
+	}
+
+	position = first_path * 256 + peak_offset_q8(first_path);
+	if (position < 0) {
+		return 0;
+	}
+
+	return (int32_t)(((int64_t)position * CS_DE_PHASE_TURN_PER_MHZ_MM) / (IFFT_SIZE * 256));
+}
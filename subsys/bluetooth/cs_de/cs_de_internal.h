@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CS_DE_INTERNAL_H_
+#define CS_DE_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <bluetooth/cs_de.h>
+
+/* Distance covered by a phase rotation of one turn per MHz of tone spacing,
+ * that is c / (2 * 1 MHz), in millimeters. This is also the range covered by
+ * the channel impulse response of tones spaced by 1 MHz.
+ */
+#define CS_DE_PHASE_TURN_PER_MHZ_MM 149896LL
+
+/* Check if the report holds a valid tone for a given antenna path and channel. */
+bool cs_de_iq_is_valid(const struct cs_de_report *report, uint8_t ap, uint8_t channel);
+
+/* Calculate the median of values. The values are sorted in place. */
+int32_t cs_de_median(int32_t *values, size_t count);
+
+/* Estimate the distance on a given antenna path from the channel impulse response. */
+int32_t cs_de_ifft_estimate(const struct cs_de_report *report, uint8_t ap);
+
+#endif /* CS_DE_INTERNAL_H_ */
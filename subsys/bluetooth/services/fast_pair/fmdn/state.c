@@ -90,6 +90,11 @@ LOG_MODULE_REGISTER(fp_fmdn_state, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 /* Constants used in Elliptic Curve calculation. */
 #define SECP_MOD_RES_LEN FP_FMDN_STATE_EID_LEN
 
+/* Time in seconds before the start of the next EID rotation period in which the next EID
+ * is calculated in advance.
+ */
+#define FMDN_EID_PRECOMPUTE_LEAD_TIME 60
+
 /* Constants used for Unwanted Tracking Protection mode. */
 #define UTP_EID_ROTATIONS_PER_RPA_ROTATION 85 /* 85 * 1024s = 87040s ~ 1451m ~ 24h11m */
 
@@ -137,6 +142,14 @@ static uint8_t fmdn_frame_hashed_flags_xor_operand;
 static uint8_t * const fmdn_eid = (fmdn_frame_payload + FMDN_FRAME_EID_OFFSET);
 static uint32_t fmdn_eid_clock_checkpoint;
 
+/* EID of the next rotation period calculated in advance. */
+static struct {
+	uint8_t eid[FP_FMDN_STATE_EID_LEN];
+	uint8_t hashed_flags_xor_operand;
+	uint32_t fmdn_clock;
+	bool is_valid;
+} fmdn_eid_next;
+
 static bool utp_mode;
 static bool utp_mode_rpa_change_request;
 static uint8_t utp_mode_control_flags;
@@ -149,9 +162,11 @@ static bool fmdn_conns[CONFIG_BT_MAX_CONN];
 
 static void fmdn_disconnected_work_handle(struct k_work *work);
 static void fmdn_post_init_work_handle(struct k_work *work);
+static void fmdn_eid_precompute_work_handle(struct k_work *work);
 
 static K_WORK_DEFINE(fmdn_disconnected_work, fmdn_disconnected_work_handle);
 static K_WORK_DEFINE(fmdn_post_init_work, fmdn_post_init_work_handle);
+static K_WORK_DELAYABLE_DEFINE(fmdn_eid_precompute_work, fmdn_eid_precompute_work_handle);
 
 static int fmdn_adv_start(void);
 
@@ -168,34 +183,16 @@ static void eid_seed_half_encode(struct net_buf_simple *buf,
 	net_buf_simple_add_be32(buf, fmdn_clock);
 }
 
-static int eid_encode(void)
+static int eid_calculate(uint32_t fmdn_clock, uint8_t *eid, uint8_t *hashed_flags_xor_operand)
 {
 	int err;
-	uint32_t fmdn_clock;
 	uint8_t eik[FP_STORAGE_EIK_LEN];
 	uint8_t encrypted_eid_seed[FP_CRYPTO_AES256_BLOCK_LEN];
-	const uint8_t uninitialized_eid[FP_FMDN_STATE_EID_LEN] = {};
 	uint8_t secp_mod_res[SECP_MOD_RES_LEN];
 	uint8_t mod_res_hash[FP_CRYPTO_SHA256_HASH_LEN];
 
 	NET_BUF_SIMPLE_DEFINE(eid_seed_buf, FMDN_EID_SEED_LEN);
 
-	/* Prepare the FMDN Clock value. */
-	fmdn_clock = fp_fmdn_clock_read();
-
-	/* Clear the K lowest bits in the clock value. */
-	fmdn_clock &= ~BIT_MASK(FMDN_EID_SEED_ROT_PERIOD_EXP);
-
-	/* Check if the EID seed or EIK has changed since the last call. */
-	if (memcmp(fmdn_eid, uninitialized_eid, sizeof(uninitialized_eid)) != 0) {
-		if (fmdn_clock == fmdn_eid_clock_checkpoint) {
-			LOG_DBG("FMDN State: EID does not require recalculation");
-
-			return 0;
-		}
-	}
-	fmdn_eid_clock_checkpoint = fmdn_clock;
-
 	/* Prepare the EID seed data. */
 	eid_seed_half_encode(&eid_seed_buf,
 			     FMDN_EID_SEED_PADDING_TYPE_ONE,
@@ -231,7 +228,7 @@ static int eid_encode(void)
 
 	/* Calculate the EID as the x coordinate of a point on the elliptic curve. */
 	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FMDN_ECC_SECP160R1)) {
-		err = fp_crypto_ecc_secp160r1_calculate(fmdn_eid,
+		err = fp_crypto_ecc_secp160r1_calculate(eid,
 							secp_mod_res,
 							encrypted_eid_seed,
 							sizeof(encrypted_eid_seed));
@@ -242,7 +239,7 @@ static int eid_encode(void)
 			return err;
 		}
 	} else if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FMDN_ECC_SECP256R1)) {
-		err = fp_crypto_ecc_secp256r1_calculate(fmdn_eid,
+		err = fp_crypto_ecc_secp256r1_calculate(eid,
 							secp_mod_res,
 							encrypted_eid_seed,
 							sizeof(encrypted_eid_seed));
@@ -256,7 +253,7 @@ static int eid_encode(void)
 		__ASSERT(0, "ECC selection not supported");
 	}
 
-	LOG_HEXDUMP_DBG(fmdn_eid, FP_FMDN_STATE_EID_LEN, "EID:");
+	LOG_HEXDUMP_DBG(eid, FP_FMDN_STATE_EID_LEN, "EID:");
 
 	/* Calculate the XOR operand for the Hashed Flags bitmask. */
 	err = fp_crypto_sha256(mod_res_hash, secp_mod_res, sizeof(secp_mod_res));
@@ -266,7 +263,105 @@ static int eid_encode(void)
 		return err;
 	}
 
-	fmdn_frame_hashed_flags_xor_operand = mod_res_hash[sizeof(mod_res_hash) - 1];
+	*hashed_flags_xor_operand = mod_res_hash[sizeof(mod_res_hash) - 1];
+
+	return 0;
+}
+
+static void eid_precompute_reset(void)
+{
+	(void) k_work_cancel_delayable(&fmdn_eid_precompute_work);
+
+	memset(&fmdn_eid_next, 0, sizeof(fmdn_eid_next));
+}
+
+static void eid_precompute_schedule(uint32_t fmdn_clock)
+{
+	uint32_t next_fmdn_clock;
+	uint32_t fmdn_clock_now;
+	uint32_t delay;
+
+	if (!IS_ENABLED(CONFIG_BT_FAST_PAIR_FMDN_EID_PRECOMPUTE)) {
+		return;
+	}
+
+	next_fmdn_clock = fmdn_clock + BIT(FMDN_EID_SEED_ROT_PERIOD_EXP);
+	if (fmdn_eid_next.is_valid && (fmdn_eid_next.fmdn_clock == next_fmdn_clock)) {
+		return;
+	}
+
+	fmdn_eid_next.is_valid = false;
+	fmdn_eid_next.fmdn_clock = next_fmdn_clock;
+
+	/* The next rotation takes place after the start of the next EID rotation period. */
+	fmdn_clock_now = fp_fmdn_clock_read();
+	delay = (next_fmdn_clock > (fmdn_clock_now + FMDN_EID_PRECOMPUTE_LEAD_TIME)) ?
+		(next_fmdn_clock - fmdn_clock_now - FMDN_EID_PRECOMPUTE_LEAD_TIME) : 0;
+
+	(void) k_work_reschedule(&fmdn_eid_precompute_work, K_SECONDS(delay));
+
+	LOG_DBG("FMDN State: next EID calculation in %u [s]", delay);
+}
+
+static void fmdn_eid_precompute_work_handle(struct k_work *work)
+{
+	int err;
+
+	ARG_UNUSED(work);
+
+	if (!is_enabled || !bt_fast_pair_fmdn_is_provisioned()) {
+		return;
+	}
+
+	err = eid_calculate(fmdn_eid_next.fmdn_clock,
+			    fmdn_eid_next.eid,
+			    &fmdn_eid_next.hashed_flags_xor_operand);
+	if (err) {
+		/* The EID is calculated on the rotation instead. */
+		LOG_WRN("FMDN State: EID calculation in advance failed: %d", err);
+		return;
+	}
+
+	fmdn_eid_next.is_valid = true;
+}
+
+static int eid_encode(void)
+{
+	int err;
+	uint32_t fmdn_clock;
+	const uint8_t uninitialized_eid[FP_FMDN_STATE_EID_LEN] = {};
+
+	/* Prepare the FMDN Clock value. */
+	fmdn_clock = fp_fmdn_clock_read();
+
+	/* Clear the K lowest bits in the clock value. */
+	fmdn_clock &= ~BIT_MASK(FMDN_EID_SEED_ROT_PERIOD_EXP);
+
+	/* Check if the EID seed or EIK has changed since the last call. */
+	if (memcmp(fmdn_eid, uninitialized_eid, sizeof(uninitialized_eid)) != 0) {
+		if (fmdn_clock == fmdn_eid_clock_checkpoint) {
+			LOG_DBG("FMDN State: EID does not require recalculation");
+
+			return 0;
+		}
+	}
+
+	if (fmdn_eid_next.is_valid && (fmdn_eid_next.fmdn_clock == fmdn_clock)) {
+		/* Use the EID calculated in advance. */
+		memcpy(fmdn_eid, fmdn_eid_next.eid, FP_FMDN_STATE_EID_LEN);
+		fmdn_frame_hashed_flags_xor_operand = fmdn_eid_next.hashed_flags_xor_operand;
+
+		LOG_DBG("FMDN State: using EID calculated in advance");
+	} else {
+		err = eid_calculate(fmdn_clock, fmdn_eid, &fmdn_frame_hashed_flags_xor_operand);
+		if (err) {
+			return err;
+		}
+	}
+
+	fmdn_eid_clock_checkpoint = fmdn_clock;
+
+	eid_precompute_schedule(fmdn_clock);
 
 	return 0;
 }
@@ -1002,6 +1097,7 @@ static int fmdn_storage_unprovision(void)
 	}
 
 	memset(fmdn_eid, 0, FP_FMDN_STATE_EID_LEN);
+	eid_precompute_reset();
 
 	return 0;
 }
@@ -1047,6 +1143,7 @@ static int fmdn_storage_provision(const uint8_t *eik)
 	}
 
 	memset(fmdn_eid, 0, FP_FMDN_STATE_EID_LEN);
+	eid_precompute_reset();
 
 	return 0;
 }
@@ -1316,6 +1413,9 @@ int fp_fmdn_state_uninit(void)
 	/* Cancel the work for the provisioning_state_changed callback. */
 	(void) k_work_cancel(&fmdn_post_init_work);
 
+	/* Drop the EID calculated in advance. */
+	eid_precompute_reset();
+
 	LOG_DBG("FMDN State: disabled");
 
 	return 0;
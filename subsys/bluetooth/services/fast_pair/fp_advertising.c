@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <zephyr/kernel.h>
 #include <zephyr/net_buf.h>
 #include <zephyr/random/random.h>
 #include <zephyr/bluetooth/bluetooth.h>
@@ -14,6 +15,7 @@ LOG_MODULE_DECLARE(fast_pair, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 
 #include <bluetooth/services/fast_pair/fast_pair.h>
 #include <bluetooth/services/fast_pair/uuid.h>
+#include "fp_activation.h"
 #include "fp_battery.h"
 #include "fp_common.h"
 #include "fp_crypto.h"
@@ -30,6 +32,8 @@ LOG_MODULE_DECLARE(fast_pair, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 #define ENCODE_FIELD_BATTERY_STATUS_LEVEL(charging, level) \
 	(((charging ? 1 : 0) << BATTERY_LEVEL_BITS) | (level))
 
+#define AK_FILTER_SIZE_MAX			BIT_MASK(LEN_BITS)
+
 enum fp_field_type {
 	FP_FIELD_TYPE_SHOW_PAIRING_UI_INDICATION = 0b0000,
 	FP_FIELD_TYPE_SALT			 = 0b0001,
@@ -38,10 +42,31 @@ enum fp_field_type {
 	FP_FIELD_TYPE_HIDE_BATTERY_UI_INDICATION = 0b0100,
 };
 
+/* Account Key Filter calculated in advance for the next advertising data. The Salt must change
+ * on every advertising data update, so the filter is used at most once. The Account Keys used
+ * for the filter are identified by the generation of the Account Key storage.
+ */
+struct ak_filter_prepared {
+	bool valid;
+	bool has_battery_info;
+	uint8_t battery_info[FP_CRYPTO_BATTERY_INFO_LEN];
+	uint32_t ak_generation;
+	size_t ak_cnt;
+	uint16_t salt;
+	uint8_t filter[AK_FILTER_SIZE_MAX];
+};
+
 static const uint16_t fast_pair_uuid = BT_FAST_PAIR_UUID_FPS_VAL;
 static const uint8_t version_and_flags;
 static const uint8_t empty_account_key_list;
 
+static struct ak_filter_prepared
+	ak_filter_prepared[IS_ENABLED(CONFIG_BT_FAST_PAIR_ADV_DATA_PREPARE) ? 1 : 0];
+
+static void ak_filter_prepare_work_handle(struct k_work *work);
+
+static K_WORK_DEFINE(ak_filter_prepare_work, ak_filter_prepare_work_handle);
+
 static int check_adv_config(struct bt_fast_pair_adv_config fp_adv_config)
 {
 	if ((fp_adv_config.mode >= BT_FAST_PAIR_ADV_MODE_COUNT) || (fp_adv_config.mode < 0)) {
@@ -179,6 +204,106 @@ static void fp_adv_data_fill_battery_info(uint8_t *battery_info,
 	}
 }
 
+static void ak_filter_prepared_clear(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(ak_filter_prepared); i++) {
+		memset(&ak_filter_prepared[i], 0, sizeof(ak_filter_prepared[i]));
+	}
+}
+
+static bool ak_filter_prepared_take(uint8_t *filter, uint16_t *salt, size_t ak_cnt,
+				    const uint8_t *battery_info)
+{
+	struct ak_filter_prepared *prepared;
+	bool match;
+
+	if (ARRAY_SIZE(ak_filter_prepared) == 0) {
+		return false;
+	}
+
+	prepared = &ak_filter_prepared[0];
+	if (!prepared->valid) {
+		return false;
+	}
+
+	/* The filter can be used only if none of its inputs other than the Salt has changed. */
+	match = (prepared->ak_cnt == ak_cnt) &&
+		(prepared->ak_generation == fp_storage_ak_generation_get()) &&
+		(prepared->has_battery_info == (battery_info != NULL)) &&
+		(!battery_info ||
+		 (memcmp(prepared->battery_info, battery_info, FP_CRYPTO_BATTERY_INFO_LEN) == 0));
+
+	if (match) {
+		memcpy(filter, prepared->filter, fp_crypto_account_key_filter_size(ak_cnt));
+		*salt = prepared->salt;
+	}
+
+	ak_filter_prepared_clear();
+
+	return match;
+}
+
+static void ak_filter_prepare_request(const uint8_t *battery_info)
+{
+	struct ak_filter_prepared *prepared;
+
+	if (ARRAY_SIZE(ak_filter_prepared) == 0) {
+		return;
+	}
+
+	prepared = &ak_filter_prepared[0];
+
+	/* Assume that the next advertising data uses the same battery info. */
+	prepared->has_battery_info = (battery_info != NULL);
+	if (battery_info) {
+		memcpy(prepared->battery_info, battery_info, FP_CRYPTO_BATTERY_INFO_LEN);
+	}
+
+	(void) k_work_submit(&ak_filter_prepare_work);
+}
+
+static void ak_filter_prepare_work_handle(struct k_work *work)
+{
+	struct fp_account_key ak[CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX];
+	struct ak_filter_prepared *prepared;
+	int err;
+
+	ARG_UNUSED(work);
+
+	if ((ARRAY_SIZE(ak_filter_prepared) == 0) || !bt_fast_pair_is_ready()) {
+		return;
+	}
+
+	prepared = &ak_filter_prepared[0];
+	prepared->valid = false;
+	prepared->ak_cnt = ARRAY_SIZE(ak);
+	/* Read before the keys, so that a key written meanwhile invalidates the filter. */
+	prepared->ak_generation = fp_storage_ak_generation_get();
+
+	err = fp_storage_ak_get(ak, &prepared->ak_cnt);
+	if (err || (prepared->ak_cnt == 0)) {
+		return;
+	}
+
+	err = sys_csrand_get(&prepared->salt, sizeof(prepared->salt));
+	if (err) {
+		return;
+	}
+
+	__ASSERT_NO_MSG(fp_crypto_account_key_filter_size(prepared->ak_cnt) <=
+			sizeof(prepared->filter));
+	err = fp_crypto_account_key_filter(prepared->filter, ak, prepared->ak_cnt,
+					   prepared->salt,
+					   prepared->has_battery_info ?
+					   prepared->battery_info : NULL);
+	if (err) {
+		LOG_WRN("Failed to prepare Account Key Filter (err %d)", err);
+		return;
+	}
+
+	prepared->valid = true;
+}
+
 static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t account_key_cnt,
 					     enum fp_field_type ak_filter_type,
 					     enum bt_fast_pair_adv_battery_mode adv_battery_mode)
@@ -207,14 +332,11 @@ static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t
 		struct fp_account_key ak[CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX];
 		size_t ak_filter_size = fp_crypto_account_key_filter_size(account_key_cnt);
 		size_t account_key_get_cnt = account_key_cnt;
+
+		uint8_t *ak_filter;
 		uint16_t salt;
 		int err;
 
-		err = sys_csrand_get(&salt, sizeof(salt));
-		if (err) {
-			return err;
-		}
-
 		err = fp_storage_ak_get(ak, &account_key_get_cnt);
 		if (err) {
 			return err;
@@ -226,18 +348,29 @@ static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t
 
 		BUILD_ASSERT(sizeof(uint8_t) == FIELD_LEN_TYPE_SIZE);
 
-		__ASSERT_NO_MSG(ak_filter_size <= BIT_MASK(LEN_BITS));
+		__ASSERT_NO_MSG(ak_filter_size <= AK_FILTER_SIZE_MAX);
 		net_buf_simple_add_u8(buf, ENCODE_FIELD_LEN_TYPE(ak_filter_size, ak_filter_type));
-
-		err = fp_crypto_account_key_filter(net_buf_simple_add(buf, ak_filter_size), ak,
-						   account_key_cnt, salt,
-						   add_battery_info ? battery_info : NULL);
-		if (err) {
-			return err;
+		ak_filter = net_buf_simple_add(buf, ak_filter_size);
+
+		if (!ak_filter_prepared_take(ak_filter, &salt, account_key_cnt,
+					     add_battery_info ? battery_info : NULL)) {
+			err = sys_csrand_get(&salt, sizeof(salt));
+			if (err) {
+				return err;
+			}
+
+			err = fp_crypto_account_key_filter(ak_filter, ak, account_key_cnt, salt,
+							   add_battery_info ? battery_info : NULL);
+			if (err) {
+				return err;
+			}
 		}
 
 		net_buf_simple_add_u8(buf, ENCODE_FIELD_LEN_TYPE(sizeof(salt), FP_FIELD_TYPE_SALT));
 		net_buf_simple_add_be16(buf, salt);
+
+		/* Prepare the filter for the next advertising data update in the background. */
+		ak_filter_prepare_request(add_battery_info ? battery_info : NULL);
 	}
 
 	if (add_battery_info) {
@@ -315,3 +448,19 @@ int bt_fast_pair_adv_data_fill(struct bt_data *bt_adv_data, uint8_t *buf, size_t
 
 	return err;
 }
+
+static int fp_advertising_init(void)
+{
+	return 0;
+}
+
+static int fp_advertising_uninit(void)
+{
+	(void) k_work_cancel(&ak_filter_prepare_work);
+	ak_filter_prepared_clear();
+
+	return 0;
+}
+
+FP_ACTIVATION_MODULE_REGISTER(fp_advertising, FP_ACTIVATION_INIT_PRIORITY_DEFAULT,
+			      fp_advertising_init, fp_advertising_uninit);
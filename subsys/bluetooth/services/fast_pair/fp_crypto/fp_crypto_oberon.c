@@ -14,6 +14,7 @@
 #include <ocrypto_ecdh_p256.h>
 #include <ocrypto_secp160r1.h>
 
+#include <string.h>
 #include <zephyr/sys/byteorder.h>
 
 #include <zephyr/logging/log.h>
@@ -65,6 +66,28 @@ int fp_crypto_aes128_ecb_decrypt(uint8_t *out, const uint8_t *in, const uint8_t
 	return 0;
 }
 
+int fp_crypto_aes128_ecb_dec_key_prepare(struct fp_crypto_aes128_ecb_dec_key *dec_key,
+					 const uint8_t *k)
+{
+	/* The Oberon ECB API does not accept an expanded key, so only the key is stored. */
+	memcpy(dec_key->key, k, sizeof(dec_key->key));
+
+	return 0;
+}
+
+int fp_crypto_aes128_ecb_dec_key_decrypt(uint8_t *out, const uint8_t *in,
+					 const struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	return fp_crypto_aes128_ecb_decrypt(out, in, dec_key->key);
+}
+
+int fp_crypto_aes128_ecb_dec_key_release(struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	memset(dec_key, 0, sizeof(*dec_key));
+
+	return 0;
+}
+
 int fp_crypto_aes256_ecb_encrypt(uint8_t *out, const uint8_t *in, const uint8_t *k)
 {
 	ocrypto_aes_ecb_encrypt(out, in, FP_CRYPTO_AES256_BLOCK_LEN, k, FP_CRYPTO_AES256_KEY_LEN);
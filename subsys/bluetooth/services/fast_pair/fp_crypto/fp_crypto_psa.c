@@ -191,6 +191,42 @@ int fp_crypto_aes128_ecb_decrypt(uint8_t *out, const uint8_t *in, const uint8_t
 	return fp_crypto_aes128_ecb_crypt(out, in, k, false);
 }
 
+int fp_crypto_aes128_ecb_dec_key_prepare(struct fp_crypto_aes128_ecb_dec_key *dec_key,
+					 const uint8_t *k)
+{
+	dec_key->key_id = import_aes128_key(k);
+	if (dec_key->key_id == PSA_KEY_ID_NULL) {
+		LOG_ERR("import_aes128_key failed");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int fp_crypto_aes128_ecb_dec_key_decrypt(uint8_t *out, const uint8_t *in,
+					 const struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	return fp_crypto_psa_aes128_ecb_crypt(out, in, dec_key->key_id, false);
+}
+
+int fp_crypto_aes128_ecb_dec_key_release(struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	psa_status_t status;
+
+	if (dec_key->key_id == PSA_KEY_ID_NULL) {
+		return 0;
+	}
+
+	status = psa_destroy_key(dec_key->key_id);
+	dec_key->key_id = PSA_KEY_ID_NULL;
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("psa_destroy_key failed (err: %d)", status);
+		return -ECANCELED;
+	}
+
+	return 0;
+}
+
 static psa_key_id_t import_ecdh_priv_key(const uint8_t *data)
 {
 	static const size_t len = 32;
@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include <tinycrypt/constants.h>
 #include <tinycrypt/sha256.h>
 #include <tinycrypt/hmac.h>
@@ -77,6 +78,30 @@ int fp_crypto_aes128_ecb_decrypt(uint8_t *out, const uint8_t *in, const uint8_t
 	return 0;
 }
 
+int fp_crypto_aes128_ecb_dec_key_prepare(struct fp_crypto_aes128_ecb_dec_key *dec_key,
+					 const uint8_t *k)
+{
+	if (tc_aes128_set_decrypt_key(&dec_key->sched, k) != TC_CRYPTO_SUCCESS) {
+		return -EINVAL;
+	}
+	return 0;
+}
+
+int fp_crypto_aes128_ecb_dec_key_decrypt(uint8_t *out, const uint8_t *in,
+					 const struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	if (tc_aes_decrypt(out, in, &dec_key->sched) != TC_CRYPTO_SUCCESS) {
+		return -EINVAL;
+	}
+	return 0;
+}
+
+int fp_crypto_aes128_ecb_dec_key_release(struct fp_crypto_aes128_ecb_dec_key *dec_key)
+{
+	memset(dec_key, 0, sizeof(*dec_key));
+	return 0;
+}
+
 int fp_crypto_ecdh_shared_secret(uint8_t *secret_key, const uint8_t *public_key,
 				 const uint8_t *private_key)
 {
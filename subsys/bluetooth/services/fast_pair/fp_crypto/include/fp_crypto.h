@@ -9,6 +9,12 @@
 
 #include <zephyr/types.h>
 
+#if defined(CONFIG_BT_FAST_PAIR_CRYPTO_TINYCRYPT)
+#include <tinycrypt/aes.h>
+#elif defined(CONFIG_BT_FAST_PAIR_CRYPTO_PSA)
+#include <psa/crypto.h>
+#endif
+
 #include "fp_common.h"
 
 /**
@@ -97,6 +103,53 @@ int fp_crypto_aes128_ecb_encrypt(uint8_t *out, const uint8_t *in, const uint8_t
  */
 int fp_crypto_aes128_ecb_decrypt(uint8_t *out, const uint8_t *in, const uint8_t *k);
 
+/** AES-128-ECB decryption key prepared for repeated use.
+ *
+ * The content depends on the cryptographic backend. It holds the expanded key schedule for
+ * Tinycrypt, the identifier of an imported volatile key for PSA, and the raw key for Oberon.
+ */
+struct fp_crypto_aes128_ecb_dec_key {
+#if defined(CONFIG_BT_FAST_PAIR_CRYPTO_TINYCRYPT)
+	struct tc_aes_key_sched_struct sched;
+#elif defined(CONFIG_BT_FAST_PAIR_CRYPTO_PSA)
+	psa_key_id_t key_id;
+#else
+	uint8_t key[FP_CRYPTO_AES128_KEY_LEN];
+#endif
+};
+
+/** Prepare AES-128-ECB decryption key.
+ *
+ * The prepared key must be released with @ref fp_crypto_aes128_ecb_dec_key_release when it is
+ * no longer needed.
+ *
+ * @param[out] dec_key Prepared decryption key.
+ * @param[in] k 128-bit (16-byte) AES key.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_crypto_aes128_ecb_dec_key_prepare(struct fp_crypto_aes128_ecb_dec_key *dec_key,
+					 const uint8_t *k);
+
+/** Decrypt message using AES-128-ECB and a prepared key.
+ *
+ * @param[out] out 128-bit (16-byte) buffer to receive plaintext message.
+ * @param[in] in 128-bit (16-byte) ciphertext message.
+ * @param[in] dec_key Decryption key prepared with @ref fp_crypto_aes128_ecb_dec_key_prepare.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_crypto_aes128_ecb_dec_key_decrypt(uint8_t *out, const uint8_t *in,
+					 const struct fp_crypto_aes128_ecb_dec_key *dec_key);
+
+/** Release AES-128-ECB decryption key and clear its content.
+ *
+ * @param[in,out] dec_key Decryption key prepared with @ref fp_crypto_aes128_ecb_dec_key_prepare.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_crypto_aes128_ecb_dec_key_release(struct fp_crypto_aes128_ecb_dec_key *dec_key);
+
 /** Encrypt data using AES-128-CTR.
  *
  * @param[out] out Buffer to receive encrypted data.
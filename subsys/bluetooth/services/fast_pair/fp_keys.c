@@ -58,6 +58,12 @@ struct fp_key_gen_account_key_check_context {
 	struct fp_keys_keygen_params *keygen_params;
 };
 
+struct ak_dec_key_cache_entry {
+	bool valid;
+	struct fp_account_key account_key;
+	struct fp_crypto_aes128_ecb_dec_key dec_key;
+};
+
 static uint8_t key_gen_failure_cnt;
 static void key_gen_failure_cnt_reset_fn(struct k_work *w);
 K_WORK_DELAYABLE_DEFINE(key_gen_failure_cnt_reset, key_gen_failure_cnt_reset_fn);
@@ -67,6 +73,13 @@ static struct fp_procedure fp_procedures[CONFIG_BT_MAX_CONN];
 
 static bool is_enabled;
 
+/* Every stored Account Key fits into the cache, so entries are only replaced when the Account
+ * Key List changes.
+ */
+static struct ak_dec_key_cache_entry
+	ak_dec_key_cache[IS_ENABLED(CONFIG_BT_FAST_PAIR_KEYS_AK_DEC_KEY_CACHE) ?
+			 CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX : 0];
+
 
 void bt_fast_pair_set_pairing_mode(bool pairing_mode)
 {
@@ -242,6 +255,119 @@ static int key_gen_public_key(const struct bt_conn *conn,
 	return err;
 }
 
+static void ak_dec_key_cache_entry_release(struct ak_dec_key_cache_entry *entry)
+{
+	int err;
+
+	if (!entry->valid) {
+		return;
+	}
+
+	err = fp_crypto_aes128_ecb_dec_key_release(&entry->dec_key);
+	if (err) {
+		LOG_WRN("Failed to release cached Account Key decryption key: %d", err);
+	}
+
+	memset(entry, 0, sizeof(*entry));
+}
+
+static void ak_dec_key_cache_clear(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(ak_dec_key_cache); i++) {
+		ak_dec_key_cache_entry_release(&ak_dec_key_cache[i]);
+	}
+}
+
+static void ak_dec_key_cache_sync(void)
+{
+	struct fp_account_key account_keys[CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX];
+	size_t account_key_cnt = ARRAY_SIZE(account_keys);
+	int err;
+
+	err = fp_storage_ak_get(account_keys, &account_key_cnt);
+	if (err) {
+		ak_dec_key_cache_clear();
+		return;
+	}
+
+	/* Drop the entries of Account Keys that are no longer stored. */
+	for (size_t i = 0; i < ARRAY_SIZE(ak_dec_key_cache); i++) {
+		struct ak_dec_key_cache_entry *entry = &ak_dec_key_cache[i];
+		bool stored = false;
+
+		if (!entry->valid) {
+			continue;
+		}
+
+		for (size_t j = 0; j < account_key_cnt; j++) {
+			if (!memcmp(entry->account_key.key, account_keys[j].key,
+				    sizeof(entry->account_key.key))) {
+				stored = true;
+				break;
+			}
+		}
+
+		if (!stored) {
+			ak_dec_key_cache_entry_release(entry);
+		}
+	}
+
+	memset(account_keys, 0, sizeof(account_keys));
+}
+
+static const struct fp_crypto_aes128_ecb_dec_key *ak_dec_key_get(
+	const struct fp_account_key *account_key)
+{
+	struct ak_dec_key_cache_entry *free_entry = NULL;
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(ak_dec_key_cache); i++) {
+		struct ak_dec_key_cache_entry *entry = &ak_dec_key_cache[i];
+
+		if (!entry->valid) {
+			if (!free_entry) {
+				free_entry = entry;
+			}
+			continue;
+		}
+
+		if (!memcmp(entry->account_key.key, account_key->key,
+			    sizeof(entry->account_key.key))) {
+			return &entry->dec_key;
+		}
+	}
+
+	if (!free_entry) {
+		return NULL;
+	}
+
+	err = fp_crypto_aes128_ecb_dec_key_prepare(&free_entry->dec_key, account_key->key);
+	if (err) {
+		LOG_WRN("Failed to prepare Account Key decryption key: %d", err);
+		return NULL;
+	}
+
+	free_entry->account_key = *account_key;
+	free_entry->valid = true;
+
+	return &free_entry->dec_key;
+}
+
+static int account_key_decrypt(const struct bt_conn *conn, uint8_t *out, const uint8_t *in,
+			       const struct fp_account_key *account_key)
+{
+	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_KEYS_AK_DEC_KEY_CACHE)) {
+		const struct fp_crypto_aes128_ecb_dec_key *dec_key = ak_dec_key_get(account_key);
+
+		if (dec_key) {
+			return fp_crypto_aes128_ecb_dec_key_decrypt(out, in, dec_key);
+		}
+	}
+
+	/* The Account Key is already assigned to the procedure. */
+	return fp_keys_decrypt(conn, out, in);
+}
+
 static bool key_gen_account_key_check(const struct fp_account_key *account_key, void *context)
 {
 	int err;
@@ -253,7 +379,7 @@ static bool key_gen_account_key_check(const struct fp_account_key *account_key,
 
 	memcpy(proc->aes_key, account_key->key, FP_ACCOUNT_KEY_LEN);
 
-	err = fp_keys_decrypt(conn, req, keygen_params->req_enc);
+	err = account_key_decrypt(conn, req, keygen_params->req_enc, account_key);
 	if (err) {
 		return false;
 	}
@@ -274,6 +400,10 @@ static int key_gen_account_key(const struct bt_conn *conn,
 		.keygen_params = keygen_params,
 	};
 
+	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_KEYS_AK_DEC_KEY_CACHE)) {
+		ak_dec_key_cache_sync();
+	}
+
 	/* This function call assigns the Account Key internally to the Fast Pair Keys
 	 * module. The assignment happens in the provided callback method.
 	 */
@@ -531,6 +661,8 @@ static int fp_keys_uninit(void)
 		ARG_UNUSED(ret);
 	}
 
+	ak_dec_key_cache_clear();
+
 	return 0;
 }
 
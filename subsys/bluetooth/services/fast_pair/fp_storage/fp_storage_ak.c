@@ -50,6 +50,11 @@ static uint8_t account_key_count;
 
 static uint8_t account_key_order[ACCOUNT_KEY_CNT];
 
+/* Changed on every write or removal of an Account Key. It is not reset with the RAM data, so that
+ * it never returns to a value seen before the reset.
+ */
+static uint32_t ak_generation;
+
 static int settings_set_err;
 static bool is_enabled;
 
@@ -124,6 +129,7 @@ static int fp_settings_load_ak(const char *name, size_t len, settings_read_cb re
 
 	account_key_list[index] = data.account_key;
 	account_key_metadata[index] = data.account_key_metadata;
+	ak_generation++;
 
 	return 0;
 }
@@ -567,6 +573,11 @@ int fp_storage_ak_get(struct fp_account_key *buf, size_t *key_count)
 	return 0;
 }
 
+uint32_t fp_storage_ak_generation_get(void)
+{
+	return ak_generation;
+}
+
 int fp_storage_ak_find(struct fp_account_key *account_key,
 		       fp_storage_ak_check_cb account_key_check_cb, void *context)
 {
@@ -578,7 +589,12 @@ int fp_storage_ak_find(struct fp_account_key *account_key,
 		return -EINVAL;
 	}
 
-	for (size_t i = 0; i < account_key_count; i++) {
+	/* Check the most recently used Account Keys first, as the Fast Pair Seeker that used
+	 * the Provider recently is the most likely one to use it again.
+	 */
+	for (size_t order_idx = 0; order_idx < account_key_count; order_idx++) {
+		size_t i = account_key_id_to_idx(account_key_order[order_idx]);
+
 		if (account_key_check_cb(&account_key_list[i], context)) {
 			int err;
 
@@ -732,6 +748,7 @@ int fp_storage_ak_save(const struct fp_account_key *account_key, const void *con
 	} else {
 		ak_overwritten = true;
 	}
+	ak_generation++;
 
 	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_STORAGE_AK_BOND)) {
 		/* Procedure finished successfully. Setting conn_ctx to NULL. */
@@ -970,6 +987,7 @@ void fp_storage_ak_ram_clear(void)
 	memset(account_key_list, 0, sizeof(account_key_list));
 	memset(account_key_metadata, 0, sizeof(account_key_metadata));
 	account_key_count = 0;
+	ak_generation++;
 
 	memset(account_key_order, 0, sizeof(account_key_order));
 
@@ -25,6 +25,11 @@ LOG_MODULE_DECLARE(fp_storage, CONFIG_FP_STORAGE_LOG_LEVEL);
 static struct fp_account_key owner_account_key;
 static bool owner_account_key_is_stored;
 
+/* Changed on every write or removal of an Account Key. It is not reset with the RAM data, so that
+ * it never returns to a value seen before the reset.
+ */
+static uint32_t ak_generation;
+
 static int settings_set_err;
 static bool is_enabled;
 
@@ -60,6 +65,7 @@ static int fp_settings_load_owner_ak(size_t len, settings_read_cb read_cb, void
 
 	owner_account_key = data.account_key;
 	owner_account_key_is_stored = true;
+	ak_generation++;
 
 	return 0;
 }
@@ -117,6 +123,11 @@ int fp_storage_ak_get(struct fp_account_key *buf, size_t *key_count)
 	return 0;
 }
 
+uint32_t fp_storage_ak_generation_get(void)
+{
+	return ak_generation;
+}
+
 int fp_storage_ak_find(struct fp_account_key *account_key,
 		       fp_storage_ak_check_cb account_key_check_cb, void *context)
 {
@@ -168,6 +179,7 @@ int fp_storage_ak_save(const struct fp_account_key *account_key, const void *con
 
 	owner_account_key = *account_key;
 	owner_account_key_is_stored = true;
+	ak_generation++;
 
 	return 0;
 }
@@ -190,6 +202,7 @@ void fp_storage_ak_ram_clear(void)
 {
 	memset(&owner_account_key, 0, sizeof(owner_account_key));
 	owner_account_key_is_stored = false;
+	ak_generation++;
 
 	settings_set_err = 0;
 
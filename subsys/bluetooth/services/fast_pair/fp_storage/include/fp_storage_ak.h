@@ -77,6 +77,14 @@ bool fp_storage_ak_has_account_key(void);
  */
 int fp_storage_ak_get(struct fp_account_key *buf, size_t *key_count);
 
+/** Get the generation of the stored Account Key List.
+ *  The generation changes whenever an Account Key is written or removed. It can be used to check
+ *  that data derived from the Account Key List is still up to date without reading the list.
+ *
+ * @return Generation of the stored Account Key List.
+ */
+uint32_t fp_storage_ak_generation_get(void);
+
 /** Iterate over stored Account Keys to find a key that matches user-defined conditions.
  *  If such a key is found, the iteration process stops and this function returns.
  *  Found key is marked as recently used by storage module.
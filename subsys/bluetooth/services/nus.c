@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/l2cap.h>
+#include <zephyr/sys/ring_buffer.h>
 
 #include <bluetooth/services/nus.h>
 #include <zephyr/logging/log.h>
@@ -15,6 +18,34 @@ LOG_MODULE_REGISTER(bt_nus, CONFIG_BT_NUS_LOG_LEVEL);
 
 static struct bt_nus_cb nus_cb;
 
+#if defined(CONFIG_BT_NUS_STREAM)
+#define STREAM_RETRY_DELAY K_MSEC(10)
+/* Maximum notification length, ATT_MTU - 3. */
+#define STREAM_CHUNK_SIZE_MAX (BT_L2CAP_TX_MTU - 3)
+
+struct nus_stream {
+	struct bt_conn *conn;
+	struct ring_buf tx_rb;
+	uint8_t tx_buf[CONFIG_BT_NUS_STREAM_TX_BUF_SIZE];
+	/* Data taken from the ring buffer and not yet queued as a notification. */
+	uint8_t tx_chunk[STREAM_CHUNK_SIZE_MAX];
+	uint16_t tx_chunk_len;
+	/* Set while a context sends the notifications of the stream. */
+	bool tx_busy;
+	uint8_t in_flight;
+	/* Set once the retry work has been initialized. It is never initialized again, as
+	 * it may still be queued or running for the previous connection.
+	 */
+	bool work_initialized;
+	struct k_work_delayable retry_work;
+};
+
+static struct nus_stream streams[CONFIG_BT_MAX_CONN];
+static K_MUTEX_DEFINE(stream_mutex);
+
+static void stream_tx_try(struct nus_stream *stream);
+#endif /* CONFIG_BT_NUS_STREAM */
+
 static void nus_ccc_cfg_changed(const struct bt_gatt_attr *attr,
 				  uint16_t value)
 {
@@ -81,12 +112,174 @@ BT_GATT_PRIMARY_SERVICE(BT_UUID_NUS_SERVICE),
 			       NULL, on_receive, NULL),
 );
 
+#if defined(CONFIG_BT_NUS_STREAM)
+static void stream_reset(struct nus_stream *stream)
+{
+	(void)k_work_cancel_delayable(&stream->retry_work);
+
+	stream->conn = NULL;
+	stream->in_flight = 0;
+	stream->tx_chunk_len = 0;
+	ring_buf_reset(&stream->tx_rb);
+}
+
+static void stream_on_sent(struct bt_conn *conn, void *user_data)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+	size_t len = POINTER_TO_UINT(user_data);
+	bool tx_try = false;
+
+	LOG_DBG("Stream data sent, len %zu, conn %p", len, (void *)conn);
+
+	k_mutex_lock(&stream_mutex, K_FOREVER);
+
+	/* The stream may have been reset in the meantime. */
+	if ((stream->conn == conn) && (stream->in_flight > 0)) {
+		stream->in_flight--;
+		tx_try = true;
+	}
+
+	k_mutex_unlock(&stream_mutex);
+
+	if (tx_try) {
+		stream_tx_try(stream);
+	}
+
+	if (nus_cb.stream_sent) {
+		nus_cb.stream_sent(conn, len);
+	}
+}
+
+/* The stream mutex is not held while the notifications are queued, as bt_gatt_notify_cb()
+ * can block waiting for a TX buffer. Only one context at a time queues the notifications of
+ * a stream, so that the data is sent in order. The others leave their data to it.
+ */
+static void stream_tx_try(struct nus_stream *stream)
+{
+	const struct bt_gatt_attr *attr = &nus_svc.attrs[2];
+
+	k_mutex_lock(&stream_mutex, K_FOREVER);
+
+	if (stream->tx_busy) {
+		k_mutex_unlock(&stream_mutex);
+		return;
+	}
+
+	stream->tx_busy = true;
+
+	while (stream->conn && (stream->in_flight < CONFIG_BT_NUS_STREAM_TX_IN_FLIGHT_MAX)) {
+		struct bt_gatt_notify_params params = {0};
+		struct bt_conn *conn = stream->conn;
+		uint16_t len;
+		int err;
+
+		if (stream->tx_chunk_len == 0) {
+			stream->tx_chunk_len = ring_buf_get(&stream->tx_rb, stream->tx_chunk,
+							    MIN(bt_nus_get_mtu(conn),
+								sizeof(stream->tx_chunk)));
+			if (stream->tx_chunk_len == 0) {
+				break;
+			}
+		}
+
+		len = stream->tx_chunk_len;
+		stream->in_flight++;
+
+		params.attr = attr;
+		params.data = stream->tx_chunk;
+		params.len = len;
+		params.func = stream_on_sent;
+		params.user_data = UINT_TO_POINTER(len);
+
+		/* The chunk is modified only by the context that holds tx_busy, and the
+		 * notification data is copied into an ATT buffer.
+		 */
+		k_mutex_unlock(&stream_mutex);
+		err = bt_gatt_notify_cb(conn, &params);
+		k_mutex_lock(&stream_mutex, K_FOREVER);
+
+		if (stream->conn != conn) {
+			/* The stream has been reset while the notification was queued. */
+			continue;
+		}
+
+		if (!err) {
+			stream->tx_chunk_len = 0;
+			continue;
+		}
+
+		stream->in_flight--;
+
+		if ((err == -ENOMEM) || (err == -ENOBUFS)) {
+			/* Out of TX buffers. The chunk is kept and sent once a notification
+			 * in flight completes or after a delay.
+			 */
+			if (stream->in_flight == 0) {
+				(void)k_work_reschedule(&stream->retry_work, STREAM_RETRY_DELAY);
+			}
+		} else {
+			LOG_WRN("Stream send failed (err %d), dropping %u bytes", err,
+				len + ring_buf_size_get(&stream->tx_rb));
+			stream->tx_chunk_len = 0;
+			ring_buf_reset(&stream->tx_rb);
+		}
+
+		break;
+	}
+
+	stream->tx_busy = false;
+
+	k_mutex_unlock(&stream_mutex);
+}
+
+static void stream_retry_work_handle(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nus_stream *stream = CONTAINER_OF(dwork, struct nus_stream, retry_work);
+
+	stream_tx_try(stream);
+}
+
+static void stream_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+	struct k_work_sync sync;
+	bool reset = false;
+
+	k_mutex_lock(&stream_mutex, K_FOREVER);
+
+	if (stream->conn == conn) {
+		if ((stream->tx_chunk_len != 0) || !ring_buf_is_empty(&stream->tx_rb)) {
+			LOG_WRN("Disconnected, dropping %u stream bytes",
+				stream->tx_chunk_len + ring_buf_size_get(&stream->tx_rb));
+		}
+
+		stream_reset(stream);
+		reset = true;
+	}
+
+	k_mutex_unlock(&stream_mutex);
+
+	/* The retry work takes the stream mutex, so it is waited for without holding it. The
+	 * connection index cannot be reused until the disconnection has been handled.
+	 */
+	if (reset) {
+		(void)k_work_cancel_delayable_sync(&stream->retry_work, &sync);
+	}
+}
+
+BT_CONN_CB_DEFINE(nus_conn_callbacks) = {
+	.disconnected = stream_disconnected,
+};
+#endif /* CONFIG_BT_NUS_STREAM */
+
 int bt_nus_init(struct bt_nus_cb *callbacks)
 {
 	if (callbacks) {
 		nus_cb.received = callbacks->received;
 		nus_cb.sent = callbacks->sent;
 		nus_cb.send_enabled = callbacks->send_enabled;
+		nus_cb.stream_sent = callbacks->stream_sent;
 	}
 
 	return 0;
@@ -111,3 +304,67 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 		return -EINVAL;
 	}
 }
+
+#if defined(CONFIG_BT_NUS_STREAM)
+int bt_nus_stream_write(struct bt_conn *conn, const uint8_t *data, size_t len)
+{
+	const struct bt_gatt_attr *attr = &nus_svc.attrs[2];
+	struct nus_stream *stream;
+	uint32_t written;
+
+	if (!conn || !data) {
+		return -EINVAL;
+	}
+
+	if (!bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY)) {
+		return -EINVAL;
+	}
+
+	stream = &streams[bt_conn_index(conn)];
+
+	k_mutex_lock(&stream_mutex, K_FOREVER);
+
+	if (stream->conn != conn) {
+		/* The stream of the previous connection with the same index has been
+		 * reset on disconnection.
+		 */
+		ring_buf_init(&stream->tx_rb, sizeof(stream->tx_buf), stream->tx_buf);
+		if (!stream->work_initialized) {
+			k_work_init_delayable(&stream->retry_work, stream_retry_work_handle);
+			stream->work_initialized = true;
+		}
+		stream->in_flight = 0;
+		stream->tx_chunk_len = 0;
+		stream->conn = conn;
+	}
+
+	written = ring_buf_put(&stream->tx_rb, data, len);
+
+	k_mutex_unlock(&stream_mutex);
+
+	stream_tx_try(stream);
+
+	LOG_DBG("Stream write req: %zu, accepted: %u", len, written);
+
+	return written;
+}
+
+size_t bt_nus_stream_space_get(struct bt_conn *conn)
+{
+	struct nus_stream *stream;
+	size_t space;
+
+	if (!conn) {
+		return 0;
+	}
+
+	stream = &streams[bt_conn_index(conn)];
+
+	k_mutex_lock(&stream_mutex, K_FOREVER);
+	space = (stream->conn == conn) ? ring_buf_space_get(&stream->tx_rb) :
+					 sizeof(stream->tx_buf);
+	k_mutex_unlock(&stream_mutex);
+
+	return space;
+}
+#endif /* CONFIG_BT_NUS_STREAM */
@@ -85,6 +85,35 @@ struct ras_segment {
 	uint8_t               data[];
 } __packed;
 
+/** @brief Function used to send a segment of ranging data.
+ *
+ *  @param conn Connection instance.
+ *  @param data Segment, starting with the segmentation header.
+ *  @param len Length of the segment.
+ *
+ *  @return Zero in case of success and error code in case of error.
+ */
+typedef int (*ras_rd_segment_send_t)(struct bt_conn *conn, const uint8_t *data, uint16_t len);
+
+/** @brief Send the next segment of a ranging data buffer.
+ *
+ *  The segment is sent straight from the buffer. The byte in front of the segment is
+ *  temporarily replaced with the segmentation header, so the send function must copy
+ *  the data before returning.
+ *
+ *  @param buf Pointer to claimed ranging data buffer.
+ *  @param max_data_len Maximum amount of ranging data bytes in the segment.
+ *  @param read_cursor Current offset into procedure buffer, updated if the segment is sent.
+ *  @param seg_counter Rolling segment counter.
+ *  @param send Function used to send the segment.
+ *  @param last_seg Set to true if the segment holds the last bytes of the buffer.
+ *
+ *  @return Number of ranging data bytes sent or negative error code from the send function.
+ */
+int ras_rd_buffer_segment_send(struct ras_rd_buffer *buf, uint16_t max_data_len,
+			       uint16_t *read_cursor, uint8_t seg_counter,
+			       ras_rd_segment_send_t send, bool *last_seg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
 #include <zephyr/types.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -19,16 +20,35 @@
 
 LOG_MODULE_DECLARE(ras_rrsp, CONFIG_BT_RAS_RRSP_LOG_LEVEL);
 
+#if CONFIG_BT_RAS_RRSP_RD_BUFFER_POOL_SIZE > 0
+#define RD_POOL_SIZE CONFIG_BT_RAS_RRSP_RD_BUFFER_POOL_SIZE
+#else
 #define RD_POOL_SIZE (CONFIG_BT_RAS_RRSP_MAX_ACTIVE_CONN * CONFIG_BT_RAS_RRSP_RD_BUFFERS_PER_CONN)
+#endif
 #define DROP_PROCEDURE_COUNTER_EMPTY (-1)
 
 BUILD_ASSERT(RD_POOL_SIZE <= UINT8_MAX);
+BUILD_ASSERT(offsetof(struct ras_rd_buffer, procedure) ==
+	     offsetof(struct ras_rd_buffer, segment_headroom) + sizeof(struct ras_seg_header),
+	     "The segment headroom must directly precede the procedure buffer");
 
 static struct ras_rd_buffer rd_buffer_pool[RD_POOL_SIZE];
 static int8_t tx_power_cache[CONFIG_BT_MAX_CONN];
 static int32_t drop_procedure_counter[CONFIG_BT_MAX_CONN];
 static sys_slist_t callback_list = SYS_SLIST_STATIC_INIT(&callback_list);
 
+/* Serializes readers of the procedure buffers with segments being sent from them. */
+static K_MUTEX_DEFINE(rd_buffer_lock);
+
+static struct {
+	atomic_t procedures_stored;
+	atomic_t procedures_overwritten;
+	atomic_t procedures_dropped;
+	atomic_t alloc_failures;
+	atomic_t buffers_reclaimed;
+	atomic_t bytes_stored;
+} stats;
+
 static void notify_new_rd_stored(struct bt_conn *conn, uint16_t ranging_counter)
 {
 	struct bt_ras_rd_buffer_cb *cb;
@@ -92,6 +112,12 @@ static void rd_buffer_free(struct ras_rd_buffer *buf)
 	atomic_clear(&buf->refcount);
 }
 
+static bool rd_buffer_is_reusable(struct ras_rd_buffer *buf)
+{
+	/* Only reuse buffers that have ranging data stored and are not being read. */
+	return buf->ready && !buf->busy && atomic_get(&buf->refcount) == 0;
+}
+
 static struct ras_rd_buffer *rd_buffer_alloc(struct bt_conn *conn, uint16_t ranging_counter)
 {
 	uint16_t conn_buffer_count = 0;
@@ -99,19 +125,26 @@ static struct ras_rd_buffer *rd_buffer_alloc(struct bt_conn *conn, uint16_t rang
 	uint16_t oldest_ranging_counter_age = 0;
 	struct ras_rd_buffer *available_free_buffer = NULL;
 	struct ras_rd_buffer *available_oldest_buffer = NULL;
+	struct ras_rd_buffer *available_acked_buffer = NULL;
 
 	for (uint8_t i = 0; i < ARRAY_SIZE(rd_buffer_pool); i++) {
+		if (rd_buffer_pool[i].conn && rd_buffer_pool[i].conn != conn) {
+			/* Buffers of other connections that the peer has already acknowledged
+			 * can be taken over when the shared pool runs out of free buffers.
+			 */
+			if (available_acked_buffer == NULL && rd_buffer_pool[i].acked &&
+			    rd_buffer_is_reusable(&rd_buffer_pool[i])) {
+				available_acked_buffer = &rd_buffer_pool[i];
+			}
+		}
+
 		if (rd_buffer_pool[i].conn == conn) {
 			conn_buffer_count++;
 
 			const uint16_t ranging_counter_age = ranging_counter
 				- rd_buffer_pool[i].ranging_counter;
 
-			/* Only overwrite buffers that have ranging data stored
-			 * and are not being read.
-			 */
-			if (rd_buffer_pool[i].ready && !rd_buffer_pool[i].busy &&
-			    atomic_get(&rd_buffer_pool[i].refcount) == 0 &&
+			if (rd_buffer_is_reusable(&rd_buffer_pool[i]) &&
 			    ranging_counter_age > oldest_ranging_counter_age) {
 				oldest_ranging_counter = rd_buffer_pool[i].ranging_counter;
 				oldest_ranging_counter_age = ranging_counter_age;
@@ -128,15 +161,32 @@ static struct ras_rd_buffer *rd_buffer_alloc(struct bt_conn *conn, uint16_t rang
 	 * the maximum number of buffers allocated.
 	 */
 	if (conn_buffer_count < CONFIG_BT_RAS_RRSP_RD_BUFFERS_PER_CONN) {
-		rd_buffer_init(conn, available_free_buffer, ranging_counter);
+		if (available_free_buffer != NULL) {
+			rd_buffer_init(conn, available_free_buffer, ranging_counter);
+
+			return available_free_buffer;
+		}
 
-		return available_free_buffer;
+		/* The shared pool is exhausted. Prefer a buffer already delivered to
+		 * another peer over dropping data of this connection.
+		 */
+		if ((available_oldest_buffer == NULL || !available_oldest_buffer->acked) &&
+		    available_acked_buffer != NULL) {
+			LOG_DBG("Reclaiming buffer of another connection");
+			atomic_inc(&stats.buffers_reclaimed);
+			rd_buffer_free(available_acked_buffer);
+
+			rd_buffer_init(conn, available_acked_buffer, ranging_counter);
+
+			return available_acked_buffer;
+		}
 	}
 
 	/* Overwrite the oldest stored ranging buffer that is not in use */
 	if (available_oldest_buffer != NULL) {
 		if (!available_oldest_buffer->acked) {
 			/* Only notify if the peer has not read the buffer yet. */
+			atomic_inc(&stats.procedures_overwritten);
 			notify_rd_overwritten(conn, oldest_ranging_counter);
 		}
 		rd_buffer_free(available_oldest_buffer);
@@ -175,6 +225,7 @@ static bool process_step_data(struct bt_le_cs_subevent_step *step, void *user_da
 		LOG_ERR("Out of buffer space: attempted to store %u bytes, buffer size: %u",
 			buffer_len, buffer_size);
 		drop_procedure_counter[conn_index] = buf->ranging_counter;
+		atomic_inc(&stats.procedures_dropped);
 
 		return false;
 	}
@@ -202,6 +253,11 @@ static void subevent_data_available(struct bt_conn *conn,
 
 	if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_ABORTED) {
 		LOG_DBG("Procedure was aborted.");
+
+		if (drop_procedure_counter[conn_index] != result->header.procedure_counter) {
+			atomic_inc(&stats.procedures_dropped);
+		}
+
 		drop_procedure_counter[conn_index] = result->header.procedure_counter;
 	}
 
@@ -227,6 +283,7 @@ static void subevent_data_available(struct bt_conn *conn,
 			LOG_ERR("Failed to allocate buffer for procedure %u",
 				result->header.procedure_counter);
 			drop_procedure_counter[conn_index] = result->header.procedure_counter;
+			atomic_inc(&stats.alloc_failures);
 
 			return;
 		}
@@ -248,6 +305,7 @@ static void subevent_data_available(struct bt_conn *conn,
 		LOG_ERR("Out of buffer space: attempted to store %u bytes, buffer size: %u",
 			buf->subevent_cursor, buffer_size);
 		drop_procedure_counter[conn_index] = buf->ranging_counter;
+		atomic_inc(&stats.procedures_dropped);
 
 		rd_buffer_free(buf);
 
@@ -286,6 +344,8 @@ static void subevent_data_available(struct bt_conn *conn,
 	    hdr->ranging_done_status == BT_CONN_LE_CS_PROCEDURE_ABORTED) {
 		buf->ready = true;
 		buf->busy = false;
+		atomic_inc(&stats.procedures_stored);
+		atomic_add(&stats.bytes_stored, sizeof(struct ras_ranging_header) + buf->subevent_cursor);
 		notify_new_rd_stored(conn, result->header.procedure_counter);
 	}
 }
@@ -359,9 +419,71 @@ int bt_ras_rd_buffer_bytes_pull(struct ras_rd_buffer *buf, uint8_t *out_buf, uin
 
 	__ASSERT_NO_MSG(*read_cursor <= buf_len);
 
+	k_mutex_lock(&rd_buffer_lock, K_FOREVER);
 	memcpy(out_buf, &buf->procedure.buf[*read_cursor], pull_bytes);
+	k_mutex_unlock(&rd_buffer_lock);
+
 	*read_cursor += pull_bytes;
 	*empty = (remaining == pull_bytes);
 
 	return pull_bytes;
 }
+
+int ras_rd_buffer_segment_send(struct ras_rd_buffer *buf, uint16_t max_data_len,
+			       uint16_t *read_cursor, uint8_t seg_counter,
+			       ras_rd_segment_send_t send, bool *last_seg)
+{
+	if (!buf->ready) {
+		*last_seg = true;
+		return 0;
+	}
+
+	uint16_t buf_len = sizeof(struct ras_ranging_header) + buf->subevent_cursor;
+	uint16_t remaining = buf_len - (*read_cursor);
+	uint16_t data_len = MIN(max_data_len, remaining);
+	struct ras_seg_header header = {
+		.first_seg = (*read_cursor == 0),
+		.last_seg = (remaining == data_len),
+		.seg_counter = seg_counter & BIT_MASK(6),
+	};
+	/* The segment starts in the headroom or in the last byte of the previous segment. */
+	uint8_t *segment = &buf->procedure.buf[*read_cursor] - sizeof(struct ras_seg_header);
+	uint8_t saved;
+	int err;
+
+	__ASSERT_NO_MSG(*read_cursor <= buf_len);
+
+	k_mutex_lock(&rd_buffer_lock, K_FOREVER);
+
+	saved = *segment;
+	memcpy(segment, &header, sizeof(header));
+
+	err = send(buf->conn, segment, sizeof(header) + data_len);
+
+	*segment = saved;
+
+	k_mutex_unlock(&rd_buffer_lock);
+
+	if (err) {
+		return err;
+	}
+
+	*read_cursor += data_len;
+	*last_seg = header.last_seg;
+
+	return data_len;
+}
+
+void bt_ras_rd_buffer_stats_get(struct bt_ras_rd_buffer_stats *out)
+{
+	if (!out) {
+		return;
+	}
+
+	out->procedures_stored = atomic_get(&stats.procedures_stored);
+	out->procedures_overwritten = atomic_get(&stats.procedures_overwritten);
+	out->procedures_dropped = atomic_get(&stats.procedures_dropped);
+	out->alloc_failures = atomic_get(&stats.alloc_failures);
+	out->buffers_reclaimed = atomic_get(&stats.buffers_reclaimed);
+	out->bytes_stored = atomic_get(&stats.bytes_stored);
+}
@@ -20,8 +20,6 @@ LOG_MODULE_REGISTER(ras_rrsp, CONFIG_BT_RAS_RRSP_LOG_LEVEL);
 #define RRSP_WQ_PRIORITY   K_PRIO_PREEMPT(K_LOWEST_APPLICATION_THREAD_PRIO)
 K_THREAD_STACK_DEFINE(rrsp_wq_stack_area, RRSP_WQ_STACK_SIZE);
 
-NET_BUF_SIMPLE_DEFINE_STATIC(segment_buf, CONFIG_BT_L2CAP_TX_MTU);
-
 static struct bt_ras_rrsp {
 	struct bt_conn *conn;
 
@@ -57,7 +55,7 @@ static void rascp_work_handler(struct k_work *work);
 static void status_work_handler(struct k_work *work);
 static void rascp_timeout_handler(struct k_timer *timer);
 
-static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, struct net_buf_simple *buf);
+static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, const uint8_t *data, uint16_t len);
 static int rd_status_notify_or_indicate(struct bt_conn *conn, const struct bt_uuid *uuid,
 					uint16_t ranging_counter);
 
@@ -238,7 +236,7 @@ BT_CONN_CB_DEFINE(conn_callbacks) = {
 
 static int rd_segment_send(struct bt_ras_rrsp *rrsp)
 {
-	int err;
+	int sent;
 
 	__ASSERT_NO_MSG(rrsp->conn);
 
@@ -247,42 +245,22 @@ static int rd_segment_send(struct bt_ras_rrsp *rrsp)
 	 * An extra byte is reserved for the segment header
 	 */
 	uint16_t max_data_len = bt_gatt_get_mtu(rrsp->conn) - (4 + sizeof(struct ras_seg_header));
-
-	/* segment_buf is only accessed by the RRSP WQ, so is safe to reuse. */
-	net_buf_simple_reset(&segment_buf);
-
-	struct ras_segment *ras_segment =
-		net_buf_simple_add(&segment_buf, sizeof(struct ras_segment) + max_data_len);
-	if (!ras_segment) {
-		LOG_ERR("Cannot allocate segment buffer");
-		return -ENOMEM;
-	}
-
-	bool first_seg = (rrsp->active_buf_read_cursor == 0);
 	bool last_seg;
-	uint16_t actual_data_len =
-		bt_ras_rd_buffer_bytes_pull(rrsp->active_buf, ras_segment->data, max_data_len,
-					    &rrsp->active_buf_read_cursor, &last_seg);
 
-	LOG_DBG("Got %u bytes (max: %u)", actual_data_len, max_data_len);
+	/* The segment is sent straight from the ranging data buffer. */
+	sent = ras_rd_buffer_segment_send(rrsp->active_buf, max_data_len,
+					  &rrsp->active_buf_read_cursor, rrsp->segment_counter,
+					  ondemand_rd_notify_or_indicate, &last_seg);
+	if (sent < 0) {
+		LOG_WRN("ondemand_rd_notify_or_indicate failed err %d", sent);
 
-	if (actual_data_len) {
-		ras_segment->header.first_seg = first_seg;
-		ras_segment->header.last_seg = last_seg;
-		ras_segment->header.seg_counter = rrsp->segment_counter & BIT_MASK(6);
-
-		(void)net_buf_simple_remove_mem(&segment_buf, (max_data_len - actual_data_len));
-
-		err = ondemand_rd_notify_or_indicate(rrsp->conn, &segment_buf);
-		if (err) {
-			LOG_WRN("ondemand_rd_notify_or_indicate failed err %d", err);
-
-			/* Keep retrying */
-			rrsp->active_buf_read_cursor -= actual_data_len;
+		/* Keep retrying */
+		return sent;
+	}
 
-			return err;
-		}
+	LOG_DBG("Sent %d bytes (max: %u)", sent, max_data_len);
 
+	if (sent) {
 		rrsp->segment_counter++;
 
 		LOG_DBG("Segment with RSC %d sent", rrsp->segment_counter);
@@ -474,7 +452,7 @@ static void ondemand_rd_indicate_sent_cb(struct bt_conn *conn,
 	}
 }
 
-static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, struct net_buf_simple *buf)
+static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 {
 	struct bt_gatt_attr *attr =
 		bt_gatt_find_by_uuid(rrsp_svc.attrs, 0, BT_UUID_RAS_ONDEMAND_RD);
@@ -486,8 +464,8 @@ static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, struct net_buf_s
 
 		params.attr = attr;
 		params.uuid = NULL;
-		params.data = buf->data;
-		params.len = buf->len;
+		params.data = data;
+		params.len = len;
 		params.func = ondemand_rd_notify_sent_cb;
 
 		return bt_gatt_notify_cb(conn, &params);
@@ -498,8 +476,8 @@ static int ondemand_rd_notify_or_indicate(struct bt_conn *conn, struct net_buf_s
 
 		rrsp->ondemand_ind_params.attr = attr;
 		rrsp->ondemand_ind_params.uuid = NULL;
-		rrsp->ondemand_ind_params.data = buf->data;
-		rrsp->ondemand_ind_params.len = buf->len;
+		rrsp->ondemand_ind_params.data = data;
+		rrsp->ondemand_ind_params.len = len;
 		rrsp->ondemand_ind_params.func = ondemand_rd_indicate_sent_cb;
 		rrsp->ondemand_ind_params.destroy = NULL;
 
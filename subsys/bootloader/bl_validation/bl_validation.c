@@ -124,6 +124,10 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 #include <pm_config.h>
 #endif
 
+#if defined(CONFIG_SB_VALIDATION_MEASURE_TIME)
+#include <zephyr/timing/timing.h>
+#endif
+
 struct __packed fw_validation_info {
 	/* Magic value to verify that the struct has the correct type. */
 	uint32_t magic[MAGIC_LEN_WORDS];
@@ -522,7 +526,27 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 
 bool bl_validate_firmware_local(uint32_t fw_address, const struct fw_info *fwinfo)
 {
+#if defined(CONFIG_SB_VALIDATION_MEASURE_TIME)
+	timing_t start;
+	timing_t end;
+	bool valid;
+
+	timing_init();
+	timing_start();
+
+	start = timing_counter_get();
+	valid = validate_firmware(fw_address, fw_address, fwinfo, false);
+	end = timing_counter_get();
+
+	timing_stop();
+
+	LOG_INF("Validated %u bytes in %u us.", fwinfo ? fwinfo->size : 0,
+		(uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC));
+
+	return valid;
+#else
 	return validate_firmware(fw_address, fw_address, fwinfo, false);
+#endif
 }
 #endif
 
@@ -13,6 +13,7 @@
 
 #include <mpsl_timeslot.h>
 #include <mpsl.h>
+#include <hal/nrf_timer.h>
 
 #include <nrf_dm.h>
 #include "dm.h"
@@ -63,7 +64,10 @@ LOG_MODULE_REGISTER(nrf_dm, CONFIG_DM_MODULE_LOG_LEVEL);
 #define DM_TIMESLOT_OVERHEAD_US      420
 #define DM_REFLECTOR_OVERHEAD_US     2000
 
+#define DM_BATCH_MAX_COUNT           CONFIG_DM_TIMESLOT_BATCH_MAX_COUNT
+
 static K_MUTEX_DEFINE(ranging_mtx);
+static K_MUTEX_DEFINE(stats_mtx);
 static K_TIMER_DEFINE(timer, NULL, NULL);
 
 enum mpsl_timeslot_call {
@@ -79,6 +83,7 @@ enum dm_call {
 	TIMESLOT_EARLY_END,
 	TIMESLOT_NORMAL_END,
 	TIMESLOT_RESCHEDULE,
+	REQUEST_EVICTED,
 };
 
 enum timeslot_state {
@@ -91,6 +96,7 @@ enum timeslot_state {
 
 K_MSGQ_DEFINE(mpsl_api_msgq, sizeof(enum mpsl_timeslot_call), 8, 4);
 K_MSGQ_DEFINE(dm_api_msgq, sizeof(enum dm_call), 8, 4);
+K_MSGQ_DEFINE(evicted_msgq, sizeof(struct dm_request), 4, 4);
 
 struct {
 	nrf_dm_status_t nrf_dm_status;
@@ -98,7 +104,13 @@ struct {
 } static dm_context;
 
 struct {
-	struct timeslot_request curr_req;
+	struct timeslot_request batch[DM_BATCH_MAX_COUNT];
+	uint32_t offset_us[DM_BATCH_MAX_COUNT];
+	uint32_t success_mask;
+	uint32_t length_us;
+	uint32_t ranging_us;
+	uint8_t count;
+	uint8_t pos;
 	atomic_val_t state;
 	uint32_t last_start;
 } static timeslot_ctx = {
@@ -120,7 +132,13 @@ static mpsl_timeslot_request_t timeslot_request_normal = {
 	.params.normal.priority = MPSL_TIMESLOT_PRIORITY_HIGH,
 };
 
+struct {
+	struct dm_stats stats;
+	int64_t reset_time;
+} static stats_ctx;
+
 struct dm_result result;
+static nrf_dm_report_t reports[DM_BATCH_MAX_COUNT];
 static mpsl_timeslot_signal_return_param_t signal_callback_return_param;
 
 static void dm_config_get(struct dm_request *dm_req, nrf_dm_config_t *dm_config)
@@ -158,13 +176,69 @@ static uint32_t dm_proc_execute_duration_us(struct dm_request *dm_req)
 	return time_us;
 }
 
+static uint32_t timeslot_time_us(void)
+{
+	nrf_timer_task_trigger(MPSL_TIMER0, nrf_timer_capture_task_get(NRF_TIMER_CC_CHANNEL1));
+
+	return nrf_timer_cc_get(MPSL_TIMER0, NRF_TIMER_CC_CHANNEL1);
+}
+
+/* Execute the ranging at the current position of the batch and schedule the next one. */
+static void timeslot_batch_execute(mpsl_timeslot_signal_return_param_t *p_ret_val)
+{
+	static nrf_dm_config_t dm_config;
+	struct timeslot_request *req = &timeslot_ctx.batch[timeslot_ctx.pos];
+	nrf_dm_status_t nrf_dm_status;
+	uint32_t start_us;
+	uint32_t end_us;
+
+	dm_io_set(DM_IO_RANGING);
+	start_us = timeslot_time_us();
+
+	dm_config_get(&req->dm_req, &dm_config);
+	nrf_dm_status = nrf_dm_configure(&dm_config);
+
+	if (nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
+		nrf_dm_status = nrf_dm_proc_execute(req->window_length_us);
+	}
+
+	if (nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
+		timeslot_ctx.success_mask |= BIT(timeslot_ctx.pos);
+
+		/* The next ranging overwrites the data of this one. The report of the last
+		 * ranging is populated after the timeslot.
+		 */
+		if (timeslot_ctx.pos + 1 < timeslot_ctx.count) {
+			nrf_dm_populate_report(&reports[timeslot_ctx.pos]);
+		}
+	} else {
+		dm_context.nrf_dm_status = nrf_dm_status;
+	}
+
+	end_us = timeslot_time_us();
+	timeslot_ctx.ranging_us += end_us - start_us;
+
+	dm_io_clear(DM_IO_RANGING);
+
+	/* Rangings whose start has already passed are skipped. */
+	for (timeslot_ctx.pos++; timeslot_ctx.pos < timeslot_ctx.count; timeslot_ctx.pos++) {
+		if (timeslot_ctx.offset_us[timeslot_ctx.pos] > end_us) {
+			nrf_timer_cc_set(MPSL_TIMER0, NRF_TIMER_CC_CHANNEL0,
+					 timeslot_ctx.offset_us[timeslot_ctx.pos]);
+			nrf_timer_int_enable(MPSL_TIMER0, NRF_TIMER_INT_COMPARE0_MASK);
+			p_ret_val->callback_action = MPSL_TIMESLOT_SIGNAL_ACTION_NONE;
+			return;
+		}
+	}
+
+	p_ret_val->callback_action = MPSL_TIMESLOT_SIGNAL_ACTION_END;
+}
+
 static mpsl_timeslot_signal_return_param_t *mpsl_timeslot_callback(
 				mpsl_timeslot_session_id_t session_id, uint32_t signal_type)
 {
 	ARG_UNUSED(session_id);
 	mpsl_timeslot_signal_return_param_t *p_ret_val = NULL;
-	nrf_dm_status_t nrf_dm_status;
-	static nrf_dm_config_t dm_config;
 	enum dm_call dm_api_call;
 
 	switch (signal_type) {
@@ -173,24 +247,24 @@ static mpsl_timeslot_signal_return_param_t *mpsl_timeslot_callback(
 		signal_callback_return_param.callback_action = MPSL_TIMESLOT_SIGNAL_ACTION_END;
 		p_ret_val = &signal_callback_return_param;
 
-		dm_io_set(DM_IO_RANGING);
-
 		if (atomic_get(&timeslot_ctx.state) == TIMESLOT_STATE_EARLY_PENDING) {
+			dm_io_set(DM_IO_RANGING);
 			dm_io_clear(DM_IO_RANGING);
 			return p_ret_val;
 		}
 
-		dm_config_get(&timeslot_ctx.curr_req.dm_req, &dm_config);
-		nrf_dm_status = nrf_dm_configure(&dm_config);
-
-		if (nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-			nrf_dm_status = nrf_dm_proc_execute(timeslot_ctx.curr_req.window_length_us);
-		}
-
-		dm_context.nrf_dm_status = nrf_dm_status;
-
-		dm_io_clear(DM_IO_RANGING);
+		timeslot_ctx.pos = 0;
+		timeslot_ctx.success_mask = 0;
+		timeslot_ctx.ranging_us = 0;
+		dm_context.nrf_dm_status = NRF_DM_STATUS_SUCCESS;
+		timeslot_batch_execute(p_ret_val);
+		break;
+	case MPSL_TIMESLOT_SIGNAL_TIMER0:
+		nrf_timer_int_disable(MPSL_TIMER0, NRF_TIMER_INT_COMPARE0_MASK);
+		nrf_timer_event_clear(MPSL_TIMER0, NRF_TIMER_EVENT_COMPARE0);
 
+		p_ret_val = &signal_callback_return_param;
+		timeslot_batch_execute(p_ret_val);
 		break;
 	case MPSL_TIMESLOT_SIGNAL_SESSION_IDLE:
 		if (atomic_get(&timeslot_ctx.state) == TIMESLOT_STATE_EARLY_PENDING) {
@@ -263,14 +337,15 @@ static void mpsl_nonpreemptible_thread(void)
 	}
 }
 
-static void process_data(const nrf_dm_report_t *data, float high_precision_estimate)
+static void process_data(const struct dm_request *req, const nrf_dm_report_t *data,
+			 float high_precision_estimate)
 {
 	if (!data) {
 		result.status = false;
 		return;
 	}
-	result.status = (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS);
-	bt_addr_le_copy(&result.bt_addr, &timeslot_ctx.curr_req.dm_req.bt_addr);
+	result.status = true;
+	bt_addr_le_copy(&result.bt_addr, &req->bt_addr);
 
 	result.quality = DM_QUALITY_NONE;
 	if (data->quality == NRF_DM_QUALITY_OK) {
@@ -283,7 +358,7 @@ static void process_data(const nrf_dm_report_t *data, float high_precision_estim
 		result.quality = DM_QUALITY_CRC_FAIL;
 	}
 
-	result.ranging_mode = timeslot_ctx.curr_req.dm_req.ranging_mode;
+	result.ranging_mode = req->ranging_mode;
 	if (result.ranging_mode == DM_RANGING_MODE_RTT) {
 		result.dist_estimates.rtt.rtt = data->distance_estimates.rtt.rtt;
 	} else {
@@ -317,7 +392,7 @@ static int timeslot_request(uint32_t distance_from_last)
 	enum mpsl_timeslot_call mpsl_api_call;
 
 	timeslot_request_normal.params.normal.distance_us = distance_from_last;
-	timeslot_request_normal.params.normal.length_us = timeslot_ctx.curr_req.timeslot_length_us;
+	timeslot_request_normal.params.normal.length_us = timeslot_ctx.length_us;
 	mpsl_api_call = MAKE_REQUEST_NORMAL;
 
 	err = k_msgq_put(&mpsl_api_msgq, &mpsl_api_call, K_FOREVER);
@@ -329,7 +404,8 @@ static int timeslot_request(uint32_t distance_from_last)
 
 static void dm_start_ranging(void)
 {
-	struct timeslot_request *req;
+	struct timeslot_request *last;
+	uint32_t distance;
 	int err;
 
 	k_mutex_lock(&ranging_mtx, K_FOREVER);
@@ -349,15 +425,22 @@ static void dm_start_ranging(void)
 		goto out;
 	}
 
-	req = timeslot_queue_peek();
-	if (!req) {
+	timeslot_ctx.count = timeslot_queue_batch_get(timeslot_ctx.batch,
+						     ARRAY_SIZE(timeslot_ctx.batch));
+	if (timeslot_ctx.count == 0) {
 		goto out;
 	}
 
-	memcpy(&timeslot_ctx.curr_req, req, sizeof(timeslot_ctx.curr_req));
-	timeslot_queue_remove_first();
+	for (size_t i = 0; i < timeslot_ctx.count; i++) {
+		timeslot_ctx.offset_us[i] = TICKS_TO_US(time_distance_get(
+			timeslot_ctx.batch[0].start_time, timeslot_ctx.batch[i].start_time));
+	}
+
+	last = &timeslot_ctx.batch[timeslot_ctx.count - 1];
+	timeslot_ctx.length_us = timeslot_ctx.offset_us[timeslot_ctx.count - 1] +
+				 last->timeslot_length_us;
 
-	uint32_t distance = time_distance_get(timeslot_ctx.last_start, req->start_time);
+	distance = time_distance_get(timeslot_ctx.last_start, timeslot_ctx.batch[0].start_time);
 
 	atomic_set(&timeslot_ctx.state, TIMESLOT_STATE_PENDING);
 	err = timeslot_request(TICKS_TO_US(distance));
@@ -368,58 +451,143 @@ out:
 	k_mutex_unlock(&ranging_mtx);
 }
 
+/* A timeslot was given to a peer that waited longer. The replaced ranging is reported from
+ * the DM thread, so that the callback is not called from the context adding a request.
+ */
+static void dm_request_evicted(const struct dm_request *req)
+{
+	enum dm_call dm_api_call = REQUEST_EVICTED;
+
+	LOG_DBG("Timeslot given to a peer that waited longer");
+
+	k_mutex_lock(&stats_mtx, K_FOREVER);
+	stats_ctx.stats.evicted++;
+	k_mutex_unlock(&stats_mtx);
+
+	if (IS_ENABLED(CONFIG_DM_MODULE_RPC_HOST) || (dm_context.cb->data_ready == NULL)) {
+		return;
+	}
+
+	if (k_msgq_put(&evicted_msgq, req, K_NO_WAIT)) {
+		LOG_WRN("Too many replaced rangings, not reporting");
+		return;
+	}
+
+	(void)k_msgq_put(&dm_api_msgq, &dm_api_call, K_NO_WAIT);
+}
+
+static void evicted_report(void)
+{
+	struct dm_result evicted_result;
+	struct dm_request req;
+
+	while (k_msgq_get(&evicted_msgq, &req, K_NO_WAIT) == 0) {
+		evicted_result = (struct dm_result){
+			.status = false,
+			.quality = DM_QUALITY_NONE,
+			.ranging_mode = req.ranging_mode,
+		};
+		bt_addr_le_copy(&evicted_result.bt_addr, &req.bt_addr);
+
+		dm_context.cb->data_ready(&evicted_result);
+	}
+}
+
 static void dm_reschedule(void)
 {
-	uint32_t timeslot_len_us;
-	uint32_t window_len_us;
+	struct timeslot_request *req;
+	uint32_t now;
+	uint32_t end_us;
+	uint32_t ref_tick;
 
 	if (IS_ENABLED(CONFIG_DM_TIMESLOT_RESCHEDULE)) {
+		struct dm_request evicted;
 		int err;
 
-		if (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-			window_len_us = timeslot_ctx.curr_req.window_length_us;
-			timeslot_len_us = timeslot_ctx.curr_req.timeslot_length_us;
+		now = time_now();
 
-			err = timeslot_queue_append(&timeslot_ctx.curr_req.dm_req,
-					   time_now(), window_len_us, timeslot_len_us);
-			if (err) {
+		for (size_t i = 0; i < timeslot_ctx.count; i++) {
+			if (!(timeslot_ctx.success_mask & BIT(i))) {
+				continue;
+			}
+
+			/* The peer reschedules at the end of its own timeslot, which can
+			 * be earlier than the end of the batch.
+			 */
+			req = &timeslot_ctx.batch[i];
+			end_us = timeslot_ctx.offset_us[i] + req->timeslot_length_us;
+			ref_tick = (now + RTC_COUNTER_MAX -
+				    US_TO_RTC_TICKS(timeslot_ctx.length_us - end_us)) % RTC_COUNTER_MAX;
+
+			err = timeslot_queue_append(&req->dm_req, ref_tick,
+						    req->window_length_us, req->timeslot_length_us,
+						    &evicted);
+			if (err < 0) {
 				LOG_DBG("Timeslot allocator failed (err %d)", err);
+			} else if (err > 0) {
+				dm_request_evicted(&evicted);
 			}
 		}
 		dm_start_ranging();
 	}
 }
 
-static void calculation(void)
+static void calculation(size_t idx)
 {
+	const struct dm_request *req = &timeslot_ctx.batch[idx].dm_req;
+	nrf_dm_report_t *report = &reports[idx];
+
+	/* Only the report of the last ranging in the batch is still held by nrf_dm. */
+	if (idx == timeslot_ctx.count - 1) {
+		nrf_dm_populate_report(report);
+	}
+
 	if (IS_ENABLED(CONFIG_DM_MODULE_RPC_HOST)) {
 		struct dm_rpc_process_data *data;
 
 		data = dm_rpc_get_buffer(sizeof(*data));
 		if (data) {
-			nrf_dm_populate_report(&data->report);
-			bt_addr_le_copy(&data->bt_addr, &timeslot_ctx.curr_req.dm_req.bt_addr);
+			memcpy(&data->report, report, sizeof(data->report));
+			bt_addr_le_copy(&data->bt_addr, &req->bt_addr);
 			dm_rpc_calc_and_process(data, sizeof(*data));
 		}
 	} else {
-		static nrf_dm_report_t report;
 		float high_precision_estimate = 0;
 
-		nrf_dm_populate_report(&report);
-		nrf_dm_calc(&report);
+		nrf_dm_calc(report);
 
 #ifdef CONFIG_DM_HIGH_PRECISION_CALC
-		if (report.ranging_mode == NRF_DM_RANGING_MODE_MCPD) {
-			high_precision_estimate = nrf_dm_high_precision_calc(&report);
+		if (report->ranging_mode == NRF_DM_RANGING_MODE_MCPD) {
+			high_precision_estimate = nrf_dm_high_precision_calc(report);
 		}
 #endif
-		process_data(&report, high_precision_estimate);
+		process_data(req, report, high_precision_estimate);
 		if (dm_context.cb->data_ready != NULL) {
 			dm_context.cb->data_ready(&result);
 		}
 	}
 }
 
+static void stats_update(void)
+{
+	uint32_t measurements = 0;
+
+	for (size_t i = 0; i < timeslot_ctx.count; i++) {
+		if (timeslot_ctx.success_mask & BIT(i)) {
+			measurements++;
+		}
+	}
+
+	k_mutex_lock(&stats_mtx, K_FOREVER);
+	stats_ctx.stats.measurements += measurements;
+	stats_ctx.stats.failures += timeslot_ctx.count - measurements;
+	stats_ctx.stats.timeslots++;
+	stats_ctx.stats.batched += timeslot_ctx.count - 1;
+	stats_ctx.stats.timeslot_us += timeslot_ctx.length_us;
+	stats_ctx.stats.ranging_us += timeslot_ctx.ranging_us;
+	k_mutex_unlock(&stats_mtx);
+}
+
 static void dm_thread(void)
 {
 	int err;
@@ -441,13 +609,22 @@ static void dm_thread(void)
 				break;
 			case TIMESLOT_NORMAL_END:
 				dm_reschedule();
-				if (dm_context.nrf_dm_status == NRF_DM_STATUS_SUCCESS) {
-					calculation();
-				} else {
+				for (size_t i = 0; i < timeslot_ctx.count; i++) {
+					timeslot_queue_peer_served(
+						&timeslot_ctx.batch[i].dm_req.bt_addr);
+
+					if (timeslot_ctx.success_mask & BIT(i)) {
+						calculation(i);
+					}
+				}
+
+				if (timeslot_ctx.success_mask != BIT_MASK(timeslot_ctx.count)) {
 					LOG_DBG("Ranging failed (nrf_dm status: %d)",
 									  dm_context.nrf_dm_status);
 				}
 
+				stats_update();
+
 				atomic_set(&timeslot_ctx.state, TIMESLOT_STATE_IDLE);
 				dm_start_ranging();
 				break;
@@ -455,6 +632,9 @@ static void dm_thread(void)
 				atomic_set(&timeslot_ctx.state, TIMESLOT_STATE_IDLE);
 				dm_start_ranging();
 				break;
+			case REQUEST_EVICTED:
+				evicted_report();
+				break;
 			default:
 				break;
 			}
@@ -465,6 +645,7 @@ static void dm_thread(void)
 int dm_request_add(struct dm_request *req)
 {
 	int err;
+	struct dm_request evicted;
 	uint32_t timeslot_len_us;
 	uint32_t window_len_us;
 
@@ -475,9 +656,12 @@ int dm_request_add(struct dm_request *req)
 	dm_io_set(DM_IO_ADD_REQUEST);
 	window_len_us = dm_proc_execute_duration_us(req);
 	timeslot_len_us = window_len_us + DM_TIMESLOT_OVERHEAD_US;
-	err = timeslot_queue_append(req, time_now(), window_len_us, timeslot_len_us);
-	if (err) {
+	err = timeslot_queue_append(req, time_now(), window_len_us, timeslot_len_us, &evicted);
+	if (err < 0) {
 		LOG_DBG("Timeslot allocation failed (err %d)", err);
+	} else if (err > 0) {
+		dm_request_evicted(&evicted);
+		err = 0;
 	}
 
 	dm_start_ranging();
@@ -486,6 +670,36 @@ int dm_request_add(struct dm_request *req)
 	return err;
 }
 
+int dm_stats_get(struct dm_stats *stats)
+{
+	uint64_t period_ms;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&stats_mtx, K_FOREVER);
+	*stats = stats_ctx.stats;
+	period_ms = k_uptime_get() - stats_ctx.reset_time;
+	k_mutex_unlock(&stats_mtx);
+
+	stats->period_ms = (uint32_t)MIN(period_ms, UINT32_MAX);
+	stats->rate = (period_ms == 0) ? 0 :
+		      (uint32_t)(((uint64_t)stats->measurements * MSEC_PER_SEC * SEC_PER_MIN) /
+				 period_ms);
+	stats->utilization = (stats->timeslot_us == 0) ? 0 :
+			     (uint8_t)MIN((stats->ranging_us * 100) / stats->timeslot_us, 100);
+
+	return 0;
+}
+
+void dm_stats_reset(void)
+{
+	k_mutex_lock(&stats_mtx, K_FOREVER);
+	memset(&stats_ctx.stats, 0, sizeof(stats_ctx.stats));
+	stats_ctx.reset_time = k_uptime_get();
+	k_mutex_unlock(&stats_mtx);
+}
 
 int dm_init(struct dm_init_param *init_param)
 {
@@ -14,6 +14,15 @@
 #define MIN_TIME_BETWEEN_TIMESLOTS_US    CONFIG_DM_MIN_TIME_BETWEEN_TIMESLOTS_US
 #define RANGING_OFFSET_US                CONFIG_DM_RANGING_OFFSET_US
 
+#define BATCH_MAX_COUNT                  CONFIG_DM_TIMESLOT_BATCH_MAX_COUNT
+#define BATCH_MAX_LENGTH_US              CONFIG_DM_TIMESLOT_BATCH_MAX_LENGTH_US
+#if defined(CONFIG_DM_TIMESLOT_QUEUE_PRIORITIZE)
+#define PEER_COUNT                       CONFIG_DM_TIMESLOT_QUEUE_PEER_COUNT
+#else
+/* Not used, the peers are only tracked when prioritizing. */
+#define PEER_COUNT                       1
+#endif
+
 static K_MUTEX_DEFINE(list_mtx);
 static sys_slist_t timeslot_list = SYS_SLIST_STATIC_INIT(&timeslot_list);
 
@@ -22,7 +31,14 @@ struct timeslot_entry {
 	sys_snode_t node;
 };
 
+struct peer_entry {
+	bt_addr_le_t addr;
+	uint32_t last_served_ms;
+	bool used;
+};
+
 static K_HEAP_DEFINE(heap, TIMESLOT_QUEUE_LENGTH * sizeof(struct timeslot_entry));
+static struct peer_entry peers[PEER_COUNT];
 
 static void list_lock(void)
 {
@@ -62,61 +78,158 @@ static bool is_request_exist(struct dm_request *req)
 	return cnt >= TIMESLOT_QUEUE_COUNT_SAME_PEER;
 }
 
+static struct peer_entry *peer_find(const bt_addr_le_t *addr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(peers); i++) {
+		if (peers[i].used && bt_addr_le_cmp(&peers[i].addr, addr) == 0) {
+			return &peers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Time since the last ranging with the peer. Unknown peers are the most stale. */
+static uint32_t peer_wait_time_get(const bt_addr_le_t *addr)
+{
+	struct peer_entry *peer = peer_find(addr);
+
+	if (!peer) {
+		return UINT32_MAX;
+	}
+
+	return k_uptime_get_32() - peer->last_served_ms;
+}
+
+static int timeslot_fit(const struct timeslot_request *last, uint32_t start_time,
+			uint32_t timeslot_len_us, uint32_t *batch_start_time, uint8_t *batch_idx)
+{
+	uint32_t last_end;
+
+	if (!last) {
+		*batch_start_time = start_time;
+		*batch_idx = 0;
+		return 0;
+	}
+
+	last_end = last->start_time + US_TO_RTC_TICKS(last->timeslot_length_us);
+
+	if (start_time >= last_end + US_TO_RTC_TICKS(MIN_TIME_BETWEEN_TIMESLOTS_US)) {
+		*batch_start_time = start_time;
+		*batch_idx = 0;
+		return 0;
+	}
+
+	/* The ranging data is processed after the whole batch, so a timeslot that starts
+	 * right after the last one can share its MPSL timeslot.
+	 */
+	if ((start_time >= last_end) && (last->batch_idx + 1 < BATCH_MAX_COUNT) &&
+	    (start_time + US_TO_RTC_TICKS(timeslot_len_us) <=
+	     last->batch_start_time + US_TO_RTC_TICKS(BATCH_MAX_LENGTH_US))) {
+		*batch_start_time = last->batch_start_time;
+		*batch_idx = last->batch_idx + 1;
+		return 0;
+	}
+
+	return -EBUSY;
+}
+
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick,
-			  uint32_t window_len_us, uint32_t timeslot_len_us)
+			  uint32_t window_len_us, uint32_t timeslot_len_us,
+			  struct dm_request *evicted)
 {
+	int err = 0;
 	uint32_t start_time;
+	uint32_t batch_start_time;
 	uint32_t delay;
-	size_t list_size;
-	struct timeslot_entry *last, *item;
+	uint8_t batch_idx;
+	struct timeslot_entry *last, *prev, *item = NULL;
+	sys_snode_t *prev_node = NULL;
+	sys_snode_t *node;
 
 	delay = req->start_delay_us + RANGING_OFFSET_US;
 	start_time = (start_ref_tick + US_TO_RTC_TICKS(delay)) % RTC_COUNTER_MAX;
 
-	list_size = get_list_size();
-	if (list_size >= TIMESLOT_QUEUE_LENGTH) {
-		return -ENOMEM;
+	list_lock();
+
+	if (get_list_size() >= TIMESLOT_QUEUE_LENGTH) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	if (is_request_exist(req)) {
+		err = -EAGAIN;
+		goto out;
 	}
 
-	if (list_size != 0) {
-		if (is_request_exist(req)) {
-			return -EAGAIN;
+	/* Timeslots are added with a fixed distance from "now" and are therefore
+	 * always appended to the end of the queue. This means that we only
+	 * need to check that the start of the new timeslot does not fall into
+	 * the last timeslot in the queue.
+	 */
+	last = SYS_SLIST_PEEK_TAIL_CONTAINER(&timeslot_list, last, node);
+	err = timeslot_fit(last ? &last->timeslot_req : NULL, start_time, timeslot_len_us,
+			   &batch_start_time, &batch_idx);
+	if (err) {
+		if (!IS_ENABLED(CONFIG_DM_TIMESLOT_QUEUE_PRIORITIZE)) {
+			goto out;
+		}
+
+		/* Let a peer that has waited longer take over the last timeslot. */
+		if (peer_wait_time_get(&req->bt_addr) <=
+		    peer_wait_time_get(&last->timeslot_req.dm_req.bt_addr)) {
+			goto out;
+		}
+
+		SYS_SLIST_FOR_EACH_NODE(&timeslot_list, node) {
+			if (node == &last->node) {
+				break;
+			}
+			prev_node = node;
+		}
+
+		prev = prev_node ? CONTAINER_OF(prev_node, struct timeslot_entry, node) : NULL;
+		err = timeslot_fit(prev ? &prev->timeslot_req : NULL, start_time, timeslot_len_us,
+				   &batch_start_time, &batch_idx);
+		if (err) {
+			goto out;
 		}
 
-		/* Check that the new timeslot does not overlap with a previous one.
-		 * Timeslots are added with a fixed distance from "now" and are therefore
-		 * always appended to the end of the queue. This means that we only
-		 * need to check that the start of the new timeslot does not fall into
-		 * the last timeslot in the queue.
+		/* The entry of the replaced timeslot is reused, so the replacement cannot fail
+		 * after the timeslot has been removed.
 		 */
-		list_lock();
-		last = SYS_SLIST_PEEK_TAIL_CONTAINER(&timeslot_list, last, node);
-		list_unlock();
-
-		if (start_time < last->timeslot_req.start_time +
-					 US_TO_RTC_TICKS(last->timeslot_req.timeslot_length_us +
-							 MIN_TIME_BETWEEN_TIMESLOTS_US)) {
-			return -EBUSY;
+		sys_slist_remove(&timeslot_list, prev_node, &last->node);
+		if (evicted) {
+			memcpy(evicted, &last->timeslot_req.dm_req, sizeof(*evicted));
 		}
+
+		item = last;
+		err = 1;
 	}
 
-	item = k_heap_alloc(&heap, sizeof(struct timeslot_entry), K_NO_WAIT);
 	if (!item) {
-		return -ENOMEM;
+		item = k_heap_alloc(&heap, sizeof(struct timeslot_entry), K_NO_WAIT);
+		if (!item) {
+			err = -ENOMEM;
+			goto out;
+		}
 	}
 
 	item->timeslot_req.start_time = start_time;
 	item->timeslot_req.timeslot_length_us = timeslot_len_us;
 	item->timeslot_req.window_length_us = window_len_us;
+	item->timeslot_req.batch_start_time = batch_start_time;
+	item->timeslot_req.batch_idx = batch_idx;
 	req->rng_seed++;
 
 	memcpy(&item->timeslot_req.dm_req, req, sizeof(item->timeslot_req.dm_req));
 
-	list_lock();
 	sys_slist_append(&timeslot_list, &item->node);
+
+out:
 	list_unlock();
 
-	return 0;
+	return err;
 }
 
 struct timeslot_request *timeslot_queue_peek(void)
@@ -150,3 +263,68 @@ void timeslot_queue_remove_first(void)
 	item = CONTAINER_OF(node, struct timeslot_entry, node);
 	k_heap_free(&heap, item);
 }
+
+size_t timeslot_queue_batch_get(struct timeslot_request *batch, size_t max_count)
+{
+	size_t count = 0;
+	sys_snode_t *node;
+	struct timeslot_entry *item;
+
+	list_lock();
+
+	while (count < max_count) {
+		item = SYS_SLIST_PEEK_HEAD_CONTAINER(&timeslot_list, item, node);
+		if (!item || ((count != 0) && (item->timeslot_req.batch_idx == 0))) {
+			break;
+		}
+
+		memcpy(&batch[count], &item->timeslot_req, sizeof(batch[count]));
+		batch[count].batch_idx = count;
+		count++;
+
+		node = sys_slist_get(&timeslot_list);
+		k_heap_free(&heap, CONTAINER_OF(node, struct timeslot_entry, node));
+	}
+
+	list_unlock();
+
+	for (size_t i = 0; i < count; i++) {
+		batch[i].batch_start_time = batch[0].start_time;
+	}
+
+	return count;
+}
+
+void timeslot_queue_peer_served(const bt_addr_le_t *addr)
+{
+	struct peer_entry *peer;
+
+	if (!IS_ENABLED(CONFIG_DM_TIMESLOT_QUEUE_PRIORITIZE)) {
+		return;
+	}
+
+	list_lock();
+
+	peer = peer_find(addr);
+	if (!peer) {
+		/* Replace the peer that was served least recently. */
+		peer = &peers[0];
+		for (size_t i = 0; i < ARRAY_SIZE(peers); i++) {
+			if (!peers[i].used) {
+				peer = &peers[i];
+				break;
+			}
+
+			if ((int32_t)(peers[i].last_served_ms - peer->last_served_ms) < 0) {
+				peer = &peers[i];
+			}
+		}
+
+		bt_addr_le_copy(&peer->addr, addr);
+		peer->used = true;
+	}
+
+	peer->last_served_ms = k_uptime_get_32();
+
+	list_unlock();
+}
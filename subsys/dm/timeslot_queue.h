@@ -27,6 +27,12 @@ struct timeslot_request {
 
 	/* Ranging window length */
 	uint32_t window_length_us;
+
+	/* The start time of the first timeslot in the batch */
+	uint32_t batch_start_time;
+
+	/* Position in the batch of timeslots executed within one MPSL timeslot */
+	uint8_t batch_idx;
 };
 
 /** @brief Append an element to the end of a queue.
@@ -35,13 +41,23 @@ struct timeslot_request {
  *  @param start_ref_tick Reference start time tick.
  *  @param window_len Ranging window length.
  *  @param timeslot_len Timeslot length.
+ *  @param evicted Address to store the request of the replaced timeslot in, or NULL.
  *
+ *  @retval 0 when the timeslot was added to the queue.
+ *  @retval 1 when the timeslot replaced the last timeslot in the queue.
  *  @retval -ENOMEM when the tiemslot queue is full or a memory allocation error.
  *  @retval -EAGAIN when a single peer has a maximum number of timeslots scheduled.
  *  @retval -EBUSY when the timeslot cannot be scheduled due to time restrictions.
+ *
+ *  If the timeslot starts right after the last one in the queue, it is added to the batch
+ *  of the last timeslot. If it overlaps the last timeslot and CONFIG_DM_TIMESLOT_QUEUE_PRIORITIZE
+ *  is enabled, it replaces the last timeslot when the peer of the request has waited longer
+ *  for a ranging than the peer of the last timeslot. The request of the replaced timeslot is
+ *  then stored in @p evicted, so that its ranging can be reported as not performed.
  */
 int timeslot_queue_append(struct dm_request *req, uint32_t start_ref_tick,
-			  uint32_t window_len, uint32_t timeslot_len);
+			  uint32_t window_len, uint32_t timeslot_len,
+			  struct dm_request *evicted);
 
 /** @brief Peek element at the head of queue.
  *
@@ -57,6 +73,27 @@ struct timeslot_request *timeslot_queue_peek(void);
  */
 void timeslot_queue_remove_first(void);
 
+/** @brief Take the batch of timeslots at the head of the queue.
+ *
+ *  The timeslots are removed from the queue.
+ *
+ *  @param batch Array to store the timeslots in.
+ *  @param max_count Size of the array.
+ *
+ *  @retval Number of timeslots in the batch, or 0 if queue is empty.
+ */
+size_t timeslot_queue_batch_get(struct timeslot_request *batch, size_t max_count);
+
+/** @brief Record that a ranging with the peer has been performed.
+ *
+ *  Peers that have waited longer for a ranging are prioritized when timeslots overlap and
+ *  CONFIG_DM_TIMESLOT_QUEUE_PRIORITIZE is enabled. Peers that have not been recorded are
+ *  treated as the ones that waited the longest.
+ *
+ *  @param addr Bluetooth LE device address of the peer.
+ */
+void timeslot_queue_peer_served(const bt_addr_le_t *addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_batch.h>
+#if defined(CONFIG_NRF_CLOUD_COAP)
+#include <net/nrf_cloud_coap.h>
+#endif
+
+LOG_MODULE_REGISTER(nrf_cloud_batch, CONFIG_NRF_CLOUD_BATCH_LOG_LEVEL);
+
+#define BATCH_BUF_SIZE CONFIG_NRF_CLOUD_BATCH_BUF_SIZE
+#define BATCH_FLUSH_LEVEL ((BATCH_BUF_SIZE * CONFIG_NRF_CLOUD_BATCH_FLUSH_THRESHOLD) / 100)
+
+/* Space that must always remain available to close the JSON array. */
+#define BATCH_ARRAY_END_LEN 1
+
+/* The batch is kept as an open JSON array, "[msg,msg,msg", so that flushing only needs to
+ * append the closing bracket. The extra byte is for the NULL terminator.
+ */
+static char batch_buf[BATCH_BUF_SIZE + 1];
+static size_t batch_len;
+static int batch_msgs;
+
+static struct nrf_cloud_batch_stats stats;
+static nrf_cloud_batch_send_cb_t send_cb;
+static bool initialized;
+
+static K_MUTEX_DEFINE(batch_lock);
+
+static void batch_age_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(batch_age_work, batch_age_work_fn);
+
+enum flush_reason {
+	FLUSH_REASON_REQUEST,
+	FLUSH_REASON_SIZE,
+	FLUSH_REASON_AGE,
+};
+
+static int default_send(const char *buf, size_t len)
+{
+#if defined(CONFIG_NRF_CLOUD_MQTT)
+	struct nrf_cloud_tx_data output = {
+		.qos = MQTT_QOS_0_AT_MOST_ONCE,
+		.topic_type = NRF_CLOUD_TOPIC_BULK,
+		.data.ptr = buf,
+		.data.len = len
+	};
+
+	return nrf_cloud_send(&output);
+#elif defined(CONFIG_NRF_CLOUD_COAP)
+	ARG_UNUSED(len);
+
+	/* Confirmable, so that a lost batch is reported instead of being silently dropped. */
+	return nrf_cloud_coap_json_message_send(buf, true, true);
+#else
+	ARG_UNUSED(buf);
+	ARG_UNUSED(len);
+
+	return -ENODEV;
+#endif
+}
+
+/* The batch is kept if it could not be sent because there is no connection to nRF Cloud. */
+static bool send_err_is_temporary(int err)
+{
+	return (err == -ENOTCONN) || (err == -EACCES);
+}
+
+/* Must be called with batch_lock held. */
+static int batch_send(enum flush_reason reason)
+{
+	int err;
+
+	if (!batch_msgs) {
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&batch_age_work);
+
+	batch_buf[batch_len++] = ']';
+	batch_buf[batch_len] = '\0';
+
+	LOG_DBG("Sending %d messages, %zu bytes", batch_msgs, batch_len);
+
+	err = send_cb(batch_buf, batch_len);
+
+	if (send_err_is_temporary(err)) {
+		LOG_WRN("Not connected, keeping batch of %d messages", batch_msgs);
+
+		/* Reopen the array and retry when the batch reaches its maximum age again. */
+		batch_buf[--batch_len] = '\0';
+		(void)k_work_schedule(&batch_age_work,
+				      K_SECONDS(CONFIG_NRF_CLOUD_BATCH_MAX_AGE_SEC));
+
+		return err;
+	}
+
+	stats.flushes++;
+	if (reason == FLUSH_REASON_SIZE) {
+		stats.flushes_size++;
+	} else if (reason == FLUSH_REASON_AGE) {
+		stats.flushes_age++;
+	}
+
+	if (err) {
+		LOG_ERR("Failed to send batch of %d messages, error: %d", batch_msgs, err);
+		stats.msgs_dropped += batch_msgs;
+	} else {
+		stats.msgs_sent += batch_msgs;
+		stats.bytes_sent += batch_len;
+	}
+
+	batch_len = 0;
+	batch_msgs = 0;
+
+	return err;
+}
+
+static void batch_age_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	(void)batch_send(FLUSH_REASON_AGE);
+	k_mutex_unlock(&batch_lock);
+}
+
+int nrf_cloud_batch_init(nrf_cloud_batch_send_cb_t cb)
+{
+	if (initialized) {
+		return -EALREADY;
+	}
+
+	send_cb = cb ? cb : default_send;
+	initialized = true;
+
+	return 0;
+}
+
+int nrf_cloud_batch_add(struct nrf_cloud_obj *const obj)
+{
+	int err;
+	size_t needed;
+
+	if (!obj) {
+		return -EINVAL;
+	}
+
+	if (!initialized) {
+		return -EACCES;
+	}
+
+	/* nRF Cloud only accepts arrays of JSON messages on the bulk topic. */
+	if (obj->type != NRF_CLOUD_OBJ_TYPE_JSON) {
+		return -ENOTSUP;
+	}
+
+	err = nrf_cloud_obj_cloud_encode(obj);
+	if (err) {
+		LOG_ERR("Failed to encode message, error: %d", err);
+		return err;
+	}
+
+	/* Leading '[' or ',' separator followed by the message itself. */
+	needed = 1 + obj->encoded_data.len;
+	if ((needed + BATCH_ARRAY_END_LEN) > BATCH_BUF_SIZE) {
+		LOG_ERR("Message of %u bytes does not fit into the batch buffer",
+			obj->encoded_data.len);
+		err = -E2BIG;
+		goto cleanup;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	if ((batch_len + needed + BATCH_ARRAY_END_LEN) > BATCH_BUF_SIZE) {
+		(void)batch_send(FLUSH_REASON_SIZE);
+	}
+
+	/* The batch is kept while there is no connection. */
+	if ((batch_len + needed + BATCH_ARRAY_END_LEN) > BATCH_BUF_SIZE) {
+		k_mutex_unlock(&batch_lock);
+		LOG_WRN("Batch buffer is full");
+		err = -ENOMEM;
+		goto cleanup;
+	}
+
+	batch_buf[batch_len++] = batch_msgs ? ',' : '[';
+	memcpy(&batch_buf[batch_len], obj->encoded_data.ptr, obj->encoded_data.len);
+	batch_len += obj->encoded_data.len;
+
+	if (batch_msgs++ == 0) {
+		(void)k_work_schedule(&batch_age_work,
+				      K_SECONDS(CONFIG_NRF_CLOUD_BATCH_MAX_AGE_SEC));
+	}
+
+	stats.msgs_added++;
+	stats.bytes_added += obj->encoded_data.len;
+
+	if (batch_len >= BATCH_FLUSH_LEVEL) {
+		(void)batch_send(FLUSH_REASON_SIZE);
+	}
+
+	k_mutex_unlock(&batch_lock);
+
+cleanup:
+	(void)nrf_cloud_obj_cloud_encoded_free(obj);
+	if (!err) {
+		(void)nrf_cloud_obj_free(obj);
+	}
+
+	return err;
+}
+
+int nrf_cloud_batch_flush(void)
+{
+	int err;
+
+	if (!initialized) {
+		return -EACCES;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	err = batch_send(FLUSH_REASON_REQUEST);
+	k_mutex_unlock(&batch_lock);
+
+	return err;
+}
+
+int nrf_cloud_batch_pending_get(void)
+{
+	int pending;
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	pending = batch_msgs;
+	k_mutex_unlock(&batch_lock);
+
+	return pending;
+}
+
+void nrf_cloud_batch_stats_get(struct nrf_cloud_batch_stats *out)
+{
+	if (!out) {
+		return;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&batch_lock);
+}
@@ -333,6 +333,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	uint32_t gps_time_of_day = index.header.gps_time_of_day;
 	struct nrf_cloud_pgps_prediction *pred;
 	int64_t start_gps_sec = index.start_sec;
+	int64_t start_ms = k_uptime_get();
 	off_t off;
 	int64_t gps_sec;
 
@@ -344,7 +345,11 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 
 	npgps_reset_block_pool();
 
-	/* build catalog of predictions by block */
+	/* Build catalog of predictions by block, validating each one while it is
+	 * at hand. Only valid predictions are cataloged, so the pass below does not
+	 * need to access the flash again, which, for external flash, would mean
+	 * reading every prediction a second time.
+	 */
 	for (i = 0; i < count; i++) {
 		pred = (struct nrf_cloud_pgps_prediction *)get_prediction_slot(i, &off);
 		if (pred == NULL) {
@@ -357,46 +362,48 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 			LOG_ERR("prediction idx:%u, ofs:%p, out of expected time range;"
 				" day:%u, time:%u", i, (void *)pred, pred->time.date_day,
 				pred->time.time_full_s);
-		} else if (index.predictions[pnum] == NULL) {
-			index.predictions[pnum] = (struct nrf_cloud_pgps_prediction *)off;
-			LOG_DBG("Prediction num:%u stored at idx:%d, off:0x%lX",
-				pnum, i, (unsigned long) off);
-		} else {
+			continue;
+		}
+
+		if (index.predictions[pnum] != NULL) {
 			LOG_WRN("Prediction num:%u stored more than once!", pnum);
+			continue;
 		}
-	}
 
-	/* validate predictions in time order, independent of storage order */
-	i = -1;
-	for (pnum = 0; pnum < count; pnum++) {
 		/* calculate expected time signature */
 		gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
 		npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
 
-		pred = get_prediction(pnum);
-		if (pred == NULL) {
-			LOG_WRN("Prediction num:%u missing", pnum);
-			/* request partial data; download interrupted? */
-			*first_bad_day = gps_day;
-			*first_bad_time = gps_time_of_day;
-			break;
-		}
-
 		err = validate_prediction(pred, gps_day, gps_time_of_day,
 					  period_min, true, false);
 		if (err) {
 			LOG_ERR("Prediction num:%u, gps_day:%u, "
-				"gps_time_of_day:%u is bad:%d; loc:%p",
-				pnum, gps_day, gps_time_of_day, err, pred);
+				"gps_time_of_day:%u is bad:%d; idx:%d",
+				pnum, gps_day, gps_time_of_day, err, i);
+			continue;
+		}
+
+		index.predictions[pnum] = (struct nrf_cloud_pgps_prediction *)off;
+		LOG_DBG("Prediction num:%u stored at idx:%d, off:0x%lX",
+			pnum, i, (unsigned long) off);
+	}
+
+	/* find the first missing or bad prediction in time order,
+	 * independent of storage order
+	 */
+	i = -1;
+	for (pnum = 0; pnum < count; pnum++) {
+		if (index.predictions[pnum] == NULL) {
+			LOG_WRN("Prediction num:%u missing or bad", pnum);
 			/* request partial data; download interrupted? */
-			*first_bad_day = gps_day;
-			*first_bad_time = gps_time_of_day;
+			gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
+			npgps_gps_sec_to_day_time(gps_sec, first_bad_day, first_bad_time);
 			break;
 		}
 
 		i = get_prediction_block(pnum);
-		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
-		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
+		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, index.predictions[pnum], i);
+		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", index.predictions[pnum]);
 		npgps_mark_block_used(i, true);
 	}
 
@@ -415,6 +422,8 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	}
 
 	npgps_print_blocks();
+	LOG_INF("Validated %d of %u predictions in %u ms", pnum, count,
+		(uint32_t)(k_uptime_get() - start_ms));
 	return pnum;
 }
 
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * Nordic extension of the PSA Crypto API for batched AEAD operations.
+ *
+ * Protocols like 802.15.4, Bluetooth Mesh or ESB encrypt many short frames with the
+ * same key. The batched functions look up the key and check its policy once and pass
+ * all frames to the driver in a single call, so that the per-frame cost is reduced to
+ * the cryptographic operation itself.
+ */
+
+#ifndef NRF_AEAD_BATCH_H
+#define NRF_AEAD_BATCH_H
+
+#include <psa/crypto.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief A single message of a batched AEAD operation. */
+typedef struct {
+	/** Nonce, unique for each message. */
+	const uint8_t *nonce;
+	/** Length of the nonce in bytes. */
+	size_t nonce_length;
+	/** Additional data, authenticated but not encrypted. */
+	const uint8_t *additional_data;
+	/** Length of the additional data in bytes. */
+	size_t additional_data_length;
+	/** Plaintext to encrypt, or ciphertext followed by the tag to decrypt. */
+	const uint8_t *input;
+	/** Length of the input in bytes. */
+	size_t input_length;
+	/** Buffer for the ciphertext followed by the tag, or for the plaintext. */
+	uint8_t *output;
+	/** Size of the output buffer in bytes. */
+	size_t output_size;
+	/** Set to the length of the output on success. */
+	size_t output_length;
+	/** Set to the status of the operation on this message. */
+	psa_status_t status;
+} psa_aead_batch_item_t;
+
+/**
+ * @brief Encrypt and authenticate a batch of messages with the same key.
+ *
+ * Each message is processed as by @c psa_aead_encrypt. A failure of one message
+ * does not stop the processing of the remaining messages.
+ *
+ * @param[in]     key        Identifier of the key to use. It must allow the usage
+ *                           @c PSA_KEY_USAGE_ENCRYPT with the algorithm @p alg.
+ * @param[in]     alg        The AEAD algorithm to compute.
+ * @param[in,out] items      The messages to process. The @c output_length and
+ *                           @c status fields are set for each message.
+ * @param[in]     item_count Number of messages in @p items.
+ *
+ * @retval PSA_SUCCESS All messages were processed successfully.
+ * @return The status of the first failed message, or an error that prevented
+ *         processing of all messages, like @c PSA_ERROR_NOT_PERMITTED.
+ */
+psa_status_t psa_aead_encrypt_batch(mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+				    psa_aead_batch_item_t *items, size_t item_count);
+
+/**
+ * @brief Authenticate and decrypt a batch of messages with the same key.
+ *
+ * Each message is processed as by @c psa_aead_decrypt. A failure of one message,
+ * for example a tag mismatch, does not stop the processing of the remaining messages.
+ *
+ * @param[in]     key        Identifier of the key to use. It must allow the usage
+ *                           @c PSA_KEY_USAGE_DECRYPT with the algorithm @p alg.
+ * @param[in]     alg        The AEAD algorithm to compute.
+ * @param[in,out] items      The messages to process. The @c output_length and
+ *                           @c status fields are set for each message.
+ * @param[in]     item_count Number of messages in @p items.
+ *
+ * @retval PSA_SUCCESS All messages were processed successfully.
+ * @return The status of the first failed message, or an error that prevented
+ *         processing of all messages, like @c PSA_ERROR_NOT_PERMITTED.
+ */
+psa_status_t psa_aead_decrypt_batch(mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+				    psa_aead_batch_item_t *items, size_t item_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_AEAD_BATCH_H */
@@ -21,6 +21,10 @@
 #include <tfm_builtin_key_loader.h>
 #endif
 
+#if defined(CONFIG_PSA_AEAD_BATCH)
+#include <psa/nrf_aead_batch.h>
+#endif
+
 /**
  * See "PSA Cryptography API" for documentation.
  */
@@ -156,6 +160,18 @@ psa_status_t cracen_aead_verify(cracen_aead_operation_t *operation, uint8_t *pla
 
 psa_status_t cracen_aead_abort(cracen_aead_operation_t *operation);
 
+#if defined(CONFIG_PSA_AEAD_BATCH)
+psa_status_t cracen_aead_encrypt_batch(const psa_key_attributes_t *attributes,
+				       const uint8_t *key_buffer, size_t key_buffer_size,
+				       psa_algorithm_t alg, psa_aead_batch_item_t *items,
+				       size_t item_count);
+
+psa_status_t cracen_aead_decrypt_batch(const psa_key_attributes_t *attributes,
+				       const uint8_t *key_buffer, size_t key_buffer_size,
+				       psa_algorithm_t alg, psa_aead_batch_item_t *items,
+				       size_t item_count);
+#endif
+
 psa_status_t cracen_mac_compute(const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
 				size_t key_buffer_size, psa_algorithm_t alg, const uint8_t *input,
 				size_t input_length, uint8_t *mac, size_t mac_size,
@@ -698,28 +698,39 @@ static psa_status_t feed_singlepart_ccm_aad(cracen_aead_operation_t *operation,
 	return status;
 }
 
-psa_status_t cracen_aead_encrypt(const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
-				 size_t key_buffer_size, psa_algorithm_t alg, const uint8_t *nonce,
-				 size_t nonce_length, const uint8_t *additional_data,
-				 size_t additional_data_length, const uint8_t *plaintext,
-				 size_t plaintext_length, uint8_t *ciphertext,
-				 size_t ciphertext_size, size_t *ciphertext_length)
+static psa_status_t feed_singlepart_aad(cracen_aead_operation_t *operation,
+					const uint8_t *additional_data,
+					size_t additional_data_length)
 {
-	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
-	cracen_aead_operation_t operation = {0};
+	if (IS_ENABLED(PSA_NEED_CRACEN_CCM_AES) && operation->alg == PSA_ALG_CCM) {
+		/* CCM has a header which is prepended to the additional data. */
+		return feed_singlepart_ccm_aad(operation, additional_data,
+					       additional_data_length);
+	}
+
+	return cracen_feed_data_to_hw(operation, additional_data, additional_data_length, NULL,
+				      true);
+}
+
+/*
+ * Single-part encryption with an operation on which setup() has already been done.
+ * The operation is always cleared when this function returns.
+ */
+static psa_status_t encrypt_prepared(cracen_aead_operation_t *operation, const uint8_t *nonce,
+				     size_t nonce_length, const uint8_t *additional_data,
+				     size_t additional_data_length, const uint8_t *plaintext,
+				     size_t plaintext_length, uint8_t *ciphertext,
+				     size_t ciphertext_size, size_t *ciphertext_length)
+{
+	psa_status_t status;
 	size_t tag_length;
 
 	if (ciphertext_size < plaintext_length) {
-		return PSA_ERROR_BUFFER_TOO_SMALL;
-	}
-
-	status = cracen_aead_encrypt_setup(&operation, attributes,
-					   key_buffer, key_buffer_size, alg);
-	if (status != PSA_SUCCESS) {
+		status = PSA_ERROR_BUFFER_TOO_SMALL;
 		goto error_exit;
 	}
 
-	status = cracen_aead_set_lengths(&operation, additional_data_length, plaintext_length);
+	status = cracen_aead_set_lengths(operation, additional_data_length, plaintext_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
@@ -728,29 +739,22 @@ psa_status_t cracen_aead_encrypt(const psa_key_attributes_t *attributes, const u
 	 * HW context switching (process_on_hw()) in single-part operations.
 	 */
 
-	status = set_nonce(&operation, nonce, nonce_length);
+	status = set_nonce(operation, nonce, nonce_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	if (IS_ENABLED(PSA_NEED_CRACEN_CCM_AES) && operation.alg == PSA_ALG_CCM) {
-		/* CCM has a header which is prepended to the additional data. */
-		status = feed_singlepart_ccm_aad(&operation, additional_data,
-						 additional_data_length);
-	} else {
-		status = cracen_feed_data_to_hw(&operation, additional_data,
-						additional_data_length, NULL, true);
-	}
+	status = feed_singlepart_aad(operation, additional_data, additional_data_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	status = cracen_feed_data_to_hw(&operation, plaintext, plaintext_length, ciphertext, false);
+	status = cracen_feed_data_to_hw(operation, plaintext, plaintext_length, ciphertext, false);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	status = finalize_aead_encryption(&operation, &ciphertext[plaintext_length],
+	status = finalize_aead_encryption(operation, &ciphertext[plaintext_length],
 					  ciphertext_size - plaintext_length, &tag_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
@@ -761,34 +765,35 @@ psa_status_t cracen_aead_encrypt(const psa_key_attributes_t *attributes, const u
 
 error_exit:
 	*ciphertext_length = 0;
-	cracen_aead_abort(&operation);
+	cracen_aead_abort(operation);
 	return status;
 }
 
-psa_status_t cracen_aead_decrypt(const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
-				 size_t key_buffer_size, psa_algorithm_t alg, const uint8_t *nonce,
-				 size_t nonce_length, const uint8_t *additional_data,
-				 size_t additional_data_length, const uint8_t *ciphertext,
-				 size_t ciphertext_length, uint8_t *plaintext,
-				 size_t plaintext_size, size_t *plaintext_length)
+/*
+ * Single-part decryption with an operation on which setup() has already been done.
+ * The operation is always cleared when this function returns.
+ */
+static psa_status_t decrypt_prepared(cracen_aead_operation_t *operation, const uint8_t *nonce,
+				     size_t nonce_length, const uint8_t *additional_data,
+				     size_t additional_data_length, const uint8_t *ciphertext,
+				     size_t ciphertext_length, uint8_t *plaintext,
+				     size_t plaintext_size, size_t *plaintext_length)
 {
-	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
-	cracen_aead_operation_t operation = {0};
+	psa_status_t status;
 
-	status = cracen_aead_decrypt_setup(&operation, attributes,
-					   key_buffer, key_buffer_size, alg);
-	if (status != PSA_SUCCESS) {
+	if (ciphertext_length < operation->tag_size) {
+		status = PSA_ERROR_INVALID_ARGUMENT;
 		goto error_exit;
 	}
 
-	*plaintext_length = ciphertext_length - operation.tag_size;
+	*plaintext_length = ciphertext_length - operation->tag_size;
 
 	if (plaintext_size < *plaintext_length) {
 		status = PSA_ERROR_BUFFER_TOO_SMALL;
 		goto error_exit;
 	}
 
-	status = cracen_aead_set_lengths(&operation, additional_data_length, *plaintext_length);
+	status = cracen_aead_set_lengths(operation, additional_data_length, *plaintext_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
@@ -797,30 +802,23 @@ psa_status_t cracen_aead_decrypt(const psa_key_attributes_t *attributes, const u
 	 * HW context switching (process_on_hw()) in single-part operations.
 	 */
 
-	status = set_nonce(&operation, nonce, nonce_length);
+	status = set_nonce(operation, nonce, nonce_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	if (IS_ENABLED(PSA_NEED_CRACEN_CCM_AES) && operation.alg == PSA_ALG_CCM) {
-		/* CCM has a header which is prepended to the additional data. */
-		status = feed_singlepart_ccm_aad(&operation, additional_data,
-						 additional_data_length);
-	} else {
-		status = cracen_feed_data_to_hw(&operation, additional_data,
-						additional_data_length, NULL, true);
-	}
+	status = feed_singlepart_aad(operation, additional_data, additional_data_length);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	status = cracen_feed_data_to_hw(&operation, ciphertext,
+	status = cracen_feed_data_to_hw(operation, ciphertext,
 					*plaintext_length, plaintext, false);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
 
-	status = finalize_aead_decryption(&operation, &ciphertext[*plaintext_length]);
+	status = finalize_aead_decryption(operation, &ciphertext[*plaintext_length]);
 	if (status != PSA_SUCCESS) {
 		goto error_exit;
 	}
@@ -829,6 +827,130 @@ psa_status_t cracen_aead_decrypt(const psa_key_attributes_t *attributes, const u
 
 error_exit:
 	*plaintext_length = 0;
-	cracen_aead_abort(&operation);
+	cracen_aead_abort(operation);
+	return status;
+}
+
+psa_status_t cracen_aead_encrypt(const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+				 size_t key_buffer_size, psa_algorithm_t alg, const uint8_t *nonce,
+				 size_t nonce_length, const uint8_t *additional_data,
+				 size_t additional_data_length, const uint8_t *plaintext,
+				 size_t plaintext_length, uint8_t *ciphertext,
+				 size_t ciphertext_size, size_t *ciphertext_length)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	cracen_aead_operation_t operation = {0};
+
+	status = cracen_aead_encrypt_setup(&operation, attributes,
+					   key_buffer, key_buffer_size, alg);
+	if (status != PSA_SUCCESS) {
+		*ciphertext_length = 0;
+		cracen_aead_abort(&operation);
+		return status;
+	}
+
+	return encrypt_prepared(&operation, nonce, nonce_length, additional_data,
+				additional_data_length, plaintext, plaintext_length, ciphertext,
+				ciphertext_size, ciphertext_length);
+}
+
+psa_status_t cracen_aead_decrypt(const psa_key_attributes_t *attributes, const uint8_t *key_buffer,
+				 size_t key_buffer_size, psa_algorithm_t alg, const uint8_t *nonce,
+				 size_t nonce_length, const uint8_t *additional_data,
+				 size_t additional_data_length, const uint8_t *ciphertext,
+				 size_t ciphertext_length, uint8_t *plaintext,
+				 size_t plaintext_size, size_t *plaintext_length)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	cracen_aead_operation_t operation = {0};
+
+	status = cracen_aead_decrypt_setup(&operation, attributes,
+					   key_buffer, key_buffer_size, alg);
+	if (status != PSA_SUCCESS) {
+		*plaintext_length = 0;
+		cracen_aead_abort(&operation);
+		return status;
+	}
+
+	return decrypt_prepared(&operation, nonce, nonce_length, additional_data,
+				additional_data_length, ciphertext, ciphertext_length, plaintext,
+				plaintext_size, plaintext_length);
+}
+
+#if defined(CONFIG_PSA_AEAD_BATCH)
+static psa_status_t crypt_batch(enum cipher_operation dir, const psa_key_attributes_t *attributes,
+				const uint8_t *key_buffer, size_t key_buffer_size,
+				psa_algorithm_t alg, psa_aead_batch_item_t *items,
+				size_t item_count)
+{
+	psa_status_t status;
+	/* The key is validated and copied only once. Each message is then processed on a copy
+	 * of this operation, as finalizing clears it.
+	 */
+	cracen_aead_operation_t prepared = {0};
+	cracen_aead_operation_t operation;
+
+	status = setup(&prepared, dir, attributes, key_buffer, key_buffer_size, alg);
+	if (status != PSA_SUCCESS) {
+		cracen_aead_abort(&prepared);
+		for (size_t i = 0; i < item_count; i++) {
+			items[i].status = status;
+			items[i].output_length = 0;
+		}
+		return status;
+	}
+
+	for (size_t i = 0; i < item_count; i++) {
+		psa_aead_batch_item_t *item = &items[i];
+
+		memcpy(&operation, &prepared, sizeof(operation));
+
+		/* The key reference points into the operation it was loaded for, so it is
+		 * loaded again for the key copied into this operation.
+		 */
+		item->status = cracen_load_keyref(attributes, operation.key_buffer,
+						  key_buffer_size, &operation.keyref);
+		if (item->status != PSA_SUCCESS) {
+			item->output_length = 0;
+			cracen_aead_abort(&operation);
+		} else if (dir == CRACEN_ENCRYPT) {
+			item->status = encrypt_prepared(
+				&operation, item->nonce, item->nonce_length,
+				item->additional_data, item->additional_data_length, item->input,
+				item->input_length, item->output, item->output_size,
+				&item->output_length);
+		} else {
+			item->status = decrypt_prepared(
+				&operation, item->nonce, item->nonce_length,
+				item->additional_data, item->additional_data_length, item->input,
+				item->input_length, item->output, item->output_size,
+				&item->output_length);
+		}
+
+		if (item->status != PSA_SUCCESS && status == PSA_SUCCESS) {
+			status = item->status;
+		}
+	}
+
+	cracen_aead_abort(&prepared);
 	return status;
 }
+
+psa_status_t cracen_aead_encrypt_batch(const psa_key_attributes_t *attributes,
+				       const uint8_t *key_buffer, size_t key_buffer_size,
+				       psa_algorithm_t alg, psa_aead_batch_item_t *items,
+				       size_t item_count)
+{
+	return crypt_batch(CRACEN_ENCRYPT, attributes, key_buffer, key_buffer_size, alg, items,
+			   item_count);
+}
+
+psa_status_t cracen_aead_decrypt_batch(const psa_key_attributes_t *attributes,
+				       const uint8_t *key_buffer, size_t key_buffer_size,
+				       psa_algorithm_t alg, psa_aead_batch_item_t *items,
+				       size_t item_count)
+{
+	return crypt_batch(CRACEN_DECRYPT, attributes, key_buffer, key_buffer_size, alg, items,
+			   item_count);
+}
+#endif /* CONFIG_PSA_AEAD_BATCH */
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "common.h"
+#include "psa_crypto_core.h"
+#include "psa_crypto_driver_wrappers.h"
+#include "psa_crypto_slot_management.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
+#include <string.h>
+#include <psa/nrf_aead_batch.h>
+
+#if defined(PSA_NEED_CRACEN_AEAD_DRIVER)
+#include "cracen_psa.h"
+#endif
+
+/* Same rules as the core applies to the single-part AEAD functions. */
+static psa_status_t aead_batch_check_algorithm(psa_algorithm_t alg)
+{
+	uint8_t tag_length = PSA_ALG_AEAD_GET_TAG_LENGTH(alg);
+
+	if (!PSA_ALG_IS_AEAD(alg) || PSA_ALG_IS_WILDCARD(alg)) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	switch (PSA_ALG_AEAD_WITH_SHORTENED_TAG(alg, 0)) {
+	case PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, 0):
+		if (tag_length < 4 || tag_length > 16 || tag_length % 2) {
+			return PSA_ERROR_NOT_SUPPORTED;
+		}
+		break;
+	case PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_GCM, 0):
+		if (tag_length != 4 && tag_length != 8 && (tag_length < 12 || tag_length > 16)) {
+			return PSA_ERROR_NOT_SUPPORTED;
+		}
+		break;
+	case PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CHACHA20_POLY1305, 0):
+		if (tag_length != 16) {
+			return PSA_ERROR_NOT_SUPPORTED;
+		}
+		break;
+	default:
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	return PSA_SUCCESS;
+}
+
+static bool aead_batch_alg_permitted(psa_algorithm_t policy_alg, psa_algorithm_t alg)
+{
+	if (policy_alg == alg) {
+		return true;
+	}
+
+	/* A policy with a minimum tag length permits any longer tag. */
+	if (PSA_ALG_IS_AEAD(policy_alg) &&
+	    (policy_alg & PSA_ALG_AEAD_AT_LEAST_THIS_LENGTH_FLAG) != 0) {
+		return PSA_ALG_AEAD_WITH_SHORTENED_TAG(policy_alg, 0) ==
+			       PSA_ALG_AEAD_WITH_SHORTENED_TAG(alg, 0) &&
+		       PSA_ALG_AEAD_GET_TAG_LENGTH(policy_alg) <= PSA_ALG_AEAD_GET_TAG_LENGTH(alg);
+	}
+
+	return false;
+}
+
+static psa_status_t aead_batch_check_policy(const psa_key_attributes_t *attributes,
+					    psa_key_usage_t usage, psa_algorithm_t alg)
+{
+	if ((psa_get_key_usage_flags(attributes) & usage) != usage) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	if (!aead_batch_alg_permitted(psa_get_key_algorithm(attributes), alg)) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t aead_batch_check_nonce_length(psa_algorithm_t alg, size_t nonce_length)
+{
+	switch (PSA_ALG_AEAD_WITH_DEFAULT_LENGTH_TAG(alg)) {
+	case PSA_ALG_GCM:
+		return (nonce_length != 0) ? PSA_SUCCESS : PSA_ERROR_INVALID_ARGUMENT;
+	case PSA_ALG_CCM:
+		return (nonce_length >= 7 && nonce_length <= 13) ? PSA_SUCCESS
+								  : PSA_ERROR_INVALID_ARGUMENT;
+	case PSA_ALG_CHACHA20_POLY1305:
+		return (nonce_length == 12) ? PSA_SUCCESS : PSA_ERROR_INVALID_ARGUMENT;
+	default:
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+}
+
+static psa_status_t aead_batch_check_item(bool encrypt, size_t tag_length, psa_algorithm_t alg,
+					  const psa_aead_batch_item_t *item)
+{
+	psa_status_t status;
+
+	status = aead_batch_check_nonce_length(alg, item->nonce_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if ((item->nonce == NULL && item->nonce_length > 0) ||
+	    (item->additional_data == NULL && item->additional_data_length > 0) ||
+	    (item->input == NULL && item->input_length > 0) ||
+	    (item->output == NULL && item->output_size > 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (encrypt) {
+		if (item->input_length > SIZE_MAX - tag_length ||
+		    item->output_size < item->input_length + tag_length) {
+			return PSA_ERROR_BUFFER_TOO_SMALL;
+		}
+	} else if (item->input_length < tag_length) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	return PSA_SUCCESS;
+}
+
+/* Process the messages one by one, letting the driver wrappers pick the driver
+ * for each of them. The messages were validated, the key lookup and the policy
+ * check are done only once.
+ */
+static psa_status_t aead_batch_single_parts(bool encrypt, const psa_key_attributes_t *attributes,
+					    const uint8_t *key_buffer, size_t key_buffer_size,
+					    psa_algorithm_t alg, psa_aead_batch_item_t *items,
+					    size_t item_count)
+{
+	psa_status_t status = PSA_SUCCESS;
+
+	for (size_t i = 0; i < item_count; i++) {
+		psa_aead_batch_item_t *item = &items[i];
+
+		item->output_length = 0;
+
+		if (encrypt) {
+			item->status = psa_driver_wrapper_aead_encrypt(
+				attributes, key_buffer, key_buffer_size, alg, item->nonce,
+				item->nonce_length, item->additional_data,
+				item->additional_data_length, item->input, item->input_length,
+				item->output, item->output_size, &item->output_length);
+		} else {
+			item->status = psa_driver_wrapper_aead_decrypt(
+				attributes, key_buffer, key_buffer_size, alg, item->nonce,
+				item->nonce_length, item->additional_data,
+				item->additional_data_length, item->input, item->input_length,
+				item->output, item->output_size, &item->output_length);
+		}
+
+		if (item->status != PSA_SUCCESS) {
+			item->output_length = 0;
+			if (status == PSA_SUCCESS) {
+				status = item->status;
+			}
+		}
+	}
+
+	return status;
+}
+
+/* The CRACEN driver sets the status of every message when it cannot set up the key. */
+static bool aead_batch_none_processed(const psa_aead_batch_item_t *items, size_t item_count)
+{
+	for (size_t i = 0; i < item_count; i++) {
+		if (items[i].status != PSA_ERROR_NOT_SUPPORTED) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static psa_status_t aead_batch_dispatch(bool encrypt, const psa_key_attributes_t *attributes,
+					const uint8_t *key_buffer, size_t key_buffer_size,
+					psa_algorithm_t alg, psa_aead_batch_item_t *items,
+					size_t item_count)
+{
+#if defined(PSA_NEED_CRACEN_AEAD_DRIVER)
+	psa_key_location_t location = PSA_KEY_LIFETIME_GET_LOCATION(psa_get_key_lifetime(attributes));
+
+	if (location == PSA_KEY_LOCATION_LOCAL_STORAGE
+#if defined(PSA_NEED_CRACEN_KMU_DRIVER)
+	    || location == PSA_KEY_LOCATION_CRACEN_KMU
+#endif
+	) {
+		psa_status_t status;
+
+		if (encrypt) {
+			status = cracen_aead_encrypt_batch(attributes, key_buffer, key_buffer_size,
+							   alg, items, item_count);
+		} else {
+			status = cracen_aead_decrypt_batch(attributes, key_buffer, key_buffer_size,
+							   alg, items, item_count);
+		}
+
+		/* Only let the other drivers take over if no message was processed, so that
+		 * a message is never processed twice.
+		 */
+		if (status != PSA_ERROR_NOT_SUPPORTED ||
+		    !aead_batch_none_processed(items, item_count)) {
+			return status;
+		}
+	}
+#endif /* PSA_NEED_CRACEN_AEAD_DRIVER */
+
+	return aead_batch_single_parts(encrypt, attributes, key_buffer, key_buffer_size, alg,
+				       items, item_count);
+}
+
+static bool aead_batch_size_add(size_t *size, size_t length)
+{
+	if (length > SIZE_MAX - *size) {
+		return false;
+	}
+
+	*size += length;
+
+	return true;
+}
+
+/* Validate the messages and build the list passed to the drivers. Messages that fail the
+ * validation get their status set and are left out. Unless the caller buffers are known to be
+ * exclusive, the drivers work on local copies of them, as for the single-part functions.
+ */
+static psa_status_t aead_batch_local_alloc(bool encrypt, size_t tag_length, psa_algorithm_t alg,
+					   psa_aead_batch_item_t *items, size_t item_count,
+					   psa_aead_batch_item_t **local_items, size_t *local_count,
+					   size_t *local_size)
+{
+	size_t size = 0;
+	size_t count = 0;
+	uint8_t *buffer;
+
+	*local_items = NULL;
+	*local_count = 0;
+	*local_size = 0;
+
+	for (size_t i = 0; i < item_count; i++) {
+		psa_aead_batch_item_t *item = &items[i];
+
+		item->output_length = 0;
+		item->status = aead_batch_check_item(encrypt, tag_length, alg, item);
+		if (item->status != PSA_SUCCESS) {
+			continue;
+		}
+
+		count++;
+#if !defined(MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS)
+		if (!aead_batch_size_add(&size, item->nonce_length) ||
+		    !aead_batch_size_add(&size, item->additional_data_length) ||
+		    !aead_batch_size_add(&size, item->input_length) ||
+		    !aead_batch_size_add(&size, item->output_size)) {
+			return PSA_ERROR_INSUFFICIENT_MEMORY;
+		}
+#endif /* !MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS */
+	}
+
+	if (count == 0) {
+		return PSA_SUCCESS;
+	}
+
+	if (!aead_batch_size_add(&size, count * sizeof(psa_aead_batch_item_t))) {
+		return PSA_ERROR_INSUFFICIENT_MEMORY;
+	}
+
+	*local_items = mbedtls_calloc(1, size);
+	if (*local_items == NULL) {
+		return PSA_ERROR_INSUFFICIENT_MEMORY;
+	}
+
+	*local_count = count;
+	*local_size = size;
+	buffer = (uint8_t *)&(*local_items)[count];
+
+	for (size_t i = 0, j = 0; i < item_count; i++) {
+		psa_aead_batch_item_t *local = &(*local_items)[j];
+
+		if (items[i].status != PSA_SUCCESS) {
+			continue;
+		}
+
+		*local = items[i];
+		j++;
+
+#if !defined(MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS)
+		if (local->nonce_length > 0) {
+			memcpy(buffer, local->nonce, local->nonce_length);
+			local->nonce = buffer;
+			buffer += local->nonce_length;
+		}
+
+		if (local->additional_data_length > 0) {
+			memcpy(buffer, local->additional_data, local->additional_data_length);
+			local->additional_data = buffer;
+			buffer += local->additional_data_length;
+		}
+
+		if (local->input_length > 0) {
+			memcpy(buffer, local->input, local->input_length);
+			local->input = buffer;
+			buffer += local->input_length;
+		}
+
+		if (local->output_size > 0) {
+			local->output = buffer;
+			buffer += local->output_size;
+		}
+#endif /* !MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS */
+	}
+
+	return PSA_SUCCESS;
+}
+
+/* Copy the results back to the caller and free the local list. */
+static void aead_batch_local_free(psa_aead_batch_item_t *items, size_t item_count,
+				  psa_aead_batch_item_t *local_items, size_t local_size)
+{
+	if (local_items == NULL) {
+		return;
+	}
+
+	for (size_t i = 0, j = 0; i < item_count; i++) {
+		psa_aead_batch_item_t *item = &items[i];
+		const psa_aead_batch_item_t *local = &local_items[j];
+
+		if (item->status != PSA_SUCCESS) {
+			continue;
+		}
+
+		j++;
+		item->status = local->status;
+		item->output_length = (local->status == PSA_SUCCESS) ? local->output_length : 0;
+
+#if !defined(MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS)
+		if (item->output_length > 0) {
+			memcpy(item->output, local->output, item->output_length);
+		}
+#endif /* !MBEDTLS_PSA_ASSUME_EXCLUSIVE_BUFFERS */
+	}
+
+	mbedtls_platform_zeroize(local_items, local_size);
+	mbedtls_free(local_items);
+}
+
+/* Set the status of every message when the whole batch fails before processing any of them. */
+static void aead_batch_fail_all(psa_aead_batch_item_t *items, size_t item_count,
+				psa_status_t status)
+{
+	for (size_t i = 0; i < item_count; i++) {
+		items[i].output_length = 0;
+		items[i].status = status;
+	}
+}
+
+static psa_status_t aead_batch(bool encrypt, mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+			       psa_aead_batch_item_t *items, size_t item_count)
+{
+	psa_aead_batch_item_t *local_items = NULL;
+	size_t local_count = 0;
+	size_t local_size = 0;
+	psa_key_slot_t *slot = NULL;
+	psa_status_t status;
+	psa_status_t unlock_status;
+	size_t tag_length;
+
+	if (items == NULL && item_count > 0) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = aead_batch_check_algorithm(alg);
+	if (status != PSA_SUCCESS) {
+		aead_batch_fail_all(items, item_count, status);
+		return status;
+	}
+
+	/* The key slot is looked up and locked only once for the whole batch. */
+	status = psa_get_and_lock_key_slot(key, &slot);
+	if (status != PSA_SUCCESS) {
+		aead_batch_fail_all(items, item_count, status);
+		return status;
+	}
+
+	status = aead_batch_check_policy(&slot->attr,
+					 encrypt ? PSA_KEY_USAGE_ENCRYPT : PSA_KEY_USAGE_DECRYPT,
+					 alg);
+	if (status != PSA_SUCCESS) {
+		aead_batch_fail_all(items, item_count, status);
+		goto exit;
+	}
+
+	tag_length = PSA_AEAD_TAG_LENGTH(psa_get_key_type(&slot->attr),
+					 psa_get_key_bits(&slot->attr), alg);
+
+	status = aead_batch_local_alloc(encrypt, tag_length, alg, items, item_count, &local_items,
+					&local_count, &local_size);
+	if (status != PSA_SUCCESS) {
+		for (size_t i = 0; i < item_count; i++) {
+			if (items[i].status == PSA_SUCCESS) {
+				items[i].status = status;
+			}
+		}
+		goto exit;
+	}
+
+	if (local_count > 0) {
+		(void)aead_batch_dispatch(encrypt, &slot->attr, slot->key.data, slot->key.bytes,
+					  alg, local_items, local_count);
+	}
+
+	aead_batch_local_free(items, item_count, local_items, local_size);
+
+	/* Report the first failed message, including those that failed the validation. */
+	for (size_t i = 0; i < item_count; i++) {
+		if (items[i].status != PSA_SUCCESS) {
+			status = items[i].status;
+			break;
+		}
+	}
+
+exit:
+	unlock_status = psa_unregister_read_under_mutex(slot);
+
+	return (status == PSA_SUCCESS) ? unlock_status : status;
+}
+
+psa_status_t psa_aead_encrypt_batch(mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+				    psa_aead_batch_item_t *items, size_t item_count)
+{
+	return aead_batch(true, key, alg, items, item_count);
+}
+
+psa_status_t psa_aead_decrypt_batch(mbedtls_svc_key_id_t key, psa_algorithm_t alg,
+				    psa_aead_batch_item_t *items, size_t item_count)
+{
+	return aead_batch(false, key, alg, items, item_count);
+}
@@ -12,6 +12,7 @@
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/sys/util_macro.h>
 
 #include "suit_dfu_cache_internal.h"
@@ -21,6 +22,25 @@ LOG_MODULE_REGISTER(dfu_cache, CONFIG_SUIT_LOG_LEVEL);
 static bool init_done;
 static struct dfu_cache dfu_cache;
 
+#if defined(CONFIG_SUIT_CACHE_INDEX)
+/* Size of the chunks in which URIs are read back from the cache pools for comparison. */
+#define URI_COMPARE_CHUNK_SIZE 32
+
+struct cache_index_entry {
+	uint32_t uri_hash;
+	uint16_t uri_len;
+	uintptr_t uri_address;
+	uintptr_t payload_offset;
+	size_t payload_size;
+};
+
+static struct cache_index_entry cache_index[CONFIG_SUIT_CACHE_INDEX_SIZE];
+static size_t cache_index_count;
+static bool cache_index_valid;
+/* Set if all slots of all cache pools fit into the index. */
+static bool cache_index_complete;
+#endif /* CONFIG_SUIT_CACHE_INDEX */
+
 /**
  * @brief Check if current_key is same as uri
  *
@@ -59,8 +79,8 @@ struct match_uri_ctx {
  * @brief Foreach callback for matching.
  */
 static bool match_uri(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
-		      const struct zcbor_string *uri, uintptr_t payload_offset, size_t payload_size,
-		      void *ctx)
+		      const struct zcbor_string *uri, uintptr_t uri_address, uintptr_t payload_offset,
+		      size_t payload_size, void *ctx)
 {
 	struct match_uri_ctx *cb_ctx = ctx;
 
@@ -112,6 +132,154 @@ static suit_plat_err_t search_cache_pool(struct dfu_cache_pool *cache_pool,
 	return SUIT_PLAT_ERR_INVAL;
 }
 
+#if defined(CONFIG_SUIT_CACHE_INDEX)
+/**
+ * @brief FNV-1a hash of the URI.
+ */
+static uint32_t uri_hash(const uint8_t *uri, size_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= uri[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Foreach callback for adding slots to the index.
+ */
+static bool index_uri(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
+		      const struct zcbor_string *uri, uintptr_t uri_address, uintptr_t payload_offset,
+		      size_t payload_size, void *ctx)
+{
+	struct cache_index_entry *entry;
+
+	/* Skip padding slots. */
+	if (uri->len == 0) {
+		return true;
+	}
+
+	if (cache_index_count == ARRAY_SIZE(cache_index)) {
+		cache_index_complete = false;
+		return false;
+	}
+
+	entry = &cache_index[cache_index_count++];
+	entry->uri_hash = uri_hash(uri->value, uri->len);
+	entry->uri_len = uri->len;
+	entry->uri_address = uri_address;
+	entry->payload_offset = payload_offset;
+	entry->payload_size = payload_size;
+
+	return true;
+}
+
+static void index_build(void)
+{
+	cache_index_count = 0;
+	cache_index_complete = true;
+
+	for (size_t i = 0; i < dfu_cache.pools_count; i++) {
+		struct dfu_cache_pool *cache_pool = &dfu_cache.pools[i];
+
+		if (cache_pool->address == NULL) {
+			continue;
+		}
+
+		if (suit_dfu_cache_partition_slot_foreach(cache_pool, index_uri, NULL) !=
+		    SUIT_PLAT_SUCCESS) {
+			/* Fall back to decoding the cache pools for URIs not found in the index. */
+			cache_index_complete = false;
+		}
+
+		if (cache_index_count == ARRAY_SIZE(cache_index)) {
+			cache_index_complete = false;
+			break;
+		}
+	}
+
+	cache_index_valid = true;
+
+	LOG_DBG("Indexed %u cache slots%s", cache_index_count,
+		cache_index_complete ? "" : " (incomplete)");
+}
+
+/**
+ * @brief Check if the URI stored in the cache pool, pointed by the index entry, is equal to uri.
+ */
+static bool index_entry_uri_match(const struct cache_index_entry *entry, const uint8_t *uri)
+{
+	uint8_t chunk[URI_COMPARE_CHUNK_SIZE];
+
+	for (size_t offset = 0; offset < entry->uri_len; offset += sizeof(chunk)) {
+		size_t len = MIN(sizeof(chunk), entry->uri_len - offset);
+
+		if (suit_dfu_cache_memcpy(chunk, entry->uri_address + offset, len) !=
+		    SUIT_PLAT_SUCCESS) {
+			return false;
+		}
+
+		if (memcmp(chunk, &uri[offset], len) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Search the index for the URI.
+ *
+ * @retval SUIT_PLAT_SUCCESS        if the URI was found.
+ * @retval SUIT_PLAT_ERR_NOT_FOUND  if the URI is not stored in any of the cache pools.
+ * @retval SUIT_PLAT_ERR_NOMEM      if the URI is not in the index, but the index does not cover
+ *                                  all cache slots.
+ */
+static suit_plat_err_t index_search(const struct zcbor_string *uri, struct zcbor_string *payload)
+{
+	size_t uri_len = uri->len;
+	uint32_t hash;
+
+	/* Strip the NULL terminator, as URIs are stored as tstr. */
+	if (uri->value[uri_len - 1] == '\0') {
+		uri_len--;
+	}
+
+	if (uri_len == 0) {
+		/* Padding slots are not indexed. */
+		return SUIT_PLAT_ERR_NOMEM;
+	}
+
+	if (!cache_index_valid) {
+		index_build();
+	}
+
+	hash = uri_hash(uri->value, uri_len);
+
+	for (size_t i = 0; i < cache_index_count; i++) {
+		const struct cache_index_entry *entry = &cache_index[i];
+
+		if ((entry->uri_hash == hash) && (entry->uri_len == uri_len) &&
+		    index_entry_uri_match(entry, uri->value)) {
+			payload->value = (uint8_t *)entry->payload_offset;
+			payload->len = entry->payload_size;
+			return SUIT_PLAT_SUCCESS;
+		}
+	}
+
+	return cache_index_complete ? SUIT_PLAT_ERR_NOT_FOUND : SUIT_PLAT_ERR_NOMEM;
+}
+
+void suit_dfu_cache_index_invalidate(void)
+{
+	cache_index_valid = false;
+	cache_index_count = 0;
+}
+#endif /* CONFIG_SUIT_CACHE_INDEX */
+
 suit_plat_err_t suit_dfu_cache_search(const uint8_t *uri, size_t uri_size, const uint8_t **payload,
 				      size_t *payload_size)
 {
@@ -119,6 +287,23 @@ suit_plat_err_t suit_dfu_cache_search(const uint8_t *uri, size_t uri_size, const
 		struct zcbor_string tmp_payload = {.len = 0, .value = NULL};
 		struct zcbor_string tmp_uri = {.len = uri_size, .value = uri};
 
+#if defined(CONFIG_SUIT_CACHE_INDEX)
+		if (uri_size > CONFIG_SUIT_MAX_URI_LENGTH) {
+			return SUIT_PLAT_ERR_NOT_FOUND;
+		}
+
+		suit_plat_err_t err = index_search(&tmp_uri, &tmp_payload);
+
+		if (err == SUIT_PLAT_SUCCESS) {
+			*payload = tmp_payload.value;
+			*payload_size = tmp_payload.len;
+		}
+
+		if (err != SUIT_PLAT_ERR_NOMEM) {
+			return err;
+		}
+#endif /* CONFIG_SUIT_CACHE_INDEX */
+
 		for (size_t i = 0; i < dfu_cache.pools_count; i++) {
 			suit_plat_err_t ret =
 				search_cache_pool(&dfu_cache.pools[i], &tmp_uri, &tmp_payload);
@@ -188,6 +373,7 @@ suit_plat_err_t suit_dfu_cache_initialize(struct dfu_cache *cache)
 		return ret;
 	}
 
+	suit_dfu_cache_index_invalidate();
 	init_done = true;
 
 	return SUIT_PLAT_SUCCESS;
@@ -196,5 +382,6 @@ suit_plat_err_t suit_dfu_cache_initialize(struct dfu_cache *cache)
 void suit_dfu_cache_deinitialize(void)
 {
 	suit_dfu_cache_clear(&dfu_cache);
+	suit_dfu_cache_index_invalidate();
 	init_done = false;
 }
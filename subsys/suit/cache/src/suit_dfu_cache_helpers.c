@@ -156,10 +156,12 @@ suit_plat_err_t suit_dfu_cache_partition_slot_foreach(struct dfu_cache_pool *cac
 		}
 
 		if (cb) {
+			uintptr_t uri_address =
+				current_address + (uri.value - partition_header_storage);
 			uintptr_t data_address = current_address + bstr_data_offset;
 
-			result = cb(cache_pool, states, &uri, data_address, data_fragment.total_len,
-				    ctx);
+			result = cb(cache_pool, states, &uri, uri_address, data_address,
+				    data_fragment.total_len, ctx);
 		}
 
 		current_offset += (data_fragment.total_len + bstr_data_offset);
@@ -225,8 +227,8 @@ suit_plat_err_t suit_dfu_cache_partition_is_empty(struct dfu_cache_pool *cache_p
 }
 
 static bool find_free_address(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
-			      const struct zcbor_string *uri, uintptr_t payload_offset,
-			      size_t payload_size, void *ctx)
+			      const struct zcbor_string *uri, uintptr_t uri_address,
+			      uintptr_t payload_offset, size_t payload_size, void *ctx)
 {
 	uintptr_t *ret = ctx;
 	*ret = payload_offset + payload_size;
@@ -146,6 +146,8 @@ static suit_plat_err_t write_to_sink(uint8_t *address, uint8_t *data, size_t siz
 {
 	struct stream_sink sink;
 
+	suit_dfu_cache_index_invalidate();
+
 	suit_plat_err_t ret = suit_flash_sink_get(&sink, address, size);
 
 	if (ret != SUIT_PLAT_SUCCESS) {
@@ -186,6 +188,8 @@ static suit_plat_err_t erase_on_sink(uint8_t *address, size_t size)
 
 	LOG_DBG("Erasing memory: %p(size:%u)", (void *)address, size);
 
+	suit_dfu_cache_index_invalidate();
+
 	suit_plat_err_t ret = suit_flash_sink_get(&sink, address, size);
 
 	if (ret != SUIT_PLAT_SUCCESS) {
@@ -219,6 +223,8 @@ static void erase_cache_partition(struct dfu_cache_partition_ext *partition)
 		return;
 	}
 
+	suit_dfu_cache_index_invalidate();
+
 #ifdef CONFIG_SUIT_CACHE_SDFW_IPUC_ID
 	if (partition->id == CONFIG_SUIT_CACHE_SDFW_IPUC_ID) {
 		if (partition->fdev != NULL) {
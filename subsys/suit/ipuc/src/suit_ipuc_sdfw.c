@@ -18,6 +18,10 @@
 #include <suit_plat_digest_cache.h>
 #endif /* CONFIG_SUIT_DIGEST_CACHE */
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+#include <suit_plat_install_digest.h>
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 #ifdef CONFIG_SUIT_STREAM_SINK_DIGEST
 #include <suit_digest_sink.h>
 #include <psa/crypto.h>
@@ -296,6 +300,9 @@ suit_plat_err_t suit_ipuc_sdfw_write_setup(int ipc_client_id, struct zcbor_strin
 #if CONFIG_SUIT_DIGEST_CACHE
 		suit_plat_digest_cache_remove(component_id);
 #endif /* CONFIG_SUIT_DIGEST_CACHE */
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+		suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 
 
 		if (ipuc_sink.release) {
@@ -672,6 +679,9 @@ uintptr_t suit_ipuc_sdfw_mirror_addr(size_t required_size)
 #if CONFIG_SUIT_DIGEST_CACHE
 			suit_plat_digest_cache_remove(component_id);
 #endif /* CONFIG_SUIT_DIGEST_CACHE */
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+			suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 			ipuc_entry->usage = IPUC_SDFW_MIRROR;
 			k_mutex_unlock(&ipuc_mutex);
 			return adjusted_slot_address;
@@ -684,6 +694,9 @@ uintptr_t suit_ipuc_sdfw_mirror_addr(size_t required_size)
 #if CONFIG_SUIT_DIGEST_CACHE
 			suit_plat_digest_cache_remove(component_id);
 #endif /* CONFIG_SUIT_DIGEST_CACHE */
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+			suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 			ipuc_entry->usage = IPUC_SDFW_MIRROR;
 			k_mutex_unlock(&ipuc_mutex);
 			return adjusted_slot_address;
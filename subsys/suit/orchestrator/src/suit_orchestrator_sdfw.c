@@ -18,6 +18,7 @@
 #include <suit_plat_decode_util.h>
 #include <suit_mci.h>
 #include <suit_plat_digest_cache.h>
+#include <suit_plat_install_digest.h>
 #include "suit_plat_err.h"
 #include <suit_execution_mode.h>
 #include <suit_dfu_cache.h>
@@ -716,6 +717,10 @@ int suit_orchestrator_entry(void)
 	}
 #endif
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	int ret = suit_orchestrator_run();
 
 #ifdef CONFIG_SUIT_LOG_SECDOM_VERSION
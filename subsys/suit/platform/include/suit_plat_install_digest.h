@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @brief Module that keeps the digest of the most recently installed image.
+ *
+ * Installation of a MEM component is usually followed by the check-image-match condition,
+ * which reads the whole component back to calculate its digest. To avoid the second pass over
+ * the memory, the digest is calculated while the data is streamed into the destination memory
+ * and kept until the check-image-match condition for the same component is evaluated.
+ *
+ * The digest is kept only for the most recently installed component, together with the number
+ * of bytes it was calculated over. It is consumed by the first comparison and invalidated by any
+ * other operation that may modify the contents of a component, including selecting a sink for
+ * any component.
+ */
+
+#ifndef SUIT_PLAT_INSTALL_DIGEST_H__
+#define SUIT_PLAT_INSTALL_DIGEST_H__
+
+#include <suit_types.h>
+#include <suit_sink.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Append a digest filter in front of the destination sink.
+ *
+ * @details The digest is calculated on a best-effort basis. If the filter cannot be appended,
+ *          the destination sink is left untouched and the check-image-match condition falls
+ *          back to reading the component contents.
+ *
+ * @note Other filters, i.e. decryption filter, must be appended after this call, so the digest
+ *       is calculated over the data that is stored in the destination memory.
+ *
+ * @param[in,out] dst_sink Destination sink, replaced by the digest filter.
+ */
+void suit_plat_install_digest_start(struct stream_sink *dst_sink);
+
+/**
+ * @brief Store the digest calculated by the digest filter for the given component.
+ *
+ * @note Must be called after the destination sink was flushed, but before it is released.
+ *
+ * @param[in] handle The handle of the component, to which the data was written.
+ */
+void suit_plat_install_digest_store(suit_component_t handle);
+
+/**
+ * @brief Compare the digest stored for the given component with the provided one.
+ *
+ * @note The stored digest is invalidated by this call.
+ *
+ * @param[in] handle The component handle
+ * @param[in] alg_id The algorithm used to calculate the digest.
+ * @param[in] digest The CBOR string containing the digest to compare against.
+ *
+ * @retval SUIT_SUCCESS               The digests are matching
+ * @retval SUIT_FAIL_CONDITION        The digests are not matching
+ * @retval SUIT_ERR_MISSING_COMPONENT No digest with the given algorithm is stored for the
+ *                                    given component, or the component size differs from the
+ *                                    number of bytes the digest was calculated over
+ */
+int suit_plat_install_digest_compare(suit_component_t handle, enum suit_cose_alg alg_id,
+				     const struct zcbor_string *digest);
+
+/**
+ * @brief Invalidate the stored digest.
+ */
+void suit_plat_install_digest_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUIT_PLAT_INSTALL_DIGEST_H__ */
@@ -9,6 +9,7 @@
 #include <suit_platform.h>
 
 #include <suit_plat_digest_cache.h>
+#include <suit_plat_install_digest.h>
 #include <suit_plat_decode_util.h>
 #include <psa/crypto.h>
 
@@ -84,6 +85,13 @@ int suit_plat_check_image_match_domain_specific(suit_component_t component,
 
 	switch (component_type) {
 	case SUIT_COMPONENT_TYPE_MEM:
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+		/* Use the digest calculated while the component was installed, if available. */
+		err = suit_plat_install_digest_compare(component, alg_id, digest);
+		if (err != SUIT_ERR_MISSING_COMPONENT) {
+			break;
+		}
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 		err = suit_plat_check_image_match_mem_mapped(component, alg_id, digest);
 		break;
 	case SUIT_COMPONENT_TYPE_SOC_SPEC: {
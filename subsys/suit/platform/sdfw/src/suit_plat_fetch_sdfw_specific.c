@@ -41,6 +41,10 @@
 #include <suit_plat_digest_cache.h>
 #endif /* CONFIG_SUIT_DIGEST_CACHE */
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+#include <suit_plat_install_digest.h>
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 #if defined(CONFIG_SUIT_IPUC)
 #include <suit_ipuc_sdfw.h>
 #endif /* CONFIG_SUIT_IPUC */
@@ -147,6 +151,13 @@ static int suit_plat_fetch_mem(suit_component_t dst_handle, struct zcbor_string
 		return ret;
 	}
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	/* Calculate the digest of the data, written into the destination memory. */
+	if (!dry_run) {
+		suit_plat_install_digest_start(&dst_sink);
+	}
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	/* Append decryption filter if encryption info is provided. */
 	if (enc_info != NULL) {
 #ifdef CONFIG_SUIT_STREAM_FILTER_DECRYPT
@@ -235,6 +246,12 @@ static int suit_plat_fetch_mem(suit_component_t dst_handle, struct zcbor_string
 				}
 			}
 		}
+
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+		if (ret == SUIT_SUCCESS) {
+			suit_plat_install_digest_store(dst_handle);
+		}
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 	}
 
 	/*
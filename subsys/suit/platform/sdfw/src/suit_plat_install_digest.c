@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <suit_plat_install_digest.h>
+#include <suit_digest_filter.h>
+#include <suit_platform_internal.h>
+#include <suit_memptr_storage.h>
+#include <psa/crypto.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(suit_plat_install_digest, CONFIG_SUIT_LOG_LEVEL);
+
+#if defined(CONFIG_SUIT_INSTALL_DIGEST_ALG_SHA_512)
+#define INSTALL_DIGEST_PSA_ALG	PSA_ALG_SHA_512
+#define INSTALL_DIGEST_COSE_ALG suit_cose_sha512
+#else
+#define INSTALL_DIGEST_PSA_ALG	PSA_ALG_SHA_256
+#define INSTALL_DIGEST_COSE_ALG suit_cose_sha256
+#endif
+
+static struct {
+	/* Context of the digest filter, appended to the currently constructed stream. */
+	void *filter_ctx;
+	suit_component_t handle;
+	uint8_t digest[PSA_HASH_LENGTH(INSTALL_DIGEST_PSA_ALG)];
+	size_t digest_len;
+	/* Number of bytes the digest was calculated over. */
+	size_t data_len;
+	bool valid;
+} install_digest;
+
+static K_MUTEX_DEFINE(install_digest_mutex);
+
+void suit_plat_install_digest_start(struct stream_sink *dst_sink)
+{
+	suit_plat_err_t plat_ret;
+
+	k_mutex_lock(&install_digest_mutex, K_FOREVER);
+
+	install_digest.valid = false;
+	install_digest.filter_ctx = NULL;
+
+	plat_ret = suit_digest_filter_get(dst_sink, INSTALL_DIGEST_PSA_ALG, dst_sink);
+	if (plat_ret == SUIT_PLAT_SUCCESS) {
+		install_digest.filter_ctx = dst_sink->ctx;
+	} else {
+		LOG_WRN("Unable to calculate digest while installing: %i", plat_ret);
+	}
+
+	k_mutex_unlock(&install_digest_mutex);
+}
+
+void suit_plat_install_digest_store(suit_component_t handle)
+{
+	suit_plat_err_t plat_ret = SUIT_PLAT_ERR_INCORRECT_STATE;
+
+	k_mutex_lock(&install_digest_mutex, K_FOREVER);
+
+	if (install_digest.filter_ctx != NULL) {
+		plat_ret = suit_digest_filter_digest_get(
+			install_digest.filter_ctx, install_digest.digest,
+			sizeof(install_digest.digest), &install_digest.digest_len,
+			&install_digest.data_len);
+	}
+
+	install_digest.valid = (plat_ret == SUIT_PLAT_SUCCESS);
+	install_digest.handle = handle;
+	install_digest.filter_ctx = NULL;
+
+	k_mutex_unlock(&install_digest_mutex);
+
+	if (plat_ret != SUIT_PLAT_SUCCESS) {
+		LOG_DBG("Digest of the installed image not available: %i", plat_ret);
+	}
+}
+
+/* The digest covers the whole component only if the component size was not changed since. */
+static bool component_size_matches(suit_component_t handle, size_t data_len)
+{
+	void *impl_data = NULL;
+	const uint8_t *data = NULL;
+	size_t size = 0;
+
+	if (suit_plat_component_impl_data_get(handle, &impl_data) != SUIT_SUCCESS) {
+		return false;
+	}
+
+	if (suit_memptr_storage_ptr_get((memptr_storage_handle_t)impl_data, &data, &size) !=
+	    SUIT_PLAT_SUCCESS) {
+		return false;
+	}
+
+	if (size != data_len) {
+		LOG_DBG("Component size %zu differs from the installed %zu bytes", size, data_len);
+		return false;
+	}
+
+	return true;
+}
+
+int suit_plat_install_digest_compare(suit_component_t handle, enum suit_cose_alg alg_id,
+				     const struct zcbor_string *digest)
+{
+	int ret = SUIT_ERR_MISSING_COMPONENT;
+
+	k_mutex_lock(&install_digest_mutex, K_FOREVER);
+
+	if (install_digest.valid && (install_digest.handle == handle) &&
+	    (alg_id == INSTALL_DIGEST_COSE_ALG) &&
+	    component_size_matches(handle, install_digest.data_len)) {
+		if ((digest->len == install_digest.digest_len) &&
+		    (memcmp(digest->value, install_digest.digest, digest->len) == 0)) {
+			ret = SUIT_SUCCESS;
+		} else {
+			ret = SUIT_FAIL_CONDITION;
+		}
+	}
+
+	install_digest.valid = false;
+
+	k_mutex_unlock(&install_digest_mutex);
+
+	return ret;
+}
+
+void suit_plat_install_digest_invalidate(void)
+{
+	k_mutex_lock(&install_digest_mutex, K_FOREVER);
+	install_digest.valid = false;
+	k_mutex_unlock(&install_digest_mutex);
+}
@@ -30,6 +30,10 @@
 #include <suit_decrypt_filter.h>
 #endif /* CONFIG_SUIT_STREAM_FILTER_DECRYPT */
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+#include <suit_plat_install_digest.h>
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 LOG_MODULE_DECLARE(suit_plat_write, CONFIG_SUIT_LOG_LEVEL);
 
 bool suit_plat_write_domain_specific_is_type_supported(suit_component_type_t component_type)
@@ -155,6 +159,13 @@ int suit_plat_write_domain_specific(suit_component_t dst_handle,
 		return ret;
 	}
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	/* Calculate the digest of the data, written into the destination memory. */
+	if (dst_component_type == SUIT_COMPONENT_TYPE_MEM) {
+		suit_plat_install_digest_start(&dst_sink);
+	}
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	/* Append decryption filter if encryption info is provided. */
 	if (enc_info != NULL) {
 #ifdef CONFIG_SUIT_STREAM_FILTER_DECRYPT
@@ -163,6 +174,7 @@ int suit_plat_write_domain_specific(suit_component_t dst_handle,
 		if (suit_plat_decode_manifest_class_id(manifest_component_id, &class_id) !=
 		    SUIT_PLAT_SUCCESS) {
 			LOG_ERR("Component ID is not a manifest class");
+			(void)release_sink(&dst_sink);
 			return SUIT_ERR_UNSUPPORTED_COMPONENT_ID;
 		}
 
@@ -237,6 +249,12 @@ int suit_plat_write_domain_specific(suit_component_t dst_handle,
 		}
 	}
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	if ((ret == SUIT_SUCCESS) && (dst_component_type == SUIT_COMPONENT_TYPE_MEM)) {
+		suit_plat_install_digest_store(dst_handle);
+	}
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	/*
 	 * Destroy the stream.
 	 */
@@ -29,6 +29,9 @@
 #ifdef CONFIG_SUIT_STREAM_SINK_EXTMEM
 #include <suit_extmem_sink.h>
 #endif /* CONFIG_SUIT_STREAM_SINK_EXTMEM */
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+#include <suit_plat_install_digest.h>
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
 
 LOG_MODULE_REGISTER(suit_plat_sink_selector, CONFIG_SUIT_LOG_LEVEL);
 
@@ -43,6 +46,11 @@ int suit_sink_select(suit_component_t dst_handle, struct stream_sink *sink)
 
 	suit_component_type_t component_type = SUIT_COMPONENT_TYPE_UNSUPPORTED;
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	/* The returned sink may modify memory, covered by the digest of the installed image. */
+	suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	ret = suit_plat_component_id_get(dst_handle, &component_id);
 
 	if (ret != SUIT_SUCCESS) {
@@ -15,6 +15,10 @@
 #include <suit_storage_mpi.h>
 #endif
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+#include <suit_plat_install_digest.h>
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 LOG_MODULE_REGISTER(plat_components, CONFIG_SUIT_LOG_LEVEL);
 
 struct suit_plat_component {
@@ -73,6 +77,11 @@ int suit_plat_release_component_handle(suit_component_t handle)
 		return SUIT_ERR_UNSUPPORTED_COMPONENT_ID;
 	}
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	/* The handle may be reused for a different component. */
+	suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	suit_component_type_t component_type = SUIT_COMPONENT_TYPE_UNSUPPORTED;
 
 	if (suit_plat_decode_component_type(&component->component_id, &component_type) !=
@@ -250,6 +259,10 @@ int suit_plat_override_image_size(suit_component_t handle, size_t size,
 	}
 #endif
 
+#ifdef CONFIG_SUIT_INSTALL_DIGEST
+	suit_plat_install_digest_invalidate();
+#endif /* CONFIG_SUIT_INSTALL_DIGEST */
+
 	/* Size override is done only for MEM type component */
 	if (component_type == SUIT_COMPONENT_TYPE_MEM) {
 		intptr_t run_address;
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SUIT_DIGEST_FILTER_H__
+#define SUIT_DIGEST_FILTER_H__
+
+#include <suit_sink.h>
+#include <psa/crypto.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get digest filter object
+ *
+ * @details The filter passes all data to the output sink and calculates the digest of the data,
+ *          that was successfully written to the output sink. This allows to obtain the digest
+ *          of the written image without reading it back.
+ *
+ * @note The digest is valid only if the data is written sequentially, from the beginning of the
+ *       output sink. Any call to the erase or seek API after the first write invalidates the
+ *       digest.
+ *
+ * @param[out] in_sink    Pointer to input sink_stream to pass data
+ * @param[in]  algorithm  Algorithm to be used for digest calculation
+ * @param[in]  out_sink   Pointer to output sink_stream to be filled with data
+ *
+ * @return SUIT_PLAT_SUCCESS if success otherwise error code
+ */
+suit_plat_err_t suit_digest_filter_get(struct stream_sink *in_sink, psa_algorithm_t algorithm,
+				       struct stream_sink *out_sink);
+
+/**
+ * @brief Finalize the digest calculation and read the digest of the data written so far
+ *
+ * @note The filter has to be flushed before calling this function.
+ *       After this function is called, the filter rejects any call that modifies the output
+ *       sink, so the digest stays valid until the filter is released.
+ *
+ * @param[in]  ctx            Context of the digest filter
+ * @param[out] digest         Buffer for the digest
+ * @param[in]  digest_size    Size of the digest buffer
+ * @param[out] digest_length  Length of the digest
+ * @param[out] data_length    Number of bytes the digest was calculated over
+ *
+ * @return SUIT_PLAT_SUCCESS if success
+ * @return SUIT_PLAT_ERR_INVAL Invalid arguments
+ * @return SUIT_PLAT_ERR_INCORRECT_STATE The digest is not available, i.e. the filter was not
+ *         initialized, the digest was already read, or the output sink was erased or sought
+ *         after the data was written
+ * @return SUIT_PLAT_ERR_CRASH The digest could not be calculated
+ */
+suit_plat_err_t suit_digest_filter_digest_get(void *ctx, uint8_t *digest, size_t digest_size,
+					      size_t *digest_length, size_t *data_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUIT_DIGEST_FILTER_H__ */
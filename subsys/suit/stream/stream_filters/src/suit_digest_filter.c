@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/logging/log.h>
+#include <suit_digest_filter.h>
+
+LOG_MODULE_REGISTER(suit_digest_filter, CONFIG_SUIT_LOG_LEVEL);
+
+struct digest_filter_ctx {
+	psa_hash_operation_t operation;
+	struct stream_sink out_sink;
+	size_t written;
+	bool digest_valid;
+	bool finalized;
+	bool in_use;
+};
+
+/**
+ * Only a single digest filter can be used at a time.
+ */
+static struct digest_filter_ctx filter_ctx;
+
+static void digest_invalidate(struct digest_filter_ctx *digest_ctx)
+{
+	if (digest_ctx->digest_valid) {
+		(void)psa_hash_abort(&digest_ctx->operation);
+		digest_ctx->digest_valid = false;
+	}
+}
+
+static suit_plat_err_t erase(void *ctx)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if (ctx == NULL) {
+		LOG_ERR("Invalid arguments - digest ctx is NULL");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (digest_ctx->finalized) {
+		LOG_ERR("Digest already read, output sink cannot be modified");
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	if (digest_ctx->written > 0) {
+		LOG_DBG("Output sink erased after write, digest not available");
+		digest_invalidate(digest_ctx);
+	}
+
+	if (digest_ctx->out_sink.erase != NULL) {
+		return digest_ctx->out_sink.erase(digest_ctx->out_sink.ctx);
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t write(void *ctx, const uint8_t *buf, size_t size)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if ((ctx == NULL) || (buf == NULL) || (size == 0)) {
+		LOG_ERR("Invalid arguments.");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (!digest_ctx->in_use) {
+		LOG_ERR("Digest filter not initialized.");
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	if (digest_ctx->finalized) {
+		LOG_ERR("Digest already read, output sink cannot be modified");
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	suit_plat_err_t err = digest_ctx->out_sink.write(digest_ctx->out_sink.ctx, buf, size);
+
+	if (err != SUIT_PLAT_SUCCESS) {
+		return err;
+	}
+
+	digest_ctx->written += size;
+
+	if (digest_ctx->digest_valid) {
+		psa_status_t status = psa_hash_update(&digest_ctx->operation, buf, size);
+
+		if (status != PSA_SUCCESS) {
+			/* The data was written, only the digest is lost. */
+			LOG_WRN("Failed to update digest: %d", status);
+			digest_invalidate(digest_ctx);
+		}
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t seek(void *ctx, size_t offset)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if (ctx == NULL) {
+		LOG_ERR("Invalid arguments - digest ctx is NULL");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (digest_ctx->out_sink.seek == NULL) {
+		return SUIT_PLAT_ERR_UNSUPPORTED;
+	}
+
+	if (digest_ctx->finalized) {
+		LOG_ERR("Digest already read, output sink cannot be modified");
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	if (offset != digest_ctx->written) {
+		LOG_DBG("Non-sequential write, digest not available");
+		digest_invalidate(digest_ctx);
+	}
+
+	return digest_ctx->out_sink.seek(digest_ctx->out_sink.ctx, offset);
+}
+
+static suit_plat_err_t flush(void *ctx)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if (ctx == NULL) {
+		LOG_ERR("Invalid arguments - digest ctx is NULL");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (digest_ctx->out_sink.flush != NULL) {
+		return digest_ctx->out_sink.flush(digest_ctx->out_sink.ctx);
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t used_storage(void *ctx, size_t *size)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if ((ctx == NULL) || (size == NULL)) {
+		LOG_ERR("Invalid arguments.");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (digest_ctx->out_sink.used_storage != NULL) {
+		return digest_ctx->out_sink.used_storage(digest_ctx->out_sink.ctx, size);
+	}
+
+	return SUIT_PLAT_ERR_UNSUPPORTED;
+}
+
+static suit_plat_err_t release(void *ctx)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+	suit_plat_err_t res = SUIT_PLAT_SUCCESS;
+
+	if (ctx == NULL) {
+		LOG_ERR("Invalid arguments - digest ctx is NULL");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	digest_invalidate(digest_ctx);
+
+	if (digest_ctx->out_sink.release != NULL) {
+		res = digest_ctx->out_sink.release(digest_ctx->out_sink.ctx);
+	}
+
+	memset(digest_ctx, 0, sizeof(*digest_ctx));
+
+	return res;
+}
+
+suit_plat_err_t suit_digest_filter_get(struct stream_sink *in_sink, psa_algorithm_t algorithm,
+				       struct stream_sink *out_sink)
+{
+	if ((in_sink == NULL) || (out_sink == NULL) || (out_sink->write == NULL)) {
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (filter_ctx.in_use) {
+		LOG_ERR("The digest filter is busy");
+		return SUIT_PLAT_ERR_BUSY;
+	}
+
+	psa_status_t status = psa_crypto_init();
+
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to init psa crypto: %d", status);
+		return SUIT_PLAT_ERR_CRASH;
+	}
+
+	filter_ctx.operation = psa_hash_operation_init();
+	status = psa_hash_setup(&filter_ctx.operation, algorithm);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to setup hash algorithm: %d", status);
+		return SUIT_PLAT_ERR_CRASH;
+	}
+
+	filter_ctx.in_use = true;
+	filter_ctx.digest_valid = true;
+	filter_ctx.finalized = false;
+	filter_ctx.written = 0;
+	memcpy(&filter_ctx.out_sink, out_sink, sizeof(struct stream_sink));
+
+	in_sink->ctx = &filter_ctx;
+	in_sink->erase = erase;
+	in_sink->write = write;
+	in_sink->seek = seek;
+	in_sink->flush = flush;
+	in_sink->used_storage = used_storage;
+	in_sink->release = release;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+suit_plat_err_t suit_digest_filter_digest_get(void *ctx, uint8_t *digest, size_t digest_size,
+					      size_t *digest_length, size_t *data_length)
+{
+	struct digest_filter_ctx *digest_ctx = (struct digest_filter_ctx *)ctx;
+
+	if ((ctx == NULL) || (digest == NULL) || (digest_length == NULL) ||
+	    (data_length == NULL)) {
+		LOG_ERR("Invalid arguments.");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (!digest_ctx->in_use || !digest_ctx->digest_valid) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	psa_status_t status =
+		psa_hash_finish(&digest_ctx->operation, digest, digest_size, digest_length);
+
+	/* The operation is reset by psa_hash_finish, regardless of the result. */
+	digest_ctx->digest_valid = false;
+	digest_ctx->finalized = true;
+
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to finish digest: %d", status);
+		(void)psa_hash_abort(&digest_ctx->operation);
+		return SUIT_PLAT_ERR_CRASH;
+	}
+
+	*data_length = digest_ctx->written;
+
+	return SUIT_PLAT_SUCCESS;
+}
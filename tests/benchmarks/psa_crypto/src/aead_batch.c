@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Functional test of the batched AEAD API, compared with the single-part functions.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <psa/crypto.h>
+
+#if defined(CONFIG_PSA_AEAD_BATCH)
+#include <psa/nrf_aead_batch.h>
+
+#define BATCH_COUNT   4
+#define MESSAGE_SIZE  48
+#define TAG_SIZE      16
+#define KEY_BITS      256
+#define AD_SIZE	      16
+#define NONCE_SIZE    12
+
+static uint8_t plaintext[BATCH_COUNT][MESSAGE_SIZE];
+static uint8_t ciphertext[BATCH_COUNT][MESSAGE_SIZE + TAG_SIZE];
+static uint8_t decrypted[BATCH_COUNT][MESSAGE_SIZE];
+static uint8_t nonce[BATCH_COUNT][NONCE_SIZE];
+static uint8_t ad[AD_SIZE];
+static psa_aead_batch_item_t items[BATCH_COUNT];
+
+static psa_key_id_t import_key(psa_algorithm_t alg, psa_key_usage_t usage)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	uint8_t key[PSA_BITS_TO_BYTES(KEY_BITS)];
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	memset(key, 0x5a, sizeof(key));
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_AES);
+	psa_set_key_algorithm(&attr, alg);
+	psa_set_key_usage_flags(&attr, usage);
+	psa_set_key_bits(&attr, KEY_BITS);
+	psa_set_key_lifetime(&attr, PSA_KEY_LIFETIME_VOLATILE);
+
+	status = psa_import_key(&attr, key, sizeof(key), &key_id);
+	zassert_equal(status, PSA_SUCCESS, "psa_import_key failed: %d", status);
+
+	return key_id;
+}
+
+static void encrypt_items_init(void)
+{
+	for (size_t i = 0; i < BATCH_COUNT; i++) {
+		items[i] = (psa_aead_batch_item_t){
+			.nonce = nonce[i],
+			.nonce_length = NONCE_SIZE,
+			.additional_data = ad,
+			.additional_data_length = sizeof(ad),
+			.input = plaintext[i],
+			.input_length = MESSAGE_SIZE,
+			.output = ciphertext[i],
+			.output_size = sizeof(ciphertext[i]),
+		};
+	}
+}
+
+static void decrypt_items_init(void)
+{
+	for (size_t i = 0; i < BATCH_COUNT; i++) {
+		items[i] = (psa_aead_batch_item_t){
+			.nonce = nonce[i],
+			.nonce_length = NONCE_SIZE,
+			.additional_data = ad,
+			.additional_data_length = sizeof(ad),
+			.input = ciphertext[i],
+			.input_length = sizeof(ciphertext[i]),
+			.output = decrypted[i],
+			.output_size = sizeof(decrypted[i]),
+		};
+	}
+}
+
+static void *psa_aead_batch_setup(void)
+{
+	psa_status_t status = psa_crypto_init();
+
+	zassert_equal(status, PSA_SUCCESS, "psa_crypto_init failed: %d", status);
+
+	return NULL;
+}
+
+static void psa_aead_batch_before(void *fixture)
+{
+	psa_status_t status;
+
+	ARG_UNUSED(fixture);
+
+	status = psa_generate_random((uint8_t *)plaintext, sizeof(plaintext));
+	zassert_equal(status, PSA_SUCCESS, "psa_generate_random failed: %d", status);
+
+	status = psa_generate_random((uint8_t *)nonce, sizeof(nonce));
+	zassert_equal(status, PSA_SUCCESS, "psa_generate_random failed: %d", status);
+
+	memset(ad, 0xa5, sizeof(ad));
+	memset(ciphertext, 0, sizeof(ciphertext));
+	memset(decrypted, 0, sizeof(decrypted));
+}
+
+static void roundtrip(psa_algorithm_t alg)
+{
+	uint8_t single[MESSAGE_SIZE + TAG_SIZE];
+	psa_key_id_t key_id;
+	psa_status_t status;
+	size_t length;
+
+	key_id = import_key(alg, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+
+	encrypt_items_init();
+	status = psa_aead_encrypt_batch(key_id, alg, items, BATCH_COUNT);
+	zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt_batch failed: %d", status);
+
+	for (size_t i = 0; i < BATCH_COUNT; i++) {
+		zassert_equal(items[i].status, PSA_SUCCESS, "Message %zu failed", i);
+		zassert_equal(items[i].output_length, MESSAGE_SIZE + TAG_SIZE,
+			      "Invalid ciphertext length of message %zu", i);
+
+		/* The batch produces the same ciphertext as the single-part function. */
+		status = psa_aead_encrypt(key_id, alg, nonce[i], NONCE_SIZE, ad, sizeof(ad),
+					  plaintext[i], MESSAGE_SIZE, single, sizeof(single),
+					  &length);
+		zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt failed: %d", status);
+		zassert_mem_equal(ciphertext[i], single, length,
+				  "Ciphertext of message %zu does not match", i);
+	}
+
+	decrypt_items_init();
+	status = psa_aead_decrypt_batch(key_id, alg, items, BATCH_COUNT);
+	zassert_equal(status, PSA_SUCCESS, "psa_aead_decrypt_batch failed: %d", status);
+
+	for (size_t i = 0; i < BATCH_COUNT; i++) {
+		zassert_equal(items[i].status, PSA_SUCCESS, "Message %zu failed", i);
+		zassert_equal(items[i].output_length, MESSAGE_SIZE,
+			      "Invalid plaintext length of message %zu", i);
+		zassert_mem_equal(decrypted[i], plaintext[i], MESSAGE_SIZE,
+				  "Decrypted message %zu does not match the input", i);
+	}
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_aead_batch, test_roundtrip_ccm)
+{
+	roundtrip(PSA_ALG_CCM);
+}
+
+ZTEST(psa_aead_batch, test_roundtrip_gcm)
+{
+	roundtrip(PSA_ALG_GCM);
+}
+
+ZTEST(psa_aead_batch, test_invalid_items)
+{
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	key_id = import_key(PSA_ALG_GCM, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT);
+
+	encrypt_items_init();
+	status = psa_aead_encrypt_batch(key_id, PSA_ALG_GCM, items, BATCH_COUNT);
+	zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt_batch failed: %d", status);
+
+	decrypt_items_init();
+	/* Tampered tag, no nonce and ciphertext shorter than the tag. */
+	ciphertext[0][MESSAGE_SIZE] ^= 0x01;
+	items[1].nonce_length = 0;
+	items[2].input_length = TAG_SIZE - 1;
+
+	status = psa_aead_decrypt_batch(key_id, PSA_ALG_GCM, items, BATCH_COUNT);
+	zassert_equal(status, PSA_ERROR_INVALID_SIGNATURE, "Unexpected status: %d", status);
+
+	zassert_equal(items[0].status, PSA_ERROR_INVALID_SIGNATURE, "Tampered tag accepted");
+	zassert_equal(items[0].output_length, 0, "Output of a failed message");
+	zassert_equal(items[1].status, PSA_ERROR_INVALID_ARGUMENT, "Empty nonce accepted");
+	zassert_equal(items[2].status, PSA_ERROR_INVALID_ARGUMENT, "Short ciphertext accepted");
+
+	/* A failure of one message does not stop the remaining ones. */
+	zassert_equal(items[3].status, PSA_SUCCESS, "Message 3 failed");
+	zassert_mem_equal(decrypted[3], plaintext[3], MESSAGE_SIZE,
+			  "Decrypted message 3 does not match the input");
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_aead_batch, test_policy)
+{
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	key_id = import_key(PSA_ALG_GCM, PSA_KEY_USAGE_ENCRYPT);
+
+	decrypt_items_init();
+	status = psa_aead_decrypt_batch(key_id, PSA_ALG_GCM, items, BATCH_COUNT);
+	zassert_equal(status, PSA_ERROR_NOT_PERMITTED, "Decryption permitted: %d", status);
+
+	/* The status is set for each message also when the whole batch is rejected. */
+	for (size_t i = 0; i < BATCH_COUNT; i++) {
+		zassert_equal(items[i].status, PSA_ERROR_NOT_PERMITTED,
+			      "Unexpected status of message %zu", i);
+		zassert_equal(items[i].output_length, 0, "Output of a rejected message %zu", i);
+	}
+
+	encrypt_items_init();
+	status = psa_aead_encrypt_batch(key_id, PSA_ALG_CCM, items, BATCH_COUNT);
+	zassert_equal(status, PSA_ERROR_NOT_PERMITTED, "Other algorithm permitted: %d", status);
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST_SUITE(psa_aead_batch, NULL, psa_aead_batch_setup, psa_aead_batch_before, NULL, NULL);
+#endif /* CONFIG_PSA_AEAD_BATCH */
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Benchmark of PSA crypto operations, as dispatched to the enabled drivers.
+ *
+ * Every measurement is printed on a separate line in the following format,
+ * so that the results can be extracted from the console log and compared
+ * between builds:
+ *
+ * BENCH,<operation>,<algorithm>,<input size>,<iterations>,<time per operation [ns]>,<kB/s>
+ *
+ * The throughput is 0 for operations that do not process a message.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <psa/crypto.h>
+#if defined(CONFIG_PSA_AEAD_BATCH)
+#include <psa/nrf_aead_batch.h>
+#endif
+
+#define ITERATIONS	 CONFIG_PSA_CRYPTO_BENCHMARK_ITERATIONS
+#define ASYM_ITERATIONS	 MAX(ITERATIONS / 4, 1)
+#define MAX_MESSAGE_SIZE 4096
+
+#define AEAD_KEY_SIZE 32
+#define AEAD_TAG_SIZE 16
+#define AEAD_AD_SIZE  16
+
+/* Batch of short radio frames, processed with one key. */
+#define AEAD_BATCH_COUNT	16
+#define AEAD_BATCH_MESSAGE_SIZE 64
+
+/* Sizes of typical short protocol messages, network packets and flash pages. */
+static const size_t message_sizes[] = {16, 64, 256, 1024, MAX_MESSAGE_SIZE};
+
+static uint8_t message[MAX_MESSAGE_SIZE];
+static uint8_t output[MAX_MESSAGE_SIZE + AEAD_TAG_SIZE];
+
+struct bench {
+	timing_t start;
+	uint64_t total_ns;
+	uint32_t iterations;
+};
+
+static void bench_start(struct bench *bench)
+{
+	bench->start = timing_counter_get();
+}
+
+static void bench_stop(struct bench *bench)
+{
+	timing_t end = timing_counter_get();
+
+	bench->total_ns += timing_cycles_to_ns(timing_cycles_get(&bench->start, &end));
+	bench->iterations++;
+}
+
+static void bench_report(const char *operation, const char *algorithm, size_t size,
+			 const struct bench *bench)
+{
+	uint32_t ns_per_op = (uint32_t)(bench->total_ns / bench->iterations);
+	uint32_t kbps = 0;
+
+	if (size > 0 && ns_per_op > 0) {
+		kbps = (uint32_t)(((uint64_t)size * NSEC_PER_SEC) / ((uint64_t)ns_per_op * 1024));
+	}
+
+	TC_PRINT("BENCH,%s,%s,%zu,%u,%u,%u\n", operation, algorithm, size, bench->iterations,
+		 ns_per_op, kbps);
+}
+
+static psa_key_id_t generate_key(psa_key_type_t type, psa_algorithm_t alg,
+				 psa_key_usage_t usage, size_t bits)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	psa_set_key_type(&attr, type);
+	psa_set_key_algorithm(&attr, alg);
+	psa_set_key_usage_flags(&attr, usage);
+	psa_set_key_bits(&attr, bits);
+	psa_set_key_lifetime(&attr, PSA_KEY_LIFETIME_VOLATILE);
+
+	status = psa_generate_key(&attr, &key_id);
+	zassert_equal(status, PSA_SUCCESS, "psa_generate_key failed: %d", status);
+
+	psa_reset_key_attributes(&attr);
+
+	return key_id;
+}
+
+static void bench_hash(psa_algorithm_t alg, const char *name)
+{
+	uint8_t digest[PSA_HASH_MAX_SIZE];
+	size_t digest_len;
+	psa_status_t status;
+
+	for (size_t i = 0; i < ARRAY_SIZE(message_sizes); i++) {
+		struct bench bench = {0};
+
+		for (int n = 0; n < ITERATIONS; n++) {
+			bench_start(&bench);
+			status = psa_hash_compute(alg, message, message_sizes[i], digest,
+						  sizeof(digest), &digest_len);
+			bench_stop(&bench);
+			zassert_equal(status, PSA_SUCCESS, "psa_hash_compute failed: %d", status);
+		}
+
+		bench_report("hash", name, message_sizes[i], &bench);
+	}
+}
+
+ZTEST(psa_crypto_benchmark, test_hash)
+{
+	bench_hash(PSA_ALG_SHA_256, "sha256");
+	bench_hash(PSA_ALG_SHA_512, "sha512");
+}
+
+/* The cost of a call that does no cryptographic work shows the overhead of the PSA core
+ * and the driver dispatch, which is paid by every operation.
+ */
+ZTEST(psa_crypto_benchmark, test_dispatch)
+{
+	psa_hash_operation_t operation;
+	struct bench bench = {0};
+	psa_status_t status;
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		operation = psa_hash_operation_init();
+
+		bench_start(&bench);
+		status = psa_hash_setup(&operation, PSA_ALG_SHA_256);
+		if (status == PSA_SUCCESS) {
+			status = psa_hash_abort(&operation);
+		}
+		bench_stop(&bench);
+		zassert_equal(status, PSA_SUCCESS, "psa_hash_setup failed: %d", status);
+	}
+
+	bench_report("dispatch", "sha256_setup_abort", 0, &bench);
+}
+
+static void bench_aead(psa_key_type_t type, psa_algorithm_t alg, const char *name)
+{
+	uint8_t nonce[PSA_AEAD_NONCE_MAX_SIZE] = {0};
+	uint8_t ad[AEAD_AD_SIZE] = {0};
+	size_t nonce_len = PSA_AEAD_NONCE_LENGTH(type, alg);
+	psa_key_id_t key_id;
+	psa_status_t status;
+	size_t output_len;
+	size_t plain_len;
+
+	key_id = generate_key(type, alg, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT,
+			      PSA_BYTES_TO_BITS(AEAD_KEY_SIZE));
+
+	for (size_t i = 0; i < ARRAY_SIZE(message_sizes); i++) {
+		struct bench encrypt = {0};
+		struct bench decrypt = {0};
+
+		for (int n = 0; n < ITERATIONS; n++) {
+			bench_start(&encrypt);
+			status = psa_aead_encrypt(key_id, alg, nonce, nonce_len, ad, sizeof(ad),
+						  message, message_sizes[i], output,
+						  sizeof(output), &output_len);
+			bench_stop(&encrypt);
+			zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt failed: %d", status);
+
+			bench_start(&decrypt);
+			status = psa_aead_decrypt(key_id, alg, nonce, nonce_len, ad, sizeof(ad),
+						  output, output_len, message, sizeof(message),
+						  &plain_len);
+			bench_stop(&decrypt);
+			zassert_equal(status, PSA_SUCCESS, "psa_aead_decrypt failed: %d", status);
+		}
+
+		bench_report("aead_encrypt", name, message_sizes[i], &encrypt);
+		bench_report("aead_decrypt", name, message_sizes[i], &decrypt);
+	}
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_crypto_benchmark, test_aead)
+{
+	bench_aead(PSA_KEY_TYPE_AES, PSA_ALG_CCM, "aes256_ccm");
+	bench_aead(PSA_KEY_TYPE_AES, PSA_ALG_GCM, "aes256_gcm");
+	bench_aead(PSA_KEY_TYPE_CHACHA20, PSA_ALG_CHACHA20_POLY1305, "chacha20_poly1305");
+}
+
+#if defined(CONFIG_PSA_AEAD_BATCH)
+/* Compares encrypting a batch of short frames one by one with doing it in one call.
+ * Both are reported for the whole batch.
+ */
+static void bench_aead_batch(psa_key_type_t type, psa_algorithm_t alg, const char *name)
+{
+	static psa_aead_batch_item_t items[AEAD_BATCH_COUNT];
+	const size_t out_size = AEAD_BATCH_MESSAGE_SIZE + AEAD_TAG_SIZE;
+	uint8_t nonce[PSA_AEAD_NONCE_MAX_SIZE] = {0};
+	uint8_t ad[AEAD_AD_SIZE] = {0};
+	size_t nonce_len = PSA_AEAD_NONCE_LENGTH(type, alg);
+	struct bench single = {0};
+	struct bench batch = {0};
+	psa_key_id_t key_id;
+	psa_status_t status;
+	size_t output_len;
+
+	BUILD_ASSERT(AEAD_BATCH_COUNT * AEAD_BATCH_MESSAGE_SIZE <= sizeof(message));
+	BUILD_ASSERT(AEAD_BATCH_COUNT * (AEAD_BATCH_MESSAGE_SIZE + AEAD_TAG_SIZE) <=
+		     sizeof(output));
+
+	key_id = generate_key(type, alg, PSA_KEY_USAGE_ENCRYPT | PSA_KEY_USAGE_DECRYPT,
+			      PSA_BYTES_TO_BITS(AEAD_KEY_SIZE));
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		bench_start(&single);
+		for (size_t i = 0; i < AEAD_BATCH_COUNT; i++) {
+			status = psa_aead_encrypt(key_id, alg, nonce, nonce_len, ad, sizeof(ad),
+						  &message[i * AEAD_BATCH_MESSAGE_SIZE],
+						  AEAD_BATCH_MESSAGE_SIZE, &output[i * out_size],
+						  out_size, &output_len);
+			if (status != PSA_SUCCESS) {
+				break;
+			}
+		}
+		bench_stop(&single);
+		zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt failed: %d", status);
+
+		for (size_t i = 0; i < AEAD_BATCH_COUNT; i++) {
+			items[i] = (psa_aead_batch_item_t){
+				.nonce = nonce,
+				.nonce_length = nonce_len,
+				.additional_data = ad,
+				.additional_data_length = sizeof(ad),
+				.input = &message[i * AEAD_BATCH_MESSAGE_SIZE],
+				.input_length = AEAD_BATCH_MESSAGE_SIZE,
+				.output = &output[i * out_size],
+				.output_size = out_size,
+			};
+		}
+
+		bench_start(&batch);
+		status = psa_aead_encrypt_batch(key_id, alg, items, AEAD_BATCH_COUNT);
+		bench_stop(&batch);
+		zassert_equal(status, PSA_SUCCESS, "psa_aead_encrypt_batch failed: %d", status);
+	}
+
+	bench_report("aead_encrypt_x16", name, AEAD_BATCH_COUNT * AEAD_BATCH_MESSAGE_SIZE,
+		     &single);
+	bench_report("aead_encrypt_batch16", name, AEAD_BATCH_COUNT * AEAD_BATCH_MESSAGE_SIZE,
+		     &batch);
+
+	/* Decrypt the last batch in place of the input to check its results. */
+	for (size_t i = 0; i < AEAD_BATCH_COUNT; i++) {
+		items[i].input = &output[i * out_size];
+		items[i].input_length = items[i].output_length;
+		items[i].output = &message[i * AEAD_BATCH_MESSAGE_SIZE];
+		items[i].output_size = AEAD_BATCH_MESSAGE_SIZE;
+	}
+
+	status = psa_aead_decrypt_batch(key_id, alg, items, AEAD_BATCH_COUNT);
+	zassert_equal(status, PSA_SUCCESS, "psa_aead_decrypt_batch failed: %d", status);
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_crypto_benchmark, test_aead_batch)
+{
+	bench_aead_batch(PSA_KEY_TYPE_AES, PSA_ALG_CCM, "aes256_ccm");
+	bench_aead_batch(PSA_KEY_TYPE_AES, PSA_ALG_GCM, "aes256_gcm");
+}
+#endif /* CONFIG_PSA_AEAD_BATCH */
+
+static void bench_sign(psa_key_type_t type, size_t bits, psa_algorithm_t alg, const char *name,
+		       bool sign_hash)
+{
+	uint8_t signature[PSA_SIGNATURE_MAX_SIZE];
+	struct bench sign = {0};
+	struct bench verify = {0};
+	size_t signature_len;
+	psa_key_id_t key_id;
+	psa_status_t status;
+	/* ECDSA signs a digest, EdDSA signs the message itself. */
+	size_t input_len = sign_hash ? PSA_HASH_LENGTH(PSA_ALG_SHA_256) : 256;
+
+	key_id = generate_key(type, alg,
+			      PSA_KEY_USAGE_SIGN_HASH | PSA_KEY_USAGE_VERIFY_HASH |
+				      PSA_KEY_USAGE_SIGN_MESSAGE | PSA_KEY_USAGE_VERIFY_MESSAGE,
+			      bits);
+
+	for (int n = 0; n < ASYM_ITERATIONS; n++) {
+		bench_start(&sign);
+		if (sign_hash) {
+			status = psa_sign_hash(key_id, alg, message, input_len, signature,
+					       sizeof(signature), &signature_len);
+		} else {
+			status = psa_sign_message(key_id, alg, message, input_len, signature,
+						  sizeof(signature), &signature_len);
+		}
+		bench_stop(&sign);
+		zassert_equal(status, PSA_SUCCESS, "Signing failed: %d", status);
+
+		bench_start(&verify);
+		if (sign_hash) {
+			status = psa_verify_hash(key_id, alg, message, input_len, signature,
+						 signature_len);
+		} else {
+			status = psa_verify_message(key_id, alg, message, input_len, signature,
+						    signature_len);
+		}
+		bench_stop(&verify);
+		zassert_equal(status, PSA_SUCCESS, "Verification failed: %d", status);
+	}
+
+	bench_report("sign", name, input_len, &sign);
+	bench_report("verify", name, input_len, &verify);
+
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_crypto_benchmark, test_sign)
+{
+	bench_sign(PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1), 256,
+		   PSA_ALG_ECDSA(PSA_ALG_SHA_256), "ecdsa_secp256r1", true);
+#if defined(CONFIG_PSA_WANT_ALG_PURE_EDDSA)
+	bench_sign(PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_TWISTED_EDWARDS), 255,
+		   PSA_ALG_PURE_EDDSA, "ed25519", false);
+#endif
+}
+
+ZTEST(psa_crypto_benchmark, test_ecdh)
+{
+	uint8_t peer_key[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+	uint8_t shared_secret[PSA_RAW_KEY_AGREEMENT_OUTPUT_MAX_SIZE];
+	size_t peer_key_len;
+	size_t shared_secret_len;
+	struct bench bench = {0};
+	psa_key_id_t key_id;
+	psa_key_id_t peer_id;
+	psa_status_t status;
+
+	key_id = generate_key(PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1), PSA_ALG_ECDH,
+			      PSA_KEY_USAGE_DERIVE, 256);
+	peer_id = generate_key(PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1), PSA_ALG_ECDH,
+			       PSA_KEY_USAGE_DERIVE, 256);
+
+	status = psa_export_public_key(peer_id, peer_key, sizeof(peer_key), &peer_key_len);
+	zassert_equal(status, PSA_SUCCESS, "psa_export_public_key failed: %d", status);
+
+	for (int n = 0; n < ASYM_ITERATIONS; n++) {
+		bench_start(&bench);
+		status = psa_raw_key_agreement(PSA_ALG_ECDH, key_id, peer_key, peer_key_len,
+					       shared_secret, sizeof(shared_secret),
+					       &shared_secret_len);
+		bench_stop(&bench);
+		zassert_equal(status, PSA_SUCCESS, "psa_raw_key_agreement failed: %d", status);
+	}
+
+	bench_report("key_agreement", "ecdh_secp256r1", 0, &bench);
+
+	psa_destroy_key(peer_id);
+	psa_destroy_key(key_id);
+}
+
+ZTEST(psa_crypto_benchmark, test_kdf)
+{
+	static const uint8_t info[] = "benchmark";
+	const psa_algorithm_t alg = PSA_ALG_HKDF(PSA_ALG_SHA_256);
+	uint8_t okm[64];
+	struct bench bench = {0};
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	key_id = generate_key(PSA_KEY_TYPE_DERIVE, alg, PSA_KEY_USAGE_DERIVE, 256);
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		psa_key_derivation_operation_t operation = PSA_KEY_DERIVATION_OPERATION_INIT;
+
+		bench_start(&bench);
+		status = psa_key_derivation_setup(&operation, alg);
+		if (status == PSA_SUCCESS) {
+			status = psa_key_derivation_input_key(
+				&operation, PSA_KEY_DERIVATION_INPUT_SECRET, key_id);
+		}
+		if (status == PSA_SUCCESS) {
+			status = psa_key_derivation_input_bytes(
+				&operation, PSA_KEY_DERIVATION_INPUT_INFO, info, sizeof(info));
+		}
+		if (status == PSA_SUCCESS) {
+			status = psa_key_derivation_output_bytes(&operation, okm, sizeof(okm));
+		}
+		psa_key_derivation_abort(&operation);
+		bench_stop(&bench);
+		zassert_equal(status, PSA_SUCCESS, "HKDF failed: %d", status);
+	}
+
+	bench_report("kdf", "hkdf_sha256", sizeof(okm), &bench);
+
+	psa_destroy_key(key_id);
+}
+
+static void *psa_crypto_benchmark_setup(void)
+{
+	psa_status_t status = psa_crypto_init();
+
+	zassert_equal(status, PSA_SUCCESS, "psa_crypto_init failed: %d", status);
+
+	status = psa_generate_random(message, sizeof(message));
+	zassert_equal(status, PSA_SUCCESS, "psa_generate_random failed: %d", status);
+
+	timing_init();
+	timing_start();
+
+	TC_PRINT("BENCH,operation,algorithm,size,iterations,ns_per_op,kBps\n");
+
+	return NULL;
+}
+
+static void psa_crypto_benchmark_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(psa_crypto_benchmark, NULL, psa_crypto_benchmark_setup, NULL, NULL,
+	    psa_crypto_benchmark_teardown);
@@ -43,9 +43,14 @@ typedef enum {
 	EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE = -10
 } EI_IMPULSE_ERROR;
 
-/* Mock function used by ei_wrapper. */
+/* Mock functions used by ei_wrapper. */
 extern "C" EI_IMPULSE_ERROR run_classifier(signal_t *signal,
 					   ei_impulse_result_t *result,
 					   bool debug);
+extern "C" void run_classifier_init(void);
+extern "C" EI_IMPULSE_ERROR run_classifier_continuous(signal_t *signal,
+						      ei_impulse_result_t *result,
+						      bool debug,
+						      bool enable_maf);
 
 #endif /* _EI_RUN_CLASSIFIER_H_ */
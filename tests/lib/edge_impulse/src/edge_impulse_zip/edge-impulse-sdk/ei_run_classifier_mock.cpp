@@ -8,10 +8,17 @@
 #include <ei_run_classifier.h>
 
 static size_t prediction_idx;
+static size_t init_count;
 
 void ei_run_classifier_mock_init(void)
 {
 	prediction_idx = 0;
+	init_count = 0;
+}
+
+size_t ei_run_classifier_mock_init_count(void)
+{
+	return init_count;
 }
 
 /* Input data must be ascending sequence of floats. Difference between
@@ -26,6 +33,8 @@ static void verify_data_read(signal_t *signal, const size_t prediction_idx,
 	zassert_true(data_size % chunk_size == 0,
 		     "Improper data and chunk size combination");
 
+	zassert_true(data_size <= EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE, "Too much data");
+
 	static float data_buf[EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE];
 	float *data_ptr = data_buf;
 
@@ -46,18 +55,13 @@ static void verify_data_read(signal_t *signal, const size_t prediction_idx,
 	}
 }
 
-EI_IMPULSE_ERROR run_classifier(signal_t *signal,
-				ei_impulse_result_t *result,
-				bool debug)
+static EI_IMPULSE_ERROR mock_classify(signal_t *signal, ei_impulse_result_t *result)
 {
-	ARG_UNUSED(debug);
-
 	/* Test getting data. */
 	verify_data_read(signal, prediction_idx, 1);
 	verify_data_read(signal, prediction_idx,
 			 EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
-	verify_data_read(signal, prediction_idx,
-			 EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
+	verify_data_read(signal, prediction_idx, signal->total_length);
 
 	/* Busy wait for predefined amount of time to simulate calculations. */
 	k_busy_wait(EI_MOCK_BUSY_WAIT_TIME);
@@ -91,3 +95,39 @@ EI_IMPULSE_ERROR run_classifier(signal_t *signal,
 
 	return EI_IMPULSE_OK;
 }
+
+EI_IMPULSE_ERROR run_classifier(signal_t *signal,
+				ei_impulse_result_t *result,
+				bool debug)
+{
+	ARG_UNUSED(debug);
+
+	zassert_false(IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS), "Continuous mode is enabled");
+	zassert_equal(signal->total_length, EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE,
+		      "Wrong input data size");
+
+	return mock_classify(signal, result);
+}
+
+void run_classifier_init(void)
+{
+	zassert_true(IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS), "Continuous mode is disabled");
+
+	init_count++;
+}
+
+EI_IMPULSE_ERROR run_classifier_continuous(signal_t *signal,
+					   ei_impulse_result_t *result,
+					   bool debug,
+					   bool enable_maf)
+{
+	ARG_UNUSED(debug);
+	ARG_UNUSED(enable_maf);
+
+	zassert_true(IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS), "Continuous mode is disabled");
+	zassert_equal(signal->total_length,
+		      EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE / EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW,
+		      "Wrong input data size");
+
+	return mock_classify(signal, result);
+}
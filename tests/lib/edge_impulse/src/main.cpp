@@ -51,6 +51,41 @@ static int add_input_data(const size_t pred_idx, const size_t frame_surplus)
 	return err;
 }
 
+/* Add a single slice of input data, processed as the prediction of the given index. */
+static int add_slice_data(const size_t pred_idx)
+{
+	static float data_buf[EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME];
+
+	int err = 0;
+	float value = EI_MOCK_GEN_FIRST_INPUT(pred_idx);
+
+	for (size_t i = 0; i < ei_wrapper_get_slice_size();
+	     i += EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME) {
+		for (size_t j = 0; j < ARRAY_SIZE(data_buf); j++) {
+			data_buf[j] = value;
+			value++;
+		}
+
+		err = ei_wrapper_add_data(data_buf, EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
+		if (err) {
+			break;
+		}
+	}
+
+	return err;
+}
+
+static void run_slice(const size_t frame_shift)
+{
+	int err;
+
+	err = ei_wrapper_start_prediction(0, frame_shift);
+	zassert_ok(err, "Cannot start prediction");
+
+	err = k_sem_take(&test_sem, EI_TEST_SEM_TIMEOUT);
+	zassert_ok(err, "Cannot take semaphore");
+}
+
 static void verify_result(const size_t pred_idx)
 {
 	int err;
@@ -156,6 +191,11 @@ static void *test_init(void)
 		     "Wrong frame size");
 	zassert_equal(ei_wrapper_get_window_size(), EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE,
 		      "Wrong window size");
+	zassert_equal(ei_wrapper_get_slice_size(),
+		      IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS) ?
+		      (EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE / EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW) :
+		      EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE,
+		      "Wrong slice size");
 	zassert_true(ei_wrapper_get_window_size() % ei_wrapper_get_frame_size() == 0,
 		     "Wrong window and frame size combination");
 	zassert_true(ei_wrapper_classifier_has_anomaly(), "Mocked library supports anomaly");
@@ -283,7 +323,14 @@ ZTEST(suite0, test_cancel)
 {
 	int err;
 
-	err = ei_wrapper_start_prediction(0, 1);
+	if (IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS)) {
+		/* A single input window holds more than one slice of data. Shift the window by
+		 * one window and one frame so that the prediction waits for the data.
+		 */
+		err = ei_wrapper_start_prediction(1, 1);
+	} else {
+		err = ei_wrapper_start_prediction(0, 1);
+	}
 	zassert_ok(err, "Cannot start prediction");
 	err = add_input_data(prediction_idx, 0);
 	zassert_ok(err, "Cannot add input data");
@@ -378,6 +425,55 @@ ZTEST(suite0, test_data_after_start)
 	}
 }
 
+ZTEST(suite0, test_continuous_slices)
+{
+	static const size_t loop_cnt = 5;
+	size_t slice_frames;
+	bool cancelled;
+	int err;
+
+	if (!IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS)) {
+		ztest_test_skip();
+	}
+
+	slice_frames = ei_wrapper_get_slice_size() / ei_wrapper_get_frame_size();
+
+	/* The first slice after clearing the data starts a new window. */
+	err = add_slice_data(prediction_idx);
+	zassert_ok(err, "Cannot add input data");
+	run_slice(0);
+	zassert_equal(ei_run_classifier_mock_init_count(), 1, "Classifier not initialized");
+
+	/* Subsequent slices reuse the features of the previous ones. */
+	for (size_t i = 0; i < loop_cnt; i++) {
+		err = add_slice_data(prediction_idx);
+		zassert_ok(err, "Cannot add input data");
+		run_slice(slice_frames);
+	}
+	zassert_equal(ei_run_classifier_mock_init_count(), 1,
+		      "Classifier initialized for a subsequent slice");
+
+	/* Skipping a slice starts a new window. The skipped slice is never processed. */
+	err = add_slice_data(0);
+	zassert_ok(err, "Cannot add input data");
+	err = add_slice_data(prediction_idx);
+	zassert_ok(err, "Cannot add input data");
+	run_slice(2 * slice_frames);
+	zassert_equal(ei_run_classifier_mock_init_count(), 2,
+		      "Classifier not initialized after a different shift");
+
+	/* Clearing the data starts a new window. */
+	err = ei_wrapper_clear_data(&cancelled);
+	zassert_ok(err, "Cannot clear data");
+	zassert_false(cancelled, "Unexpected prediction cancel");
+
+	err = add_slice_data(prediction_idx);
+	zassert_ok(err, "Cannot add input data");
+	run_slice(0);
+	zassert_equal(ei_run_classifier_mock_init_count(), 3,
+		      "Classifier not initialized after clearing the data");
+}
+
 static void test_thread_fn(void)
 {
 	int err;
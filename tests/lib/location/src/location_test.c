@@ -1671,6 +1671,152 @@ void test_location_request_default(void)
 #endif
 }
 
+/* Test fallback from GNSS to Wi-Fi when the Wi-Fi scan is started in parallel with GNSS.
+ * The scan results received while GNSS is running are used after the fallback without
+ * requesting another scan.
+ */
+void test_location_gnss_wifi_fallback_parallel_scan(void)
+{
+#if defined(CONFIG_LOCATION_METHOD_WIFI_SCAN_DURING_GNSS)
+#if !defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_GNSS, LOCATION_METHOD_WIFI};
+
+	location_config_defaults_set(&config, 2, methods);
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_FALLBACK;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+#endif
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_WIFI;
+	test_location_event_data[location_cb_expected].location.latitude = 51.98765;
+	test_location_event_data[location_cb_expected].location.longitude = 13.12345;
+	test_location_event_data[location_cb_expected].location.accuracy = 50.0;
+	test_location_event_data[location_cb_expected].location.datetime.valid = false;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].location.details.wifi.ap_count = 2;
+#endif
+	location_cb_expected++;
+
+	test_pvt_data.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID;
+
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+
+#if defined(CONFIG_LOCATION_TEST_AGNSS)
+	/* Setting values which doesn't require new A-GNSS request */
+	struct nrf_modem_gnss_agnss_expiry agnss_expiry = {
+		.data_flags = 0,
+		.utc_expiry = 0xffff,
+		.klob_expiry = 0xffff,
+		.neq_expiry = 0xffff,
+		.integrity_expiry = 0xffff,
+		.position_expiry = 0xffff };
+
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ExpectAndReturn(NULL, 0);
+	__cmock_nrf_modem_gnss_agnss_expiry_get_IgnoreArg_agnss_expiry();
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ReturnMemThruPtr_agnss_expiry(
+		&agnss_expiry, sizeof(agnss_expiry));
+#endif
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+	__cmock_nrf_modem_gnss_start_ExpectAndReturn(0);
+
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+	/* Wi-Fi scan is requested together with GNSS. A second scan request fails the test. */
+	net_mgmt_NET_REQUEST_WIFI_SCAN_expected = true;
+	__cmock_net_mgmt_NET_REQUEST_WIFI_SCAN_ExpectAndReturn(0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+	TEST_ASSERT_TRUE(net_mgmt_NET_REQUEST_WIFI_SCAN_occurred);
+
+	/* Wi-Fi scan completes while GNSS is still running */
+	struct net_mgmt_event_callback cb;
+	const struct wifi_status status = {
+		.status = WIFI_STATUS_CONN_SUCCESS
+	};
+	const struct wifi_scan_result scan_result1 = {
+		.ssid = "TestAP1",
+		.ssid_length = 7,
+		.channel = 36,
+		.mac = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB},
+		.mac_length = 6
+	};
+	const struct wifi_scan_result scan_result2 = {
+		.ssid = "TestAP2",
+		.ssid_length = 7,
+		.channel = 36,
+		.mac = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66},
+		.mac_length = 6
+	};
+
+	cb.info = &scan_result1;
+	scan_wifi_net_mgmt_event_handler(&cb, NET_EVENT_WIFI_SCAN_RESULT, NULL);
+	k_sleep(K_MSEC(1));
+	cb.info = &scan_result2;
+	scan_wifi_net_mgmt_event_handler(&cb, NET_EVENT_WIFI_SCAN_RESULT, NULL);
+	k_sleep(K_MSEC(1));
+	cb.info = &status;
+	scan_wifi_net_mgmt_event_handler(&cb, NET_EVENT_WIFI_SCAN_DONE, NULL);
+	k_sleep(K_MSEC(1));
+
+#if !defined(CONFIG_LOCATION_TEST_AGNSS)
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp, sizeof(xmonitor_resp));
+#endif
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/***** Fallback to Wi-Fi, which uses the results of the parallel scan *****/
+
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT+CGACT?", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)cgact_resp_active, sizeof(cgact_resp_active));
+
+	cellular_rest_req_resp_handle(location_cb_expected - 1);
+
+	/* Select Wi-Fi service to be used */
+	rest_req_ctx.url = "here.api"; /* Needs a fix once rest_req_ctx is verified */
+	rest_req_ctx.sec_tag = CONFIG_LOCATION_SERVICE_HERE_TLS_SEC_TAG;
+	rest_req_ctx.port = HTTPS_PORT;
+	rest_req_ctx.host = CONFIG_LOCATION_SERVICE_HERE_HOSTNAME;
+
+	__cmock_nrf_modem_gnss_read_ExpectAndReturn(
+		NULL, sizeof(test_pvt_data), NRF_MODEM_GNSS_DATA_PVT, -EINVAL);
+	__cmock_nrf_modem_gnss_read_IgnoreArg_buf();
+	__cmock_nrf_modem_gnss_read_ReturnMemThruPtr_buf(&test_pvt_data, sizeof(test_pvt_data));
+	method_gnss_event_handler(NRF_MODEM_GNSS_EVT_PVT);
+	k_sleep(K_MSEC(1));
+#endif
+#endif
+}
+
 /* Test location request with:
  * - LOCATION_REQ_MODE_ALL for cellular and GNSS positioning
  * - undefined timeout
@@ -50,6 +50,7 @@ K_FIFO_DEFINE(get_fifo);
 K_FIFO_DEFINE(write_fifo);
 
 K_SEM_DEFINE(backend_deinit_sem, 0, 1);
+K_SEM_DEFINE(trace_level_set_sem, 0, 1);
 
 static int nrf_modem_trace_get_error;
 static int nrf_modem_trace_get_cmock_num_calls;
@@ -57,6 +58,7 @@ static int trace_backend_write_error;
 static int trace_backend_write_cmock_num_calls;
 
 static int callback_evt;
+static int trace_level_last;
 
 extern void nrf_modem_lib_trace_init(void);
 
@@ -88,6 +90,15 @@ static int nrf_modem_at_printf_trace_level_invalid(const char *fmt, va_list args
 	return -EFAULT;
 }
 
+/* Called from the trace level workqueue, so it does not assert. */
+static int nrf_modem_at_printf_trace_level_record(const char *fmt, va_list args)
+{
+	trace_level_last = va_arg(args, int);
+	k_sem_give(&trace_level_set_sem);
+
+	return 0;
+}
+
 void setUp(void)
 {
 	nrf_modem_trace_get_error = 0;
@@ -150,6 +161,8 @@ int nrf_modem_trace_get_stub(struct nrf_modem_trace_data **frags, size_t *n_frag
 		if (nrf_modem_trace_get_error) {
 			return nrf_modem_trace_get_error;
 		}
+		/* Let the trace level workqueue run, it has the same priority. */
+		k_yield();
 	};
 
 	/* Populate temporary static array to be used later on for returned data. */
@@ -191,6 +204,20 @@ int trace_backend_write_stub(const void *data, size_t len, int cmock_num_calls)
 	return (int)len;
 }
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL
+#define ADAPTIVE_LEVEL_PERIOD_MS CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL_PERIOD_MS
+#else
+#define ADAPTIVE_LEVEL_PERIOD_MS 0
+#endif
+
+/* A backend that is busy writing for longer than the whole adaptive level period. */
+int trace_backend_write_slow_stub(const void *data, size_t len, int cmock_num_calls)
+{
+	k_sleep(K_MSEC(2 * ADAPTIVE_LEVEL_PERIOD_MS));
+
+	return trace_backend_write_stub(data, len, cmock_num_calls);
+}
+
 /* Function implementing a mechanism to synchronize main testing thread with trace thread via
  * a semaphore. This is the last function in the execution flow that can be mocked.
  */
@@ -418,6 +445,69 @@ void test_nrf_modem_lib_trace_enospc(void)
 	TEST_ASSERT_EQUAL_size_t(header.len, header_write->len);
 }
 
+void test_nrf_modem_lib_trace_adaptive_level(void)
+{
+	struct nrf_modem_trace_data frag = { 0 };
+	struct nrf_modem_trace_data *frag_write;
+
+	if (!IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_ADAPTIVE_LEVEL)) {
+		TEST_IGNORE();
+	}
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_STATS
+	nrf_modem_lib_trace_stats_reset();
+#endif
+
+	nrf_modem_at_printf_fake.custom_fake = nrf_modem_at_printf_trace_level_record;
+	k_sem_reset(&trace_level_set_sem);
+
+	__cmock_trace_backend_init_ExpectAndReturn(nrf_modem_trace_processed, 0);
+	__cmock_nrf_modem_trace_get_Stub(nrf_modem_trace_get_stub);
+	__cmock_trace_backend_write_Stub(trace_backend_write_slow_stub);
+	__cmock_trace_backend_deinit_Stub(trace_backend_deinit_stub);
+
+	/* Sets the trace level from CONFIG_NRF_MODEM_LIB_TRACE_LEVEL. */
+	nrf_modem_lib_trace_init();
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&trace_level_set_sem, K_NO_WAIT));
+	TEST_ASSERT_EQUAL(NRF_MODEM_LIB_TRACE_LEVEL_FULL, trace_level_last);
+
+	/* The backend is busy for the whole period, the trace level is lowered one step. */
+	generate_trace_frag(&frag);
+	k_fifo_alloc_put(&get_fifo, &frag);
+
+	frag_write = k_fifo_get(&write_fifo, K_FOREVER);
+	TEST_ASSERT_EQUAL_PTR(frag.data, frag_write->data);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&trace_level_set_sem, K_MSEC(ADAPTIVE_LEVEL_PERIOD_MS)));
+	TEST_ASSERT_EQUAL(NRF_MODEM_LIB_TRACE_LEVEL_LTE_AND_IP, trace_level_last);
+
+	/* The backend keeps up again, the trace level set by the application is restored. */
+	__cmock_trace_backend_write_Stub(trace_backend_write_stub);
+	k_sleep(K_MSEC(2 * ADAPTIVE_LEVEL_PERIOD_MS));
+
+	generate_trace_frag(&frag);
+	k_fifo_alloc_put(&get_fifo, &frag);
+
+	frag_write = k_fifo_get(&write_fifo, K_FOREVER);
+	TEST_ASSERT_EQUAL_PTR(frag.data, frag_write->data);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&trace_level_set_sem, K_MSEC(ADAPTIVE_LEVEL_PERIOD_MS)));
+	TEST_ASSERT_EQUAL(NRF_MODEM_LIB_TRACE_LEVEL_FULL, trace_level_last);
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_STATS
+	struct nrf_modem_lib_trace_stats stats;
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_trace_stats_get(&stats));
+	TEST_ASSERT_EQUAL(1, stats.level_downgrades);
+	TEST_ASSERT_EQUAL(1, stats.level_restores);
+#endif
+
+	nrf_modem_trace_get_error = -ESHUTDOWN;
+
+	wait_trace_deinit();
+}
+
 void test_nrf_modem_lib_trace_data_size(void)
 {
 	int ret;
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+
+#include "trace_backend.h"
+
+#define BUF_SIZE CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_BUF_SIZE
+#define READ_CHUNK_SIZE 100
+#define TRACE_SIZE CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_PARTITION_SIZE
+
+/* Enough incompressible data to fill several flash sectors. */
+#define TRACE_DATA_SIZE (BUF_SIZE * 48 + BUF_SIZE / 2)
+
+/* Defined by the trace library, given by the flash backend when a sector has been erased. */
+K_SEM_DEFINE(trace_clear_sem, 0, 1);
+
+extern struct nrf_modem_lib_trace_backend trace_backend;
+
+static uint8_t trace_data[TRACE_DATA_SIZE];
+static uint8_t read_data[TRACE_DATA_SIZE];
+static size_t processed_bytes;
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+static int trace_processed_cb(size_t len)
+{
+	processed_bytes += len;
+
+	return 0;
+}
+
+/* Trace data where most of each 16-byte block repeats, so that it compresses. */
+static void trace_data_fill_repetitive(void)
+{
+	for (size_t i = 0; i < sizeof(trace_data); i++) {
+		trace_data[i] = (i % 16) < 12 ? 0xAA : (uint8_t)(i / 16);
+	}
+}
+
+/* Deterministic pseudo-random trace data that does not compress. */
+static void trace_data_fill_random(void)
+{
+	uint32_t state = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(trace_data); i++) {
+		state = state * 1103515245 + 12345;
+		trace_data[i] = (uint8_t)(state >> 16);
+	}
+}
+
+static void trace_write(const uint8_t *data, size_t len)
+{
+	int ret;
+
+	/* Write in pieces that do not align with the flash buffer. */
+	for (size_t offset = 0; offset < len; offset += ret) {
+		ret = trace_backend.write(&data[offset], MIN(len - offset, BUF_SIZE / 3));
+		TEST_ASSERT_GREATER_THAN(0, ret);
+	}
+}
+
+static size_t trace_read_all(void)
+{
+	size_t total = 0;
+	int ret;
+
+	while (true) {
+		TEST_ASSERT_LESS_OR_EQUAL(sizeof(read_data), total);
+
+		ret = trace_backend.read(&read_data[total],
+					 MIN(READ_CHUNK_SIZE, sizeof(read_data) - total));
+		if (ret == -ENODATA) {
+			break;
+		}
+
+		TEST_ASSERT_GREATER_THAN(0, ret);
+		total += ret;
+	}
+
+	return total;
+}
+
+void setUp(void)
+{
+	static bool initialized;
+
+	if (!initialized) {
+		TEST_ASSERT_EQUAL(0, trace_backend.init(trace_processed_cb));
+		initialized = true;
+	}
+
+	TEST_ASSERT_EQUAL(0, trace_backend.clear());
+	processed_bytes = 0;
+	memset(read_data, 0, sizeof(read_data));
+}
+
+void test_flash_read_compressed(void)
+{
+	size_t len;
+
+	trace_data_fill_repetitive();
+
+	trace_write(trace_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL(sizeof(trace_data), processed_bytes);
+	TEST_ASSERT_EQUAL(sizeof(trace_data), trace_backend.data_size());
+
+	/* The last partial flash buffer is still in RAM and is read from there. */
+	len = trace_read_all();
+	TEST_ASSERT_EQUAL(sizeof(trace_data), len);
+	TEST_ASSERT_EQUAL_MEMORY(trace_data, read_data, len);
+	TEST_ASSERT_EQUAL(0, trace_backend.data_size());
+}
+
+void test_flash_read_incompressible(void)
+{
+	size_t len;
+
+	trace_data_fill_random();
+
+	trace_write(trace_data, sizeof(trace_data));
+	TEST_ASSERT_EQUAL(sizeof(trace_data), trace_backend.data_size());
+
+	len = trace_read_all();
+	TEST_ASSERT_EQUAL(sizeof(trace_data), len);
+	TEST_ASSERT_EQUAL_MEMORY(trace_data, read_data, len);
+}
+
+void test_flash_read_after_deinit_flush(void)
+{
+	size_t len;
+
+	trace_data_fill_repetitive();
+
+	/* Less than a flash buffer, written to flash only on deinit. */
+	trace_write(trace_data, BUF_SIZE / 2);
+	TEST_ASSERT_EQUAL(0, trace_backend.deinit());
+	TEST_ASSERT_EQUAL(BUF_SIZE / 2, trace_backend.data_size());
+
+	len = trace_read_all();
+	TEST_ASSERT_EQUAL(BUF_SIZE / 2, len);
+	TEST_ASSERT_EQUAL_MEMORY(trace_data, read_data, len);
+}
+
+void test_flash_discard_before(void)
+{
+	const size_t old_len = sizeof(trace_data) / 2;
+	const size_t new_len = sizeof(trace_data) - old_len;
+	int64_t uptime;
+	size_t unread;
+	size_t len;
+
+	trace_data_fill_random();
+
+	trace_write(trace_data, old_len);
+	k_sleep(K_MSEC(10));
+	uptime = k_uptime_get();
+	trace_write(&trace_data[old_len], new_len);
+
+	TEST_ASSERT_EQUAL(0, trace_backend.discard_before(uptime));
+
+	/* Whole sectors are skipped, so some older data may be kept. */
+	unread = trace_backend.data_size();
+	TEST_ASSERT_LESS_THAN(sizeof(trace_data), unread);
+	TEST_ASSERT_GREATER_OR_EQUAL(new_len, unread);
+
+	len = trace_read_all();
+	TEST_ASSERT_EQUAL(unread, len);
+	TEST_ASSERT_EQUAL_MEMORY(&trace_data[sizeof(trace_data) - len], read_data, len);
+}
+
+void test_flash_discard_before_partial_read(void)
+{
+	int64_t uptime;
+	size_t unread;
+	size_t len;
+	int ret;
+
+	trace_data_fill_random();
+
+	trace_write(trace_data, sizeof(trace_data) / 2);
+
+	/* Start reading the old data, stopping in the middle of a flash entry. */
+	ret = trace_backend.read(read_data, READ_CHUNK_SIZE);
+	TEST_ASSERT_EQUAL(READ_CHUNK_SIZE, ret);
+	TEST_ASSERT_EQUAL_MEMORY(trace_data, read_data, READ_CHUNK_SIZE);
+
+	k_sleep(K_MSEC(10));
+	uptime = k_uptime_get();
+	trace_write(&trace_data[sizeof(trace_data) / 2], sizeof(trace_data) / 2);
+
+	TEST_ASSERT_EQUAL(0, trace_backend.discard_before(uptime));
+
+	unread = trace_backend.data_size();
+	TEST_ASSERT_LESS_THAN(sizeof(trace_data) - READ_CHUNK_SIZE, unread);
+	TEST_ASSERT_GREATER_OR_EQUAL(sizeof(trace_data) / 2, unread);
+
+	/* The read position is never moved backwards. */
+	TEST_ASSERT_EQUAL(0, trace_backend.discard_before(0));
+	TEST_ASSERT_EQUAL(unread, trace_backend.data_size());
+
+	len = trace_read_all();
+	TEST_ASSERT_EQUAL(unread, len);
+	TEST_ASSERT_EQUAL_MEMORY(&trace_data[sizeof(trace_data) - len], read_data, len);
+}
+
+/* Write until the flash is full, returns the number of bytes written. */
+static size_t trace_write_until_full(void)
+{
+	size_t total = 0;
+	size_t offset;
+	int ret;
+
+	while (true) {
+		offset = total % sizeof(trace_data);
+		ret = trace_backend.write(&trace_data[offset],
+					  MIN(sizeof(trace_data) - offset, BUF_SIZE / 3));
+		if (ret == -ENOSPC) {
+			break;
+		}
+
+		TEST_ASSERT_GREATER_THAN(0, ret);
+		total += ret;
+		TEST_ASSERT_LESS_THAN(4 * TRACE_SIZE, total);
+	}
+
+	return total;
+}
+
+void test_flash_discard_before_frees_space(void)
+{
+	int64_t uptime;
+	size_t written;
+	size_t unread;
+	size_t len = 0;
+	int ret;
+
+	trace_data_fill_random();
+
+	/* With the "stop and signal" policy, nothing is erased while the flash is full. */
+	trace_write_until_full();
+	k_sem_reset(&trace_clear_sem);
+
+	k_sleep(K_MSEC(10));
+	uptime = k_uptime_get();
+
+	/* Everything is older than the uptime, so all but the active sector are erased. */
+	TEST_ASSERT_EQUAL(0, trace_backend.discard_before(uptime));
+	TEST_ASSERT_EQUAL(0, k_sem_take(&trace_clear_sem, K_NO_WAIT));
+	unread = trace_backend.data_size();
+
+	written = trace_write_until_full();
+	TEST_ASSERT_GREATER_THAN(TRACE_SIZE / 2, written);
+	TEST_ASSERT_EQUAL(unread + written, trace_backend.data_size());
+
+	/* More than the read buffer, so the data is only counted. */
+	while (true) {
+		ret = trace_backend.read(read_data, READ_CHUNK_SIZE);
+		if (ret == -ENODATA) {
+			break;
+		}
+
+		TEST_ASSERT_GREATER_THAN(0, ret);
+		len += ret;
+	}
+
+	TEST_ASSERT_EQUAL(unread + written, len);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
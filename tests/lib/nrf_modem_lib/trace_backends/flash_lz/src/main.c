@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+
+#include "trace_lz.h"
+
+#define BLOCK_SIZE 1024
+
+static uint8_t input[BLOCK_SIZE];
+static uint8_t compressed[BLOCK_SIZE + 64];
+static uint8_t output[BLOCK_SIZE];
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+/* Deterministic pseudo-random data that does not compress. */
+static void input_fill_random(void)
+{
+	uint32_t state = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(input); i++) {
+		state = state * 1103515245 + 12345;
+		input[i] = (uint8_t)(state >> 16);
+	}
+}
+
+void setUp(void)
+{
+	memset(compressed, 0, sizeof(compressed));
+	memset(output, 0, sizeof(output));
+}
+
+static void roundtrip(size_t len)
+{
+	int clen;
+	int dlen;
+
+	clen = trace_lz_compress(input, len, compressed, sizeof(compressed));
+	TEST_ASSERT_GREATER_THAN(0, clen);
+
+	dlen = trace_lz_decompress(compressed, clen, output, sizeof(output));
+	TEST_ASSERT_EQUAL(len, dlen);
+	TEST_ASSERT_EQUAL_MEMORY(input, output, len);
+}
+
+void test_trace_lz_empty(void)
+{
+	int clen;
+
+	clen = trace_lz_compress(input, 0, compressed, sizeof(compressed));
+	TEST_ASSERT_EQUAL(1, clen);
+	TEST_ASSERT_EQUAL(0, trace_lz_decompress(compressed, clen, output, sizeof(output)));
+}
+
+void test_trace_lz_repetitive(void)
+{
+	int clen;
+
+	for (size_t i = 0; i < sizeof(input); i++) {
+		input[i] = (i % 16) < 12 ? 0xAA : (uint8_t)i;
+	}
+
+	roundtrip(sizeof(input));
+
+	clen = trace_lz_compress(input, sizeof(input), compressed, sizeof(compressed));
+	TEST_ASSERT_LESS_THAN(sizeof(input) / 2, clen);
+}
+
+void test_trace_lz_random(void)
+{
+	input_fill_random();
+
+	for (size_t len = 1; len <= sizeof(input); len = len * 2 + 1) {
+		roundtrip(len);
+	}
+}
+
+void test_trace_lz_compress_no_space(void)
+{
+	input_fill_random();
+
+	TEST_ASSERT_EQUAL(-ENOSPC,
+			  trace_lz_compress(input, sizeof(input), compressed, sizeof(input) - 1));
+}
+
+void test_trace_lz_decompress_overflow(void)
+{
+	int clen;
+
+	memset(input, 0x55, sizeof(input));
+
+	clen = trace_lz_compress(input, sizeof(input), compressed, sizeof(compressed));
+	TEST_ASSERT_GREATER_THAN(0, clen);
+
+	TEST_ASSERT_EQUAL(-EINVAL,
+			  trace_lz_decompress(compressed, clen, output, sizeof(input) - 1));
+}
+
+void test_trace_lz_decompress_invalid_offset(void)
+{
+	/* One literal followed by a match with an offset pointing before the output. */
+	const uint8_t bad[] = { 0x10, 'a', 0x02, 0x00, 0x00 };
+
+	TEST_ASSERT_EQUAL(-EINVAL, trace_lz_decompress(bad, sizeof(bad), output, sizeof(output)));
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
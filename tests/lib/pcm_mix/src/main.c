@@ -127,4 +127,18 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_mono_into_stereo_high_values)
+{
+	int ret;
+	int16_t sample_a[] = { INT16_MAX, INT16_MIN, INT16_MIN, INT16_MAX };
+	int16_t sample_b[] = { 10, -10 };
+	int16_t sample_r[] = { INT16_MAX, INT16_MIN + 10, INT16_MIN, INT16_MAX - 10 };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_LR);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
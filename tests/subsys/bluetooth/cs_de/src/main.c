@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+#include <bluetooth/cs_de.h>
+
+/* The step data is synthesized from a model of the radio channel, as the estimators must
+ * produce the same results on every run.
+ */
+
+#define SPEED_OF_LIGHT_M_S 299792458.0
+#define TONE_AMPLITUDE	   1000
+#define TONE_NOISE	   40
+#define PATHS_MAX	   2
+
+/* Channels used by Channel Sounding: 2 to 76, except for 23, 24 and 25. */
+#define CHANNEL_FIRST 2
+#define CHANNEL_LAST  76
+#define CHANNEL_COUNT 72
+
+#define RTT_STEP_COUNT	   8
+#define STEP_COUNT	   (CHANNEL_COUNT + RTT_STEP_COUNT)
+#define STEP_DATA_LEN                                                                              \
+	MAX(sizeof(struct bt_hci_le_cs_step_data_mode_1),                                          \
+	    sizeof(struct bt_hci_le_cs_step_data_mode_2) +                                         \
+		    sizeof(struct bt_hci_le_cs_step_data_tone_info))
+
+/* Reflector turnaround time, in units of 0.5 ns. */
+#define REFLECTOR_TURNAROUND 160
+
+#define BENCHMARK_ITERATIONS 10
+
+struct path {
+	double distance_m;
+	double amplitude;
+};
+
+static struct bt_le_cs_subevent_step local_steps[STEP_COUNT];
+static struct bt_le_cs_subevent_step peer_steps[STEP_COUNT];
+static uint8_t local_step_data[STEP_COUNT][STEP_DATA_LEN];
+static uint8_t peer_step_data[STEP_COUNT][STEP_DATA_LEN];
+static size_t step_count;
+
+static struct cs_de_report report;
+static uint32_t rand_state;
+
+/** Mocks ******************************************/
+
+struct bt_le_cs_iq_sample bt_le_cs_parse_pct(const uint8_t pct[3])
+{
+	uint32_t pct_u32 = sys_get_le24(pct);
+
+	/* Sign-extend the 12-bit I and Q components. */
+	return (struct bt_le_cs_iq_sample){
+		.i = (int16_t)((pct_u32 & 0x000FFF) << 4) >> 4,
+		.q = (int16_t)((pct_u32 & 0xFFF000) >> 8) >> 4,
+	};
+}
+
+int bt_le_cs_get_antenna_path(uint8_t n_ap, uint8_t antenna_path_permutation_index,
+			      uint8_t tone_index)
+{
+	if ((tone_index >= n_ap) || (antenna_path_permutation_index != 0)) {
+		return -EINVAL;
+	}
+
+	return tone_index;
+}
+
+/** End of mocks ***********************************/
+
+static int32_t noise(void)
+{
+	rand_state = rand_state * 1103515245 + 12345;
+
+	return (int32_t)((rand_state >> 16) % (2 * TONE_NOISE + 1)) - TONE_NOISE;
+}
+
+static void pct_set(uint8_t pct[3], double i, double q)
+{
+	uint32_t i_u12 = (uint32_t)(lround(i) + noise()) & 0x0FFF;
+	uint32_t q_u12 = (uint32_t)(lround(q) + noise()) & 0x0FFF;
+
+	sys_put_le24(i_u12 | (q_u12 << 12), pct);
+}
+
+static uint8_t *step_add(uint8_t mode, uint8_t channel, uint8_t **peer)
+{
+	struct bt_le_cs_subevent_step *local_step = &local_steps[step_count];
+	struct bt_le_cs_subevent_step *peer_step = &peer_steps[step_count];
+
+	zassert_true(step_count < STEP_COUNT, "Too many steps");
+
+	local_step->mode = mode;
+	local_step->channel = channel;
+	local_step->data_len = STEP_DATA_LEN;
+	local_step->data = local_step_data[step_count];
+	*peer_step = *local_step;
+	peer_step->data = peer_step_data[step_count];
+
+	*peer = peer_step_data[step_count];
+
+	return local_step_data[step_count++];
+}
+
+static void tone_steps_add(const struct path *paths, size_t path_count)
+{
+	for (uint8_t channel = CHANNEL_FIRST; channel <= CHANNEL_LAST; channel++) {
+		double freq_hz = (2402.0 + channel) * 1e6;
+		double h_i = 0;
+		double h_q = 0;
+		double lo_phase;
+		struct bt_hci_le_cs_step_data_mode_2 *local;
+		struct bt_hci_le_cs_step_data_mode_2 *peer;
+
+		if ((channel >= 23) && (channel <= 25)) {
+			continue;
+		}
+
+		/* The channel frequency response of the round trip. */
+		for (size_t p = 0; p < path_count; p++) {
+			double phase = -2 * M_PI * freq_hz * 2 * paths[p].distance_m /
+				       SPEED_OF_LIGHT_M_S;
+
+			h_i += paths[p].amplitude * cos(phase);
+			h_q += paths[p].amplitude * sin(phase);
+		}
+
+		/* The phase offset between both devices must cancel out. */
+		lo_phase = 2 * M_PI * channel / 7.0;
+
+		local = (void *)step_add(BT_CONN_LE_CS_MAIN_MODE_2, channel, (uint8_t **)&peer);
+		local->antenna_permutation_index = 0;
+		peer->antenna_permutation_index = 0;
+		local->tone_info[0].quality_indicator = BT_HCI_LE_CS_TONE_QUALITY_HIGH;
+		peer->tone_info[0].quality_indicator = BT_HCI_LE_CS_TONE_QUALITY_HIGH;
+		local->tone_info[0].extension_indicator = BT_HCI_LE_CS_NOT_TONE_EXT_SLOT;
+		peer->tone_info[0].extension_indicator = BT_HCI_LE_CS_NOT_TONE_EXT_SLOT;
+
+		pct_set(local->tone_info[0].phase_correction_term,
+			TONE_AMPLITUDE * (h_i * cos(lo_phase) + h_q * sin(lo_phase)),
+			TONE_AMPLITUDE * (h_q * cos(lo_phase) - h_i * sin(lo_phase)));
+		pct_set(peer->tone_info[0].phase_correction_term, TONE_AMPLITUDE * cos(lo_phase),
+			TONE_AMPLITUDE * sin(lo_phase));
+	}
+}
+
+static void rtt_steps_add(double distance_m)
+{
+	/* Time differences are in units of 0.5 ns. */
+	int16_t round_trip = (int16_t)lround(2 * distance_m / SPEED_OF_LIGHT_M_S * 2e9);
+
+	for (uint8_t i = 0; i < RTT_STEP_COUNT; i++) {
+		struct bt_hci_le_cs_step_data_mode_1 *local;
+		struct bt_hci_le_cs_step_data_mode_1 *peer;
+
+		local = (void *)step_add(BT_CONN_LE_CS_MAIN_MODE_1, CHANNEL_FIRST + i,
+					 (uint8_t **)&peer);
+		local->packet_quality_aa_check = BT_HCI_LE_CS_PACKET_QUALITY_AA_CHECK_SUCCESSFUL;
+		peer->packet_quality_aa_check = BT_HCI_LE_CS_PACKET_QUALITY_AA_CHECK_SUCCESSFUL;
+		local->packet_rssi = -50;
+		peer->packet_rssi = -50;
+
+		/* Alternate around the round-trip time to model the timing jitter. */
+		local->toa_tod_initiator = REFLECTOR_TURNAROUND + round_trip + ((i % 2) ? 2 : -2);
+		peer->tod_toa_reflector = REFLECTOR_TURNAROUND;
+	}
+}
+
+static void report_populate(void)
+{
+	cs_de_report_init(&report, 1, BT_CONN_LE_CS_ROLE_INITIATOR);
+
+	for (size_t i = 0; i < step_count; i++) {
+		cs_de_report_add_step(&report, &local_steps[i], &peer_steps[i]);
+	}
+}
+
+static void assert_near(int32_t estimate, double distance_m, int32_t tolerance_mm,
+			const char *method)
+{
+	int32_t expected = (int32_t)lround(distance_m * 1000);
+
+	TC_PRINT("%s: %d mm, expected %d mm\n", method, estimate, expected);
+
+	zassert_not_equal(estimate, CS_DE_DISTANCE_INVALID, "No %s estimate", method);
+	zassert_within(estimate, expected, tolerance_mm, "Inaccurate %s estimate", method);
+}
+
+ZTEST(cs_de, test_single_path)
+{
+	static const double distances_m[] = {0.5, 2.0, 7.5, 21.0};
+
+	for (size_t i = 0; i < ARRAY_SIZE(distances_m); i++) {
+		struct path path = {.distance_m = distances_m[i], .amplitude = 1.0};
+
+		step_count = 0;
+		tone_steps_add(&path, 1);
+		rtt_steps_add(path.distance_m);
+		report_populate();
+
+		zassert_equal(cs_de_calc(&report), CS_DE_QUALITY_OK, "Invalid quality");
+		zassert_equal(report.tone_count[0], CHANNEL_COUNT, "Unexpected tone count");
+
+		assert_near(report.estimates.phase_slope, path.distance_m, 100, "phase slope");
+		assert_near(report.estimates.ifft, path.distance_m, 300, "IFFT");
+		assert_near(report.estimates.rtt, path.distance_m, 100, "RTT");
+	}
+}
+
+ZTEST(cs_de, test_multipath)
+{
+	/* A strong reflection arriving shortly after the direct path. */
+	static const struct path paths[PATHS_MAX] = {
+		{.distance_m = 4.0, .amplitude = 1.0},
+		{.distance_m = 9.0, .amplitude = 0.8},
+	};
+
+	step_count = 0;
+	tone_steps_add(paths, ARRAY_SIZE(paths));
+	report_populate();
+
+	zassert_equal(cs_de_calc(&report), CS_DE_QUALITY_OK, "Invalid quality");
+
+	TC_PRINT("phase slope: %d mm\n", report.estimates.phase_slope);
+	assert_near(report.estimates.ifft, paths[0].distance_m, 400, "IFFT");
+	zassert_equal(report.estimates.rtt, CS_DE_DISTANCE_INVALID, "Unexpected RTT estimate");
+}
+
+ZTEST(cs_de, test_low_quality_tones)
+{
+	struct path path = {.distance_m = 3.0, .amplitude = 1.0};
+
+	step_count = 0;
+	tone_steps_add(&path, 1);
+
+	for (size_t i = 0; i < step_count; i++) {
+		struct bt_hci_le_cs_step_data_mode_2 *local = (void *)local_step_data[i];
+
+		local->tone_info[0].quality_indicator = BT_HCI_LE_CS_TONE_QUALITY_LOW;
+	}
+
+	report_populate();
+
+	zassert_equal(report.tone_count[0], 0, "Low quality tones were used");
+	zassert_equal(cs_de_calc(&report), CS_DE_QUALITY_DO_NOT_USE, "Invalid quality");
+	zassert_equal(report.estimates.phase_slope, CS_DE_DISTANCE_INVALID, "Unexpected estimate");
+	zassert_equal(report.estimates.ifft, CS_DE_DISTANCE_INVALID, "Unexpected estimate");
+}
+
+ZTEST(cs_de, test_filter)
+{
+	static const int32_t estimates[] = {
+		1000, 1010, CS_DE_DISTANCE_INVALID, 990, 25000, 1005, 995, 1000,
+	};
+	struct cs_de_filter filter;
+	int32_t filtered;
+
+	cs_de_filter_init(&filter);
+
+	zassert_equal(cs_de_filter_update(&filter, CS_DE_DISTANCE_INVALID),
+		      CS_DE_DISTANCE_INVALID, "Estimate without input");
+
+	for (size_t i = 0; i < ARRAY_SIZE(estimates); i++) {
+		filtered = cs_de_filter_update(&filter, estimates[i]);
+
+		/* The outlier must be rejected by the median. */
+		zassert_within(filtered, 1000, 20, "Outlier was not rejected: %d", filtered);
+	}
+}
+
+ZTEST(cs_de, test_benchmark)
+{
+	struct path paths[PATHS_MAX] = {
+		{.distance_m = 6.0, .amplitude = 1.0},
+		{.distance_m = 11.0, .amplitude = 0.5},
+	};
+	uint32_t populate_cycles = 0;
+	uint32_t calc_cycles = 0;
+	uint32_t start;
+
+	step_count = 0;
+	tone_steps_add(paths, ARRAY_SIZE(paths));
+	rtt_steps_add(paths[0].distance_m);
+
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		start = k_cycle_get_32();
+		report_populate();
+		populate_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		(void)cs_de_calc(&report);
+		calc_cycles += k_cycle_get_32() - start;
+	}
+
+	TC_PRINT("%zu steps, cycles per procedure: %u to populate, %u to calculate\n",
+		 step_count, populate_cycles / BENCHMARK_ITERATIONS,
+		 calc_cycles / BENCHMARK_ITERATIONS);
+}
+
+static void before(void *f)
+{
+	ARG_UNUSED(f);
+
+	rand_state = 1;
+}
+
+ZTEST_SUITE(cs_de, NULL, NULL, before, NULL, NULL);
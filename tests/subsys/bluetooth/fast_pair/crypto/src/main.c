@@ -8,6 +8,9 @@
 #include "fp_crypto.h"
 #include "fp_common.h"
 
+/* Maximum number of Account Keys that can be stored. */
+#define LOOKUP_KEY_MAX_CNT 10
+
 ZTEST(suite_crypto, test_sha256)
 {
 	static const uint8_t input_data[] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
@@ -77,6 +80,94 @@ ZTEST(suite_crypto, test_aes128_ecb)
 	zassert_mem_equal(result_buf, plaintext, sizeof(plaintext), "Invalid decryption result.");
 }
 
+ZTEST(suite_crypto, test_aes128_ecb_dec_key)
+{
+	static const uint8_t plaintext[] = {0xF3, 0x0F, 0x4E, 0x78, 0x6C, 0x59, 0xA7, 0xBB, 0xF3,
+					    0x87, 0x3B, 0x5A, 0x49, 0xBA, 0x97, 0xEA};
+
+	static const uint8_t key[] = {0xA0, 0xBA, 0xF0, 0xBB, 0x95, 0x1F, 0xF7, 0xB6, 0xCF, 0x5E,
+				      0x3F, 0x45, 0x61, 0xC3, 0x32, 0x1D};
+
+	static const uint8_t ciphertext[] = {0xAC, 0x9A, 0x16, 0xF0, 0x95, 0x3A, 0x3F, 0x22, 0x3D,
+					     0xD1, 0x0C, 0xF5, 0x36, 0xE0, 0x9E, 0x9C};
+
+	struct fp_crypto_aes128_ecb_dec_key dec_key;
+	uint8_t result_buf[FP_CRYPTO_AES128_BLOCK_LEN];
+
+	zassert_ok(fp_crypto_aes128_ecb_dec_key_prepare(&dec_key, key),
+		   "Error during key preparation.");
+
+	/* The prepared key must be reusable. */
+	for (size_t i = 0; i < 2; i++) {
+		memset(result_buf, 0, sizeof(result_buf));
+		zassert_ok(fp_crypto_aes128_ecb_dec_key_decrypt(result_buf, ciphertext, &dec_key),
+			   "Error during value decryption.");
+		zassert_mem_equal(result_buf, plaintext, sizeof(plaintext),
+				  "Invalid decryption result.");
+	}
+
+	zassert_ok(fp_crypto_aes128_ecb_dec_key_release(&dec_key), "Error during key release.");
+}
+
+/* Measures the time of a Key-based Pairing request lookup, in which the request is decrypted
+ * with every stored Account Key. The matching key is the last one, which is the worst case.
+ */
+ZTEST(suite_crypto, test_aes128_ecb_dec_key_lookup_latency)
+{
+	static const uint8_t plaintext[FP_CRYPTO_AES128_BLOCK_LEN] = {0x00, 0x11, 0x22, 0x33};
+	struct fp_crypto_aes128_ecb_dec_key dec_keys[LOOKUP_KEY_MAX_CNT];
+	uint8_t keys[LOOKUP_KEY_MAX_CNT][FP_CRYPTO_AES128_KEY_LEN];
+	uint8_t ciphertext[FP_CRYPTO_AES128_BLOCK_LEN];
+	uint8_t result_buf[FP_CRYPTO_AES128_BLOCK_LEN];
+
+	for (size_t i = 0; i < LOOKUP_KEY_MAX_CNT; i++) {
+		memset(keys[i], 0x04, sizeof(keys[i]));
+		keys[i][FP_CRYPTO_AES128_KEY_LEN - 1] = i;
+		zassert_ok(fp_crypto_aes128_ecb_dec_key_prepare(&dec_keys[i], keys[i]),
+			   "Error during key preparation.");
+	}
+
+	for (size_t key_cnt = 1; key_cnt <= LOOKUP_KEY_MAX_CNT; key_cnt++) {
+		uint32_t start;
+		uint32_t raw_cycles;
+		uint32_t prepared_cycles;
+		size_t match_cnt;
+
+		zassert_ok(fp_crypto_aes128_ecb_encrypt(ciphertext, plaintext, keys[key_cnt - 1]),
+			   "Error during value encryption.");
+
+		match_cnt = 0;
+		start = k_cycle_get_32();
+		for (size_t i = 0; i < key_cnt; i++) {
+			zassert_ok(fp_crypto_aes128_ecb_decrypt(result_buf, ciphertext, keys[i]),
+				   "Error during value decryption.");
+			match_cnt += !memcmp(result_buf, plaintext, sizeof(plaintext));
+		}
+		raw_cycles = k_cycle_get_32() - start;
+		zassert_equal(match_cnt, 1, "Invalid number of matching keys.");
+
+		match_cnt = 0;
+		start = k_cycle_get_32();
+		for (size_t i = 0; i < key_cnt; i++) {
+			zassert_ok(fp_crypto_aes128_ecb_dec_key_decrypt(result_buf, ciphertext,
+									&dec_keys[i]),
+				   "Error during value decryption.");
+			match_cnt += !memcmp(result_buf, plaintext, sizeof(plaintext));
+		}
+		prepared_cycles = k_cycle_get_32() - start;
+		zassert_equal(match_cnt, 1, "Invalid number of matching keys.");
+
+		TC_PRINT("Lookup with %zu Account Keys: %u us (raw keys), %u us (prepared keys)\n",
+			 key_cnt, k_cyc_to_us_floor32(raw_cycles),
+			 k_cyc_to_us_floor32(prepared_cycles));
+	}
+
+	for (size_t i = 0; i < LOOKUP_KEY_MAX_CNT; i++) {
+		zassert_ok(fp_crypto_aes128_ecb_dec_key_release(&dec_keys[i]),
+			   "Error during key release.");
+	}
+}
+
 ZTEST(suite_crypto, test_aes128_ctr)
 {
 	static const uint8_t plaintext[] = {0x53, 0x6F, 0x6D, 0x65, 0x6F, 0x6E, 0x65, 0x27, 0x73,
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/hci.h>
+#include <bluetooth/services/nus.h>
+
+#define TEST_ATT_MTU      23
+#define TEST_CHUNK_SIZE   (TEST_ATT_MTU - 3)
+#define TEST_BUF_SIZE     CONFIG_BT_NUS_STREAM_TX_BUF_SIZE
+#define TEST_IN_FLIGHT    CONFIG_BT_NUS_STREAM_TX_IN_FLIGHT_MAX
+#define NOTIFY_MAX        32
+#define PROBE_TIMEOUT     K_MSEC(100)
+
+/* The connection is only used as an identifier by the stream. */
+static uint8_t conn_storage;
+static struct bt_conn *const test_conn = (struct bt_conn *)&conn_storage;
+
+static struct {
+	bt_gatt_complete_func_t func[NOTIFY_MAX];
+	void *user_data[NOTIFY_MAX];
+	size_t count;
+	size_t completed;
+	int err;
+	bool locked;
+} notify;
+
+static uint8_t sent_data[4 * TEST_BUF_SIZE];
+static size_t sent_len;
+static size_t stream_sent_len;
+static uint8_t test_data[TEST_BUF_SIZE];
+
+static K_SEM_DEFINE(probe_req_sem, 0, 1);
+static K_SEM_DEFINE(probe_done_sem, 0, 1);
+
+/* Takes the stream lock on request, to check that it is not held while notifying. */
+static void probe_thread_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&probe_req_sem, K_FOREVER);
+		(void)bt_nus_stream_space_get(test_conn);
+		k_sem_give(&probe_done_sem);
+	}
+}
+
+K_THREAD_DEFINE(probe_thread, 1024, probe_thread_fn, NULL, NULL, NULL, 0, 0, 0);
+
+int __wrap_bt_gatt_notify_cb(struct bt_conn *conn, struct bt_gatt_notify_params *params)
+{
+	int err;
+
+	k_sem_give(&probe_req_sem);
+	if (k_sem_take(&probe_done_sem, PROBE_TIMEOUT) != 0) {
+		notify.locked = true;
+	}
+
+	if (notify.err) {
+		err = notify.err;
+		notify.err = 0;
+		return err;
+	}
+
+	if ((conn != test_conn) || (notify.count >= NOTIFY_MAX) ||
+	    (sent_len + params->len > sizeof(sent_data))) {
+		return -EINVAL;
+	}
+
+	memcpy(&sent_data[sent_len], params->data, params->len);
+	sent_len += params->len;
+
+	notify.func[notify.count] = params->func;
+	notify.user_data[notify.count] = params->user_data;
+	notify.count++;
+
+	return 0;
+}
+
+bool __wrap_bt_gatt_is_subscribed(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+				  uint16_t ccc_type)
+{
+	ARG_UNUSED(attr);
+	ARG_UNUSED(ccc_type);
+
+	return conn == test_conn;
+}
+
+uint16_t __wrap_bt_gatt_get_mtu(struct bt_conn *conn)
+{
+	ARG_UNUSED(conn);
+
+	return TEST_ATT_MTU;
+}
+
+uint8_t __wrap_bt_conn_index(const struct bt_conn *conn)
+{
+	ARG_UNUSED(conn);
+
+	return 0;
+}
+
+static void stream_sent(struct bt_conn *conn, size_t len)
+{
+	zassert_equal(conn, test_conn, "Unexpected connection");
+	stream_sent_len += len;
+}
+
+static struct bt_nus_cb nus_cb = {
+	.stream_sent = stream_sent,
+};
+
+static void notify_complete(void)
+{
+	size_t idx = notify.completed++;
+
+	zassert_true(idx < notify.count, "No notification to complete");
+	notify.func[idx](test_conn, notify.user_data[idx]);
+}
+
+/* Only the NUS stream registers connection callbacks in this test. */
+static void stream_disconnect(void)
+{
+	STRUCT_SECTION_FOREACH(bt_conn_cb, cb) {
+		if (cb->disconnected) {
+			cb->disconnected(test_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		}
+	}
+}
+
+static void *setup(void)
+{
+	zassert_ok(bt_nus_init(&nus_cb));
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)i;
+	}
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&probe_done_sem);
+	memset(&notify, 0, sizeof(notify));
+	memset(sent_data, 0, sizeof(sent_data));
+	sent_len = 0;
+	stream_sent_len = 0;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Complete the notifications in flight, so that the next test starts with none. */
+	while (notify.completed < notify.count) {
+		notify_complete();
+	}
+
+	zassert_false(notify.locked, "Stream lock held while notifying");
+}
+
+ZTEST(nus_stream, test_write_in_order)
+{
+	const size_t len = 50;
+	int written;
+
+	written = bt_nus_stream_write(test_conn, test_data, len);
+	zassert_equal(written, len, "Unexpected number of bytes accepted");
+
+	/* The number of notifications in flight is limited. */
+	zassert_equal(notify.count, TEST_IN_FLIGHT, "Unexpected number of notifications");
+	zassert_equal(sent_len, TEST_IN_FLIGHT * TEST_CHUNK_SIZE, "Unexpected chunk size");
+
+	while (notify.completed < notify.count) {
+		notify_complete();
+	}
+
+	zassert_equal(sent_len, len, "Not all data sent");
+	zassert_mem_equal(sent_data, test_data, len, "Data sent out of order");
+	zassert_equal(stream_sent_len, len, "Unexpected number of bytes reported as sent");
+	zassert_equal(bt_nus_stream_space_get(test_conn), TEST_BUF_SIZE, "Buffer not freed");
+	zassert_false(notify.locked, "Stream lock held while notifying");
+}
+
+ZTEST(nus_stream, test_write_buffer_full)
+{
+	uint8_t data[2 * TEST_BUF_SIZE];
+	int written;
+
+	memset(data, 0xab, sizeof(data));
+
+	/* The chunks are queued after the data is buffered, so only the buffer size fits. */
+	written = bt_nus_stream_write(test_conn, data, sizeof(data));
+	zassert_equal(written, TEST_BUF_SIZE, "Unexpected number of bytes accepted");
+
+	while (notify.completed < notify.count) {
+		notify_complete();
+	}
+
+	zassert_equal(sent_len, TEST_BUF_SIZE, "Not all data sent");
+	zassert_mem_equal(sent_data, data, TEST_BUF_SIZE, "Unexpected data sent");
+}
+
+ZTEST(nus_stream, test_retry_out_of_buffers)
+{
+	const size_t len = 10;
+
+	notify.err = -ENOMEM;
+	zassert_equal(bt_nus_stream_write(test_conn, test_data, len), len);
+	zassert_equal(notify.count, 0, "Notification queued without TX buffers");
+
+	/* The chunk is kept and sent again after the retry delay. */
+	k_sleep(K_MSEC(50));
+
+	zassert_equal(notify.count, 1, "Notification not retried");
+	zassert_equal(sent_len, len, "Unexpected retried length");
+	zassert_mem_equal(sent_data, test_data, len, "Unexpected retried data");
+}
+
+ZTEST(nus_stream, test_disconnect_cancels_retry)
+{
+	const size_t len = 10;
+
+	notify.err = -ENOMEM;
+	zassert_equal(bt_nus_stream_write(test_conn, test_data, len), len);
+	zassert_equal(notify.count, 0, "Notification queued without TX buffers");
+
+	stream_disconnect();
+
+	k_sleep(K_MSEC(50));
+
+	zassert_equal(notify.count, 0, "Data of a disconnected stream retried");
+	zassert_equal(bt_nus_stream_space_get(test_conn), TEST_BUF_SIZE, "Data not dropped");
+
+	/* The stream is set up again for the next connection with the same index. */
+	zassert_equal(bt_nus_stream_write(test_conn, test_data, len), len);
+	zassert_equal(notify.count, 1, "Notification not queued after reconnection");
+	zassert_mem_equal(sent_data, test_data, len, "Unexpected data sent");
+}
+
+ZTEST(nus_stream, test_send_error_drops_data)
+{
+	notify.err = -EIO;
+	zassert_equal(bt_nus_stream_write(test_conn, test_data, TEST_CHUNK_SIZE + 1),
+		      TEST_CHUNK_SIZE + 1);
+
+	zassert_equal(notify.count, 0, "Unexpected notification");
+	zassert_equal(bt_nus_stream_space_get(test_conn), TEST_BUF_SIZE, "Data not dropped");
+}
+
+ZTEST(nus_stream, test_invalid_args)
+{
+	zassert_equal(bt_nus_stream_write(NULL, test_data, 1), -EINVAL);
+	zassert_equal(bt_nus_stream_write(test_conn, NULL, 1), -EINVAL);
+	zassert_equal(bt_nus_stream_space_get(NULL), 0);
+}
+
+ZTEST_SUITE(nus_stream, NULL, setup, before, after, NULL);
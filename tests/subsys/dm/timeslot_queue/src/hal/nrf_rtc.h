@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_RTC_MOCK_H__
+#define NRF_RTC_MOCK_H__
+
+#define NRF_RTC_INPUT_FREQ  32768
+#define NRF_RTC_COUNTER_MAX 0xFFFFFF
+
+#endif /* NRF_RTC_MOCK_H__ */
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <dm.h>
+
+#include "timeslot_queue.h"
+#include "time.h"
+
+#define REF_TICK     1000
+#define WINDOW_US    2000
+#define TIMESLOT_US  3000
+#define BATCH_MAX    CONFIG_DM_TIMESLOT_BATCH_MAX_COUNT
+
+static struct timeslot_request batch[BATCH_MAX];
+static struct dm_request evicted;
+
+static void peer_addr_get(uint8_t id, bt_addr_le_t *addr)
+{
+	*addr = (bt_addr_le_t){ .type = BT_ADDR_LE_RANDOM, .a.val = { id, 0, 0, 0, 0, 0xc0 } };
+}
+
+static int request_add(uint8_t peer_id, uint32_t start_delay_us, uint32_t timeslot_len_us)
+{
+	struct dm_request req = {
+		.role = DM_ROLE_INITIATOR,
+		.ranging_mode = DM_RANGING_MODE_MCPD,
+		.start_delay_us = start_delay_us,
+	};
+
+	peer_addr_get(peer_id, &req.bt_addr);
+
+	return timeslot_queue_append(&req, REF_TICK, WINDOW_US, timeslot_len_us, &evicted);
+}
+
+static void peer_served(uint8_t peer_id)
+{
+	bt_addr_le_t addr;
+
+	peer_addr_get(peer_id, &addr);
+	timeslot_queue_peer_served(&addr);
+}
+
+static void batch_check(size_t count, const uint8_t *peer_ids)
+{
+	zassert_equal(timeslot_queue_batch_get(batch, ARRAY_SIZE(batch)), count,
+		      "Unexpected batch size");
+
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(batch[i].dm_req.bt_addr.a.val[0], peer_ids[i], "Unexpected peer");
+		zassert_equal(batch[i].batch_idx, i, "Unexpected position in batch");
+		zassert_equal(batch[i].batch_start_time, batch[0].start_time,
+			      "Unexpected batch start time");
+	}
+}
+
+ZTEST(dm_timeslot_queue, test_separate_timeslots)
+{
+	zassert_ok(request_add(1, 0, TIMESLOT_US));
+	zassert_ok(request_add(2, 20000, TIMESLOT_US));
+
+	batch_check(1, (uint8_t []){ 1 });
+	zassert_equal(batch[0].start_time, REF_TICK);
+	zassert_equal(batch[0].window_length_us, WINDOW_US);
+	zassert_equal(batch[0].timeslot_length_us, TIMESLOT_US);
+
+	batch_check(1, (uint8_t []){ 2 });
+	zassert_equal(batch[0].start_time, REF_TICK + US_TO_RTC_TICKS(20000));
+
+	zassert_equal(timeslot_queue_batch_get(batch, ARRAY_SIZE(batch)), 0);
+}
+
+ZTEST(dm_timeslot_queue, test_batch)
+{
+	zassert_ok(request_add(1, 0, TIMESLOT_US));
+	zassert_ok(request_add(2, TIMESLOT_US, TIMESLOT_US));
+	zassert_ok(request_add(3, 2 * TIMESLOT_US, TIMESLOT_US));
+
+	/* The batch is full and the timeslot is too close to the previous one. */
+	zassert_equal(request_add(4, 3 * TIMESLOT_US, TIMESLOT_US), -EBUSY);
+	zassert_ok(request_add(4, 20000, TIMESLOT_US));
+
+	batch_check(3, (uint8_t []){ 1, 2, 3 });
+	batch_check(1, (uint8_t []){ 4 });
+}
+
+ZTEST(dm_timeslot_queue, test_batch_max_length)
+{
+	zassert_ok(request_add(1, 0, 8000));
+	zassert_ok(request_add(2, 8000, 8000));
+	zassert_equal(request_add(3, 16000, 8000), -EBUSY);
+
+	batch_check(2, (uint8_t []){ 1, 2 });
+}
+
+ZTEST(dm_timeslot_queue, test_batch_size_limit)
+{
+	zassert_ok(request_add(1, 0, TIMESLOT_US));
+	zassert_ok(request_add(2, TIMESLOT_US, TIMESLOT_US));
+
+	zassert_equal(timeslot_queue_batch_get(batch, 1), 1);
+	batch_check(1, (uint8_t []){ 2 });
+}
+
+ZTEST(dm_timeslot_queue, test_stale_peer_priority)
+{
+	peer_served(21);
+	zassert_ok(request_add(21, 0, TIMESLOT_US));
+
+	/* A peer that has never been ranged takes over the overlapping timeslot,
+	 * and the request of the replaced timeslot is returned.
+	 */
+	zassert_equal(request_add(22, 1000, TIMESLOT_US), 1);
+	zassert_equal(evicted.bt_addr.a.val[0], 21, "Unexpected evicted peer");
+
+	/* A peer that has been ranged more recently cannot take it back. */
+	peer_served(22);
+	k_sleep(K_MSEC(10));
+	peer_served(21);
+	zassert_equal(request_add(21, 2000, TIMESLOT_US), -EBUSY);
+
+	batch_check(1, (uint8_t []){ 22 });
+}
+
+ZTEST(dm_timeslot_queue, test_stale_peer_keeps_batch)
+{
+	zassert_ok(request_add(31, 0, TIMESLOT_US));
+	peer_served(32);
+	zassert_ok(request_add(32, TIMESLOT_US, TIMESLOT_US));
+
+	/* The replaced timeslot was part of a batch, so the new one joins the batch. */
+	zassert_equal(request_add(33, TIMESLOT_US + 1000, TIMESLOT_US), 1);
+	zassert_equal(evicted.bt_addr.a.val[0], 32, "Unexpected evicted peer");
+
+	batch_check(2, (uint8_t []){ 31, 33 });
+}
+
+ZTEST(dm_timeslot_queue, test_limits)
+{
+	int err = 0;
+	uint8_t i;
+
+	zassert_ok(request_add(1, 0, TIMESLOT_US));
+	zassert_ok(request_add(1, 20000, TIMESLOT_US));
+	zassert_equal(request_add(1, 40000, TIMESLOT_US), -EAGAIN);
+
+	/* The queue runs out of memory at the latest when it holds its maximum length. */
+	for (i = 2; i <= CONFIG_DM_TIMESLOT_QUEUE_LENGTH; i++) {
+		err = request_add(i, i * 20000, TIMESLOT_US);
+		if (err) {
+			break;
+		}
+	}
+
+	zassert_equal(err, -ENOMEM);
+
+	/* The queue holds a timeslot of each peer added so far, and two of the first peer.
+	 * Below the maximum length, a peer that waited longer still takes over the last
+	 * timeslot and the replaced request is returned.
+	 */
+	peer_served(i - 1);
+	err = request_add(100, (i - 1) * 20000 + 1000, TIMESLOT_US);
+	if (i >= CONFIG_DM_TIMESLOT_QUEUE_LENGTH) {
+		zassert_equal(err, -ENOMEM);
+	} else {
+		zassert_equal(err, 1);
+		zassert_equal(evicted.bt_addr.a.val[0], i - 1, "Unexpected evicted peer");
+	}
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	while (timeslot_queue_batch_get(batch, ARRAY_SIZE(batch)) != 0) {
+	}
+}
+
+ZTEST_SUITE(dm_timeslot_queue, NULL, NULL, NULL, after, NULL);
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <net/nrf_cloud_batch.h>
+#include "fakes.h"
+
+/* Already encoded device message. The encode function is faked and leaves it untouched. */
+#define TEST_MSG "{\"appId\":\"TEMP\",\"data\":21}"
+/* Leading '[' or ',' separator followed by the message. */
+#define TEST_MSG_BATCH_LEN (sizeof(TEST_MSG))
+/* Number of messages that fit into the batch buffer, leaving space for the closing ']'. */
+#define TEST_MSGS_MAX ((CONFIG_NRF_CLOUD_BATCH_BUF_SIZE - 1) / TEST_MSG_BATCH_LEN)
+
+static char sent_buf[CONFIG_NRF_CLOUD_BATCH_BUF_SIZE + 1];
+static int send_ret;
+
+static int batch_send_cb__stores(const char *buf, size_t len)
+{
+	zassert_true(len < sizeof(sent_buf), "Batch too long");
+	zassert_equal(strlen(buf), len, "Batch length mismatch");
+
+	memcpy(sent_buf, buf, len + 1);
+
+	return send_ret;
+}
+
+static int msg_add(void)
+{
+	struct nrf_cloud_obj obj = {
+		.type = NRF_CLOUD_OBJ_TYPE_JSON,
+		.encoded_data = {
+			.ptr = TEST_MSG,
+			.len = strlen(TEST_MSG)
+		}
+	};
+
+	return nrf_cloud_batch_add(&obj);
+}
+
+static void expected_batch_get(char *buf, size_t size, int msgs)
+{
+	size_t len = 0;
+
+	for (int i = 0; i < msgs; i++) {
+		len += snprintk(&buf[len], size - len, "%c%s", (i == 0) ? '[' : ',', TEST_MSG);
+	}
+
+	snprintk(&buf[len], size - len, "]");
+}
+
+static void *setup(void)
+{
+	zassert_ok(nrf_cloud_batch_init(batch_send_cb), "Initialization failed");
+	zassert_equal(nrf_cloud_batch_init(batch_send_cb), -EALREADY,
+		      "Double initialization should not be allowed");
+
+	return NULL;
+}
+
+/* This function runs before each test */
+static void run_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(nrf_cloud_obj_cloud_encode);
+	RESET_FAKE(nrf_cloud_obj_cloud_encoded_free);
+	RESET_FAKE(nrf_cloud_obj_free);
+	RESET_FAKE(batch_send_cb);
+
+	batch_send_cb_fake.custom_fake = batch_send_cb__stores;
+	send_ret = 0;
+	memset(sent_buf, 0, sizeof(sent_buf));
+}
+
+/* This function runs after each completed test */
+static void run_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Leave an empty batch for the next test. */
+	send_ret = 0;
+	(void)nrf_cloud_batch_flush();
+}
+
+ZTEST_SUITE(nrf_cloud_batch_test, NULL, setup, run_before, run_after, NULL);
+
+ZTEST(nrf_cloud_batch_test, test_01_flush_sends_all_messages)
+{
+	char expected[sizeof(sent_buf)];
+	struct nrf_cloud_batch_stats before;
+	struct nrf_cloud_batch_stats after;
+
+	nrf_cloud_batch_stats_get(&before);
+
+	zassert_ok(msg_add(), "Cannot add message");
+	zassert_ok(msg_add(), "Cannot add message");
+	zassert_equal(nrf_cloud_batch_pending_get(), 2, "Wrong number of pending messages");
+	zassert_equal(batch_send_cb_fake.call_count, 0, "Batch sent too early");
+	zassert_equal(nrf_cloud_obj_free_fake.call_count, 2, "Messages not freed");
+
+	zassert_ok(nrf_cloud_batch_flush(), "Cannot flush batch");
+	zassert_equal(batch_send_cb_fake.call_count, 1, "Batch not sent once");
+	zassert_equal(nrf_cloud_batch_pending_get(), 0, "Batch not emptied");
+
+	expected_batch_get(expected, sizeof(expected), 2);
+	zassert_str_equal(sent_buf, expected, "Wrong batch content");
+
+	nrf_cloud_batch_stats_get(&after);
+	zassert_equal(after.msgs_sent - before.msgs_sent, 2, "Wrong number of sent messages");
+	zassert_equal(after.bytes_sent - before.bytes_sent, strlen(expected),
+		      "Wrong number of sent bytes");
+	zassert_equal(after.flushes - before.flushes, 1, "Wrong number of flushes");
+}
+
+ZTEST(nrf_cloud_batch_test, test_02_flush_empty_batch)
+{
+	zassert_ok(nrf_cloud_batch_flush(), "Flushing an empty batch failed");
+	zassert_equal(batch_send_cb_fake.call_count, 0, "Empty batch sent");
+}
+
+ZTEST(nrf_cloud_batch_test, test_03_not_connected_keeps_batch)
+{
+	char expected[sizeof(sent_buf)];
+	struct nrf_cloud_batch_stats before;
+	struct nrf_cloud_batch_stats after;
+
+	nrf_cloud_batch_stats_get(&before);
+
+	zassert_ok(msg_add(), "Cannot add message");
+	zassert_ok(msg_add(), "Cannot add message");
+
+	send_ret = -ENOTCONN;
+	zassert_equal(nrf_cloud_batch_flush(), -ENOTCONN, "Wrong error");
+	zassert_equal(nrf_cloud_batch_pending_get(), 2, "Batch not kept");
+
+	send_ret = -EACCES;
+	zassert_equal(nrf_cloud_batch_flush(), -EACCES, "Wrong error");
+	zassert_equal(nrf_cloud_batch_pending_get(), 2, "Batch not kept");
+
+	/* Messages added while disconnected are appended to the kept batch. */
+	zassert_ok(msg_add(), "Cannot add message");
+
+	send_ret = 0;
+	zassert_ok(nrf_cloud_batch_flush(), "Cannot flush batch");
+	zassert_equal(nrf_cloud_batch_pending_get(), 0, "Batch not emptied");
+
+	expected_batch_get(expected, sizeof(expected), 3);
+	zassert_str_equal(sent_buf, expected, "Wrong batch content");
+
+	nrf_cloud_batch_stats_get(&after);
+	zassert_equal(after.msgs_dropped, before.msgs_dropped, "Messages dropped");
+	zassert_equal(after.msgs_sent - before.msgs_sent, 3, "Wrong number of sent messages");
+	zassert_equal(after.flushes - before.flushes, 1, "Wrong number of flushes");
+}
+
+ZTEST(nrf_cloud_batch_test, test_04_permanent_error_drops_batch)
+{
+	struct nrf_cloud_batch_stats before;
+	struct nrf_cloud_batch_stats after;
+
+	nrf_cloud_batch_stats_get(&before);
+
+	zassert_ok(msg_add(), "Cannot add message");
+	zassert_ok(msg_add(), "Cannot add message");
+
+	send_ret = -EIO;
+	zassert_equal(nrf_cloud_batch_flush(), -EIO, "Wrong error");
+	zassert_equal(nrf_cloud_batch_pending_get(), 0, "Batch not dropped");
+
+	nrf_cloud_batch_stats_get(&after);
+	zassert_equal(after.msgs_dropped - before.msgs_dropped, 2,
+		      "Wrong number of dropped messages");
+	zassert_equal(after.msgs_sent, before.msgs_sent, "Messages reported as sent");
+}
+
+ZTEST(nrf_cloud_batch_test, test_05_full_buffer)
+{
+	char expected[sizeof(sent_buf)];
+
+	zassert_true(TEST_MSGS_MAX > 1, "Batch buffer too small for the test");
+
+	for (int i = 0; i < TEST_MSGS_MAX; i++) {
+		zassert_ok(msg_add(), "Cannot add message");
+	}
+	zassert_equal(batch_send_cb_fake.call_count, 0, "Batch sent too early");
+
+	/* The full batch cannot be sent, so there is no room for another message. */
+	send_ret = -ENOTCONN;
+	zassert_equal(msg_add(), -ENOMEM, "Message added to a full batch");
+	zassert_equal(nrf_cloud_batch_pending_get(), TEST_MSGS_MAX, "Batch not kept");
+
+	/* Once connected, the full batch is sent to make room for the new message. */
+	send_ret = 0;
+	zassert_ok(msg_add(), "Cannot add message");
+	zassert_equal(nrf_cloud_batch_pending_get(), 1, "Wrong number of pending messages");
+
+	expected_batch_get(expected, sizeof(expected), TEST_MSGS_MAX);
+	zassert_str_equal(sent_buf, expected, "Wrong batch content");
+}
+
+ZTEST(nrf_cloud_batch_test, test_06_unsupported_object)
+{
+	struct nrf_cloud_obj obj = {
+		.type = NRF_CLOUD_OBJ_TYPE_COAP_CBOR
+	};
+
+	zassert_equal(nrf_cloud_batch_add(NULL), -EINVAL, "NULL object accepted");
+	zassert_equal(nrf_cloud_batch_add(&obj), -ENOTSUP, "CBOR object accepted");
+	zassert_equal(nrf_cloud_batch_pending_get(), 0, "Object added");
+}
@@ -153,3 +153,56 @@ ZTEST(cache_tests, test_suit_dfu_cache_search_empty)
 
 	zassert_not_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache should have failed");
 }
+
+ZTEST(cache_tests, test_suit_dfu_cache_search_payload_ok)
+{
+	const uint8_t *payload = NULL;
+	size_t payload_size = 0;
+	const uint8_t ok_uri[] = "http://source2.com.no";
+	size_t uri_size = sizeof("http://source2.com.no");
+
+	int ret = suit_dfu_cache_search(ok_uri, uri_size, &payload, &payload_size);
+
+	zassert_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache failed");
+	zassert_equal_ptr(payload, &cache[64], "\nInvalid payload address");
+	zassert_equal(payload_size, 7, "\nInvalid payload size");
+
+	/* Repeated search must return the same payload. */
+	payload = NULL;
+	payload_size = 0;
+	ret = suit_dfu_cache_search(ok_uri, uri_size - 1, &payload, &payload_size);
+
+	zassert_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache failed");
+	zassert_equal_ptr(payload, &cache[64], "\nInvalid payload address");
+	zassert_equal(payload_size, 7, "\nInvalid payload size");
+}
+
+ZTEST(cache_tests, test_suit_dfu_cache_search_after_reinitialize)
+{
+	struct dfu_cache dfu_caches;
+	const uint8_t *payload = NULL;
+	size_t payload_size = 0;
+	const uint8_t ok_uri[] = "#file.bin";
+	const uint8_t nok_uri[] = "http://source1.com";
+
+	/* Populate the index with the content of both caches. */
+	int ret = suit_dfu_cache_search(nok_uri, sizeof(nok_uri), &payload, &payload_size);
+
+	zassert_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache failed");
+
+	suit_dfu_cache_deinitialize();
+
+	dfu_caches.pools[0].address = (uint8_t *)cache2;
+	dfu_caches.pools[0].size = (size_t)cache2_len;
+	dfu_caches.pools_count = 1;
+
+	suit_plat_err_t rc = suit_dfu_cache_initialize(&dfu_caches);
+
+	zassert_equal(rc, SUIT_PLAT_SUCCESS, "Failed to initialize cache: %i", rc);
+
+	ret = suit_dfu_cache_search(nok_uri, sizeof(nok_uri), &payload, &payload_size);
+	zassert_not_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache should have failed");
+
+	ret = suit_dfu_cache_search(ok_uri, sizeof(ok_uri), &payload, &payload_size);
+	zassert_equal(ret, SUIT_PLAT_SUCCESS, "\nGet from cache failed");
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <psa/crypto.h>
+#include <suit_digest_filter.h>
+#include <suit_ram_sink.h>
+#include <suit_memptr_streamer.h>
+
+static const uint8_t test_data[] = "The quick brown fox jumps over the lazy dog. "
+				   "Pack my box with five dozen liquor jugs.";
+
+static uint8_t output_buffer[128] = {0};
+
+static void *test_suite_setup(void)
+{
+	psa_status_t status = psa_crypto_init();
+
+	zassert_equal(status, PSA_SUCCESS, "Failed to init psa crypto");
+
+	return NULL;
+}
+
+static void test_before(void *f)
+{
+	(void)f;
+	memset(output_buffer, 0, sizeof(output_buffer));
+}
+
+ZTEST_SUITE(suit_digest_filter_tests, NULL, test_suite_setup, test_before, NULL, NULL);
+
+static void digest_filter_create(struct stream_sink *digest_sink)
+{
+	struct stream_sink ram_sink;
+
+	suit_plat_err_t err = suit_ram_sink_get(&ram_sink, output_buffer, sizeof(output_buffer));
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Unable to create RAM sink");
+
+	err = suit_digest_filter_get(digest_sink, PSA_ALG_SHA_256, &ram_sink);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to create digest filter");
+}
+
+ZTEST(suit_digest_filter_tests, test_filter_smoke)
+{
+	struct stream_sink digest_sink;
+	uint8_t expected[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	uint8_t digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	size_t expected_length = 0;
+	size_t digest_length = 0;
+	size_t data_length = 0;
+
+	psa_status_t status = psa_hash_compute(PSA_ALG_SHA_256, test_data, sizeof(test_data),
+					       expected, sizeof(expected), &expected_length);
+
+	zassert_equal(status, PSA_SUCCESS, "Failed to calculate expected digest");
+
+	digest_filter_create(&digest_sink);
+
+	suit_plat_err_t err =
+		suit_memptr_streamer_stream(test_data, sizeof(test_data), &digest_sink);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to stream data");
+
+	err = digest_sink.flush(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to flush digest filter");
+
+	err = suit_digest_filter_digest_get(digest_sink.ctx, digest, sizeof(digest),
+					    &digest_length, &data_length);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to get digest");
+	zassert_equal(digest_length, expected_length, "Invalid digest length");
+	zassert_mem_equal(digest, expected, expected_length, "Digest does not match");
+	zassert_equal(data_length, sizeof(test_data), "Invalid number of hashed bytes");
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+
+	zassert_mem_equal(output_buffer, test_data, sizeof(test_data),
+			  "Data not passed to the output sink");
+}
+
+ZTEST(suit_digest_filter_tests, test_filter_chunked_write)
+{
+	struct stream_sink digest_sink;
+	uint8_t expected[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	uint8_t digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	size_t expected_length = 0;
+	size_t digest_length = 0;
+	size_t data_length = 0;
+	size_t offset = 0;
+
+	psa_status_t status = psa_hash_compute(PSA_ALG_SHA_256, test_data, sizeof(test_data),
+					       expected, sizeof(expected), &expected_length);
+
+	zassert_equal(status, PSA_SUCCESS, "Failed to calculate expected digest");
+
+	digest_filter_create(&digest_sink);
+
+	/* Sequential seek to the current position keeps the digest. */
+	while (offset < sizeof(test_data)) {
+		size_t chunk = MIN(7, sizeof(test_data) - offset);
+		suit_plat_err_t err = digest_sink.seek(digest_sink.ctx, offset);
+
+		zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to seek");
+
+		err = digest_sink.write(digest_sink.ctx, &test_data[offset], chunk);
+		zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to write chunk");
+
+		offset += chunk;
+	}
+
+	suit_plat_err_t err = suit_digest_filter_digest_get(digest_sink.ctx, digest, sizeof(digest),
+							    &digest_length, &data_length);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to get digest");
+	zassert_mem_equal(digest, expected, expected_length, "Digest does not match");
+	zassert_equal(data_length, sizeof(test_data), "Invalid number of hashed bytes");
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+}
+
+ZTEST(suit_digest_filter_tests, test_filter_non_sequential_seek)
+{
+	struct stream_sink digest_sink;
+	uint8_t digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	size_t digest_length = 0;
+	size_t data_length = 0;
+
+	digest_filter_create(&digest_sink);
+
+	suit_plat_err_t err = digest_sink.write(digest_sink.ctx, test_data, sizeof(test_data));
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to write data");
+
+	err = digest_sink.seek(digest_sink.ctx, 0);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to seek");
+
+	err = digest_sink.write(digest_sink.ctx, test_data, 1);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to overwrite data");
+
+	err = suit_digest_filter_digest_get(digest_sink.ctx, digest, sizeof(digest),
+					    &digest_length, &data_length);
+	zassert_equal(err, SUIT_PLAT_ERR_INCORRECT_STATE,
+		      "Digest available after non-sequential write");
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+}
+
+ZTEST(suit_digest_filter_tests, test_filter_write_after_digest_get)
+{
+	struct stream_sink digest_sink;
+	uint8_t digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+	size_t digest_length = 0;
+	size_t data_length = 0;
+
+	digest_filter_create(&digest_sink);
+
+	suit_plat_err_t err = digest_sink.write(digest_sink.ctx, test_data, sizeof(test_data));
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to write data");
+
+	err = suit_digest_filter_digest_get(digest_sink.ctx, digest, sizeof(digest),
+					    &digest_length, &data_length);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to get digest");
+
+	/* The digest was already read, the output sink must not be modified any more. */
+	err = digest_sink.write(digest_sink.ctx, test_data, 1);
+	zassert_equal(err, SUIT_PLAT_ERR_INCORRECT_STATE, "Write accepted after digest get");
+
+	err = digest_sink.seek(digest_sink.ctx, 0);
+	zassert_equal(err, SUIT_PLAT_ERR_INCORRECT_STATE, "Seek accepted after digest get");
+
+	err = suit_digest_filter_digest_get(digest_sink.ctx, digest, sizeof(digest),
+					    &digest_length, &data_length);
+	zassert_equal(err, SUIT_PLAT_ERR_INCORRECT_STATE, "Digest read twice");
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+
+	zassert_mem_equal(output_buffer, test_data, sizeof(test_data),
+			  "Output sink modified after digest get");
+}
+
+ZTEST(suit_digest_filter_tests, test_filter_busy)
+{
+	struct stream_sink digest_sink;
+	struct stream_sink second_sink;
+
+	digest_filter_create(&digest_sink);
+
+	/* Only a single digest filter can be used at a time. */
+	suit_plat_err_t err = suit_digest_filter_get(&second_sink, PSA_ALG_SHA_256, &digest_sink);
+
+	zassert_equal(err, SUIT_PLAT_ERR_BUSY, "Second digest filter created");
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+
+	digest_filter_create(&digest_sink);
+
+	err = digest_sink.release(digest_sink.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Failed to release digest filter");
+}